@@ -0,0 +1,186 @@
+#include <unlib/quantity.hpp>
+
+#include <cstddef>
+#include <vector>
+
+#include <unlib/common.hpp>
+#include <unlib/dynamic_quantity.hpp>
+#include <unlib/bench/unlib_bench.hpp>
+
+/*
+ * Each benchmark pairs an operation on quantities with the same operation on
+ * raw values (the baseline). If quantities are zero-overhead, both variants
+ * take the same time.
+ */
+
+namespace {
+
+// small enough to stay in cache, so the arithmetic is measured, not memory
+constexpr std::size_t item_count = 4096;
+
+using  W  =      unlib::watt<double>;
+using kW  = unlib::kilo<unlib::watt<double>>;
+using  h  =      unlib::hour<double>;
+using kWh = unlib::kilo<unlib::watt_hour<double>>;
+using  Wh =      unlib::watt_hour<double>;
+
+}
+
+UNLIB_BENCHMARK(arithmetic_add_kW) {
+	const auto raw_a = bench::random_values<double>(item_count, 0., 1e3);
+	const auto raw_b = bench::random_values<double>(item_count, 1e3, 2e3);
+	const auto a = bench::random_quantities<kW>(raw_a);
+	const auto b = bench::random_quantities<kW>(raw_b);
+	std::vector<double> raw_r(item_count);
+	std::vector<kW>     r    (item_count);
+
+	runner.measure("double + double (baseline)", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			raw_r[idx] = raw_a[idx] + raw_b[idx];
+		bench::do_not_optimize(raw_r[0]);
+	});
+	runner.measure("kW + kW", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			r[idx] = a[idx] + b[idx];
+		bench::do_not_optimize(r[0]);
+	});
+}
+
+UNLIB_BENCHMARK(arithmetic_multiply_kW_h) {
+	const auto raw_p = bench::random_values<double>(item_count, 0., 1e3);
+	const auto raw_t = bench::random_values<double>(item_count, 0., 24.);
+	const auto p = bench::random_quantities<kW>(raw_p);
+	const auto t = bench::random_quantities<h >(raw_t);
+	std::vector<double> raw_e(item_count);
+	std::vector<kWh>    e    (item_count);
+
+	runner.measure("double * double (baseline)", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			raw_e[idx] = raw_p[idx] * raw_t[idx];
+		bench::do_not_optimize(raw_e[0]);
+	});
+	runner.measure("kW * h", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			e[idx] = p[idx] * t[idx];
+		bench::do_not_optimize(e[0]);
+	});
+}
+
+UNLIB_BENCHMARK(arithmetic_divide_kWh_h) {
+	const auto raw_e = bench::random_values<double>(item_count, 0., 1e3);
+	const auto raw_t = bench::random_values<double>(item_count, 1., 24.);
+	const auto e = bench::random_quantities<kWh>(raw_e);
+	const auto t = bench::random_quantities<h  >(raw_t);
+	std::vector<double> raw_p(item_count);
+	std::vector<kW>     p    (item_count);
+
+	runner.measure("double / double (baseline)", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			raw_p[idx] = raw_e[idx] / raw_t[idx];
+		bench::do_not_optimize(raw_p[0]);
+	});
+	runner.measure("kWh / h", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			p[idx] = e[idx] / t[idx];
+		bench::do_not_optimize(p[0]);
+	});
+}
+
+UNLIB_BENCHMARK(compare_W_kW) {
+	const auto raw_a = bench::random_values<double>(item_count, 0., 1e6);
+	const auto raw_b = bench::random_values<double>(item_count, 0., 1e3);
+	const auto a = bench::random_quantities<W >(raw_a);
+	const auto b = bench::random_quantities<kW>(raw_b);
+
+	runner.measure("double < double*1000 (baseline)", item_count, [&]{
+		std::size_t count = 0;
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			count += raw_a[idx] < raw_b[idx]*1000.;
+		bench::do_not_optimize(count);
+	});
+	runner.measure("W < kW", item_count, [&]{
+		std::size_t count = 0;
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			count += a[idx] < b[idx];
+		bench::do_not_optimize(count);
+	});
+}
+
+UNLIB_BENCHMARK(cast_value_double_to_float) {
+	const auto raw = bench::random_values<double>(item_count, 0., 1e3);
+	const auto q = bench::random_quantities<kW>(raw);
+	std::vector<float>                               raw_r(item_count);
+	std::vector<unlib::kilo<unlib::watt<float>>>     r    (item_count);
+
+	runner.measure("static_cast<float> (baseline)", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			raw_r[idx] = static_cast<float>(raw[idx]);
+		bench::do_not_optimize(raw_r[0]);
+	});
+	runner.measure("value_cast<float>", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			r[idx] = unlib::value_cast<float>(q[idx]);
+		bench::do_not_optimize(r[0]);
+	});
+}
+
+UNLIB_BENCHMARK(cast_scale_Wh_to_kWh) {
+	const auto raw = bench::random_values<double>(item_count, 0., 1e6);
+	const auto q = bench::random_quantities<Wh>(raw);
+	std::vector<double> raw_r(item_count);
+	std::vector<kWh>    r    (item_count);
+
+	runner.measure("double / 1000 (baseline)", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			raw_r[idx] = raw[idx] / 1000.;
+		bench::do_not_optimize(raw_r[0]);
+	});
+	runner.measure("scale_cast<kWh::scale_type>", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			r[idx] = unlib::scale_cast<kWh::scale_type>(q[idx]);
+		bench::do_not_optimize(r[0]);
+	});
+	runner.measure("implicit conversion", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			r[idx] = q[idx];
+		bench::do_not_optimize(r[0]);
+	});
+}
+
+UNLIB_BENCHMARK(cast_quantity_Wh_to_kWh) {
+	const auto raw = bench::random_values<double>(item_count, 0., 1e6);
+	const auto q = bench::random_quantities<Wh>(raw);
+	std::vector<double> raw_r(item_count);
+	std::vector<kWh>    r    (item_count);
+
+	runner.measure("double / 1000 (baseline)", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			raw_r[idx] = raw[idx] / 1000.;
+		bench::do_not_optimize(raw_r[0]);
+	});
+	runner.measure("quantity_cast<kWh>", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			r[idx] = unlib::quantity_cast<kWh>(q[idx]);
+		bench::do_not_optimize(r[0]);
+	});
+}
+
+UNLIB_BENCHMARK(cast_dynamic_to_kWh) {
+	const auto raw = bench::random_values<double>(item_count, 0., 1e6);
+	std::vector<unlib::dynamic_quantity<>> q;
+	for(auto v : raw)
+		q.push_back(kWh{v});
+	std::vector<double> raw_r(item_count);
+	std::vector<kWh>    r    (item_count);
+
+	runner.measure("copy double (baseline)", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			raw_r[idx] = raw[idx];
+		bench::do_not_optimize(raw_r[0]);
+	});
+	runner.measure("quantity_cast<kWh>", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			r[idx] = unlib::quantity_cast<kWh>(q[idx]);
+		bench::do_not_optimize(r[0]);
+	});
+}
@@ -0,0 +1,62 @@
+#include <unlib/dynamic_quantity.hpp>
+
+#include <vector>
+
+#include <unlib/common.hpp>
+#include <unlib/bench/unlib_bench.hpp>
+
+namespace {
+
+constexpr std::size_t item_count = 4096;
+
+using kWh = unlib::kilo<unlib::watt_hour<double>>;
+using  Wh =             unlib::watt_hour<double>;
+
+}
+
+UNLIB_BENCHMARK(dynamic_sum_kWh) {
+	const auto raw = bench::random_values<double>(item_count, 0., 1e6);
+
+	std::vector<kWh> stat;
+	std::vector<unlib::dynamic_quantity<>> same, mixed;
+	for(std::size_t idx=0; idx<item_count; ++idx) {
+		stat .push_back(kWh{raw[idx]});
+		same .push_back(kWh{raw[idx]});
+		mixed.push_back(idx%2 ? unlib::dynamic_quantity<>{kWh{raw[idx]}} : unlib::dynamic_quantity<>{Wh{raw[idx]}});
+	}
+
+	runner.measure("static quantity (baseline)", item_count, [&]{
+		kWh sum{};
+		for(const auto& q : stat)
+			sum += q;
+		bench::do_not_optimize(sum);
+	});
+
+	runner.measure("dynamic, same unit", item_count, [&]{
+		unlib::dynamic_quantity<> sum = kWh{};
+		for(const auto& q : same)
+			sum += q;
+		bench::do_not_optimize(sum);
+	});
+
+	runner.measure("dynamic, mixed scales", item_count, [&]{
+		unlib::dynamic_quantity<> sum = kWh{};
+		for(const auto& q : mixed)
+			sum += q;
+		bench::do_not_optimize(sum);
+	});
+}
+
+UNLIB_BENCHMARK(dynamic_multiply_units) {
+	const std::vector<unlib::dynamic_unit> units{ unlib::make_dynamic_unit<kWh>()
+	                                            , unlib::make_dynamic_unit<unlib::hour<double>>()
+	                                            , unlib::make_dynamic_unit<unlib::kilo<unlib::watt<double>>>()
+	                                            , unlib::make_dynamic_unit<unlib::meter<double>>() };
+
+	runner.measure("dynamic_unit multiply/divide", item_count, [&]{
+		unlib::dynamic_unit u{};
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			u = u * units[idx%4] / units[(idx+1)%4];
+		bench::do_not_optimize(u);
+	});
+}
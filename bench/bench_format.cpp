@@ -0,0 +1,59 @@
+#include <unlib/quantity.hpp>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unlib/common.hpp>
+#include <unlib/bench/unlib_bench.hpp>
+
+namespace {
+
+constexpr std::size_t item_count = 1u << 14;
+
+template<typename Q, typename V>
+void bench_formatting(bench::runner& runner, const std::vector<V>& values) {
+	std::vector<Q> quantities;
+	for(auto v : values)
+		quantities.push_back(Q{v});
+
+	runner.measure("to_chars", item_count, [&]{
+		char buffer[64];
+		std::size_t total = 0;
+		for(const auto& q : quantities)
+			total += static_cast<std::size_t>(unlib::to_chars(buffer, buffer+sizeof(buffer), q).ptr - buffer);
+		bench::do_not_optimize(total);
+	});
+
+	runner.measure("operator<< of raw value and unit (baseline)", item_count, [&]{
+		std::ostringstream oss;
+		for(auto v : values)
+			oss << v << ' ' << unlib::literals::get_quantity_c_str<Q>() << '\n';
+		bench::do_not_optimize(oss.tellp());
+	});
+
+	runner.measure("operator<<", item_count, [&]{
+		std::ostringstream oss;
+		for(const auto& q : quantities)
+			oss << q << '\n';
+		bench::do_not_optimize(oss.tellp());
+	});
+
+	runner.measure("to_string", item_count, [&]{
+		std::size_t total = 0;
+		for(const auto& q : quantities)
+			total += unlib::to_string(q).size();
+		bench::do_not_optimize(total);
+	});
+}
+
+}
+
+UNLIB_BENCHMARK(format_double_kWh) {
+	bench_formatting<unlib::kilo<unlib::watt_hour<double>>>(runner, bench::random_values<double>(item_count, 0., 1e6));
+}
+
+UNLIB_BENCHMARK(format_int64_Wh) {
+	bench_formatting<unlib::watt_hour<std::int64_t>>(runner, bench::random_values<std::int64_t>(item_count, -1000000000, 1000000000));
+}
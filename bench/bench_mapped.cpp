@@ -0,0 +1,57 @@
+#include <unlib/mapped_quantity_span.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <unlib/common.hpp>
+#include <unlib/quantity_columns.hpp>
+#include <unlib/bench/unlib_bench.hpp>
+
+namespace {
+
+constexpr std::size_t item_count = 1u << 23; // 64MB of doubles
+
+using kWh = unlib::kilo<unlib::watt_hour<double>>;
+
+}
+
+UNLIB_BENCHMARK(load_kWh_column) {
+	const std::string path = "/tmp/unlib_bench_columns.col";
+	{
+		const auto energy = bench::random_quantities<kWh>(bench::random_values<double>(item_count, 0., 1e6));
+		std::ofstream ofs(path, std::ios_base::binary);
+		unlib::write_quantity_columns(ofs, unlib::make_quantity_span(energy));
+	}
+
+	// each variant opens the file, loads the column, and sums it up
+
+	runner.measure("ifstream + quantity_column_reader", item_count, [&]{
+		std::ifstream ifs(path, std::ios_base::binary);
+		unlib::quantity_column_reader reader(ifs);
+		const auto energy = reader.read_column<kWh>(0);
+		kWh sum{};
+		for(const auto& e : energy)
+			sum += e;
+		bench::do_not_optimize(sum);
+	});
+
+	runner.measure("mapped_quantity_span (sequential)", item_count, [&]{
+		const unlib::mapped_quantity_span<kWh> energy(path, 0, unlib::mapping_advice::sequential);
+		kWh sum{};
+		for(const auto& e : energy)
+			sum += e;
+		bench::do_not_optimize(sum);
+	});
+
+	runner.measure("mapped_quantity_span (willneed)", item_count, [&]{
+		const unlib::mapped_quantity_span<kWh> energy(path, 0, unlib::mapping_advice::willneed);
+		kWh sum{};
+		for(const auto& e : energy)
+			sum += e;
+		bench::do_not_optimize(sum);
+	});
+
+	std::remove(path.c_str());
+}
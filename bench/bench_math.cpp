@@ -0,0 +1,269 @@
+#include <unlib/math.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <unlib/common.hpp>
+#include <unlib/bench/unlib_bench.hpp>
+
+namespace {
+
+constexpr std::size_t item_count = 4096;
+
+using  m  = unlib::meter<double>;
+using  m2 = unlib::square_meter<double>;
+using  m3 = unlib::cubic_meter<double>;
+using  s  = unlib::second<double>;
+using  Hz = unlib::hertz<double>;
+using  m_long  = unlib::meter<long>;
+using  m2_long = unlib::square_meter<long>;
+using  W  = unlib::watt<double>;
+using kW  = unlib::kilo<unlib::watt<double>>;
+
+}
+
+UNLIB_BENCHMARK(math_sqrt_m2) {
+	const auto raw = bench::random_values<double>(item_count, 0., 1e6);
+	const auto q = bench::random_quantities<m2>(raw);
+	std::vector<double> raw_r(item_count);
+	std::vector<m>      r    (item_count);
+
+	runner.measure("std::sqrt (baseline)", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			raw_r[idx] = std::sqrt(raw[idx]);
+		bench::do_not_optimize(raw_r[0]);
+	});
+	runner.measure("unlib::sqrt", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			r[idx] = unlib::sqrt(q[idx]);
+		bench::do_not_optimize(r[0]);
+	});
+}
+
+UNLIB_BENCHMARK(math_pow2_m) {
+	const auto raw = bench::random_values<double>(item_count, 0., 1e3);
+	const auto q = bench::random_quantities<m>(raw);
+	std::vector<double> raw_r(item_count);
+	std::vector<m2>     r    (item_count);
+
+	runner.measure("std::pow(v,2) (baseline)", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			raw_r[idx] = std::pow(raw[idx], 2);
+		bench::do_not_optimize(raw_r[0]);
+	});
+	runner.measure("v*v", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			raw_r[idx] = raw[idx] * raw[idx];
+		bench::do_not_optimize(raw_r[0]);
+	});
+	runner.measure("unlib::pow<2>", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			r[idx] = unlib::pow<2>(q[idx]);
+		bench::do_not_optimize(r[0]);
+	});
+}
+
+UNLIB_BENCHMARK(math_pow3_m) {
+	const auto raw = bench::random_values<double>(item_count, 0., 1e3);
+	const auto q = bench::random_quantities<m>(raw);
+	std::vector<double> raw_r(item_count);
+	std::vector<m3>     r    (item_count);
+
+	runner.measure("std::pow(v,3.) (baseline)", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			raw_r[idx] = std::pow(raw[idx], 3.);
+		bench::do_not_optimize(raw_r[0]);
+	});
+	runner.measure("v*v*v", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			raw_r[idx] = raw[idx] * raw[idx] * raw[idx];
+		bench::do_not_optimize(raw_r[0]);
+	});
+	runner.measure("unlib::pow<3>", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			r[idx] = unlib::pow<3>(q[idx]);
+		bench::do_not_optimize(r[0]);
+	});
+}
+
+UNLIB_BENCHMARK(math_pow_1_s) {
+	const auto raw = bench::random_values<double>(item_count, 1., 1e3);
+	const auto q = bench::random_quantities<s>(raw);
+	std::vector<double> raw_r(item_count);
+	std::vector<Hz>     r    (item_count);
+
+	runner.measure("std::pow(v,-1.) (baseline)", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			raw_r[idx] = std::pow(raw[idx], -1.);
+		bench::do_not_optimize(raw_r[0]);
+	});
+	runner.measure("1/v", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			raw_r[idx] = 1. / raw[idx];
+		bench::do_not_optimize(raw_r[0]);
+	});
+	runner.measure("unlib::pow<-1>", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			r[idx] = unlib::pow<-1>(q[idx]);
+		bench::do_not_optimize(r[0]);
+	});
+}
+
+UNLIB_BENCHMARK(math_pow2_m_long) {
+	const auto raw = bench::random_values<long>(item_count, 0, 1000000);
+	const auto q = bench::random_quantities<m_long>(raw);
+	std::vector<long>   raw_r(item_count);
+	std::vector<m2_long> r   (item_count);
+
+	runner.measure("std::pow(double(v),2.) (baseline)", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			raw_r[idx] = static_cast<long>(std::pow(static_cast<double>(raw[idx]), 2.));
+		bench::do_not_optimize(raw_r[0]);
+	});
+	runner.measure("v*v", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			raw_r[idx] = raw[idx] * raw[idx];
+		bench::do_not_optimize(raw_r[0]);
+	});
+	runner.measure("unlib::pow<2>", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			r[idx] = unlib::pow<2>(q[idx]);
+		bench::do_not_optimize(r[0]);
+	});
+}
+
+UNLIB_BENCHMARK(math_is_near_W_kW) {
+	const auto raw_a = bench::random_values<double>(item_count, 0., 1e6);
+	const auto raw_b = bench::random_values<double>(item_count, 0., 1e3);
+	const auto a = bench::random_quantities<W >(raw_a);
+	const auto b = bench::random_quantities<kW>(raw_b);
+
+	runner.measure("abs(a-b*1000) <= tol (baseline)", item_count, [&]{
+		std::size_t count = 0;
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			count += std::abs(raw_a[idx] - raw_b[idx]*1000.) <= 1000.;
+		bench::do_not_optimize(count);
+	});
+	runner.measure("is_near(W, kW, tolerance_value)", item_count, [&]{
+		std::size_t count = 0;
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			count += unlib::is_near(a[idx], b[idx], unlib::tolerance_value(W{1000.}));
+		bench::do_not_optimize(count);
+	});
+}
+
+UNLIB_BENCHMARK(math_span_sqrt_m2) {
+	const auto raw = bench::random_values<double>(item_count, 0., 1e6);
+	const auto q = bench::random_quantities<m2>(raw);
+	std::vector<double> raw_r(item_count);
+	std::vector<m>      r    (item_count);
+
+	runner.measure("std::sqrt loop (baseline)", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			raw_r[idx] = std::sqrt(raw[idx]);
+		bench::do_not_optimize(raw_r[0]);
+	});
+	runner.measure("unlib::sqrt loop", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			r[idx] = unlib::sqrt(q[idx]);
+		bench::do_not_optimize(r[0]);
+	});
+	runner.measure("unlib::sqrt_span", item_count, [&]{
+		unlib::sqrt_span(unlib::make_quantity_span(q), unlib::make_quantity_span(r));
+		bench::do_not_optimize(r[0]);
+	});
+}
+
+UNLIB_BENCHMARK(math_span_abs_W) {
+	const auto raw = bench::random_values<double>(item_count, -1e6, 1e6);
+	const auto q = bench::random_quantities<W>(raw);
+	std::vector<double> raw_r(item_count);
+	std::vector<W>      r    (item_count);
+
+	runner.measure("std::abs loop (baseline)", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			raw_r[idx] = std::abs(raw[idx]);
+		bench::do_not_optimize(raw_r[0]);
+	});
+	runner.measure("unlib::abs loop", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			r[idx] = unlib::abs(q[idx]);
+		bench::do_not_optimize(r[0]);
+	});
+	runner.measure("unlib::abs_span", item_count, [&]{
+		unlib::abs_span(unlib::make_quantity_span(q), unlib::make_quantity_span(r));
+		bench::do_not_optimize(r[0]);
+	});
+}
+
+UNLIB_BENCHMARK(math_span_pow2_m) {
+	const auto raw = bench::random_values<double>(item_count, 0., 1e3);
+	const auto q = bench::random_quantities<m>(raw);
+	std::vector<double> raw_r(item_count);
+	std::vector<m2>     r    (item_count);
+
+	runner.measure("std::pow(v,2) loop (baseline)", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			raw_r[idx] = std::pow(raw[idx], 2);
+		bench::do_not_optimize(raw_r[0]);
+	});
+	runner.measure("unlib::pow<2> loop", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			r[idx] = unlib::pow<2>(q[idx]);
+		bench::do_not_optimize(r[0]);
+	});
+	runner.measure("unlib::pow_span<2>", item_count, [&]{
+		unlib::pow_span<2>(unlib::make_quantity_span(q), unlib::make_quantity_span(r));
+		bench::do_not_optimize(r[0]);
+	});
+}
+
+UNLIB_BENCHMARK(math_span_max_W_kW) {
+	const auto raw_a = bench::random_values<double>(item_count, 0., 1e6);
+	const auto raw_b = bench::random_values<double>(item_count, 0., 1e3);
+	const auto a = bench::random_quantities<W >(raw_a);
+	const auto b = bench::random_quantities<kW>(raw_b);
+	std::vector<double> raw_r(item_count);
+	std::vector<W>      r    (item_count);
+
+	runner.measure("std::max(a,b*1000) loop (baseline)", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			raw_r[idx] = std::max(raw_a[idx], raw_b[idx]*1000.);
+		bench::do_not_optimize(raw_r[0]);
+	});
+	runner.measure("unlib::max loop", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			r[idx] = unlib::max(a[idx], b[idx]);
+		bench::do_not_optimize(r[0]);
+	});
+	runner.measure("unlib::max_span", item_count, [&]{
+		unlib::max_span(unlib::make_quantity_span(a), unlib::make_quantity_span(b), unlib::make_quantity_span(r));
+		bench::do_not_optimize(r[0]);
+	});
+}
+
+UNLIB_BENCHMARK(math_is_near_span_kW) {
+	const auto raw_a = bench::random_values<double>(item_count, 0., 1e3);
+	auto raw_b = raw_a;
+	raw_b[item_count-1] += 1.;
+	const auto a = bench::random_quantities<kW>(raw_a);
+	const auto b = bench::random_quantities<kW>(raw_b);
+	const auto tol = unlib::tolerance_nominal(kW{1000.});
+
+	runner.measure("is_near loop (baseline)", item_count, [&]{
+		std::size_t count = 0;
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			count += not unlib::is_near(a[idx], b[idx], tol);
+		bench::do_not_optimize(count);
+	});
+	runner.measure("is_near_span", item_count, [&]{
+		const auto result = unlib::is_near_span(unlib::make_quantity_span(a), unlib::make_quantity_span(b), tol);
+		bench::do_not_optimize(result);
+	});
+	runner.measure("find_not_near", item_count, [&]{
+		const auto idx = unlib::find_not_near(unlib::make_quantity_span(a), unlib::make_quantity_span(b), tol);
+		bench::do_not_optimize(idx);
+	});
+}
@@ -0,0 +1,138 @@
+#include <unlib/numeric.hpp>
+
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#include <unlib/common.hpp>
+#include <unlib/bench/unlib_bench.hpp>
+
+namespace {
+
+constexpr std::size_t item_count = 65536;
+
+using  Ws  = unlib::watt_second<double>;
+using kWh  = unlib::kilo<unlib::watt_hour<double>>;
+using  W   = unlib::watt<double>;
+using  s   = unlib::second<double>;
+using  Wh  = unlib::watt_hour<double>;
+using kW   = unlib::kilo<unlib::watt<double>>;
+
+}
+
+UNLIB_BENCHMARK(numeric_sum_Ws) {
+	const auto raw = bench::random_values<double>(item_count, 0., 1e4);
+	const auto q = bench::random_quantities<Ws>(raw);
+
+	runner.measure("std::accumulate (baseline)", item_count, [&]{
+		const double total = std::accumulate(raw.begin(), raw.end(), 0.);
+		bench::do_not_optimize(total);
+	});
+	runner.measure("quantity += loop", item_count, [&]{
+		Ws total{};
+		for(const auto& e : q)
+			total += e;
+		bench::do_not_optimize(total);
+	});
+	runner.measure("unlib::sum", item_count, [&]{
+		const Ws total = unlib::sum(unlib::make_quantity_span(q));
+		bench::do_not_optimize(total);
+	});
+	runner.measure("kahan_accumulator += loop", item_count, [&]{
+		unlib::kahan_accumulator<Ws> acc;
+		for(const auto& e : q)
+			acc += e;
+		bench::do_not_optimize(acc.sum());
+	});
+	runner.measure("unlib::compensated_sum", item_count, [&]{
+		const Ws total = unlib::compensated_sum(unlib::make_quantity_span(q));
+		bench::do_not_optimize(total);
+	});
+	runner.measure("kahan_accumulator<kWh>::add", item_count, [&]{
+		unlib::kahan_accumulator<kWh> acc;
+		acc.add(unlib::make_quantity_span(q));
+		bench::do_not_optimize(acc.sum());
+	});
+}
+
+UNLIB_BENCHMARK(numeric_integrate_W_s) {
+	const auto raw_p = bench::random_values<double>(item_count, 0., 1e4);
+	const auto raw_d = bench::random_values<double>(item_count, 0.5, 1.5);
+	std::vector<double> raw_t(item_count);
+	std::partial_sum(raw_d.begin(), raw_d.end(), raw_t.begin());
+	const auto p = bench::random_quantities<W>(raw_p);
+	const auto t = bench::random_quantities<s>(raw_t);
+
+	runner.measure("raw double loop (baseline)", item_count, [&]{
+		double energy = 0.;
+		for(std::size_t idx=1; idx<item_count; ++idx)
+			energy += (raw_t[idx] - raw_t[idx-1]) * (raw_p[idx] + raw_p[idx-1]) * 0.5;
+		bench::do_not_optimize(energy / 3.6e6);
+	});
+	runner.measure("quantity loop into kWh", item_count, [&]{
+		kWh energy{};
+		for(std::size_t idx=1; idx<item_count; ++idx)
+			energy += (t[idx] - t[idx-1]) * (p[idx] + p[idx-1]) / 2.;
+		bench::do_not_optimize(energy);
+	});
+	runner.measure("unlib::integrate<kWh>", item_count, [&]{
+		bench::do_not_optimize(unlib::integrate<kWh>(unlib::make_quantity_span(p), unlib::make_quantity_span(t)));
+	});
+	runner.measure("unlib::integrate<kWh>, uniform step", item_count, [&]{
+		bench::do_not_optimize(unlib::integrate<kWh>(unlib::make_quantity_span(p), s{1.}));
+	});
+}
+
+UNLIB_BENCHMARK(numeric_differentiate_Wh_s) {
+	const auto raw_d = bench::random_values<double>(item_count, 0., 1.);
+	const auto raw_s = bench::random_values<double>(item_count, 0.5, 1.5);
+	std::vector<double> raw_e(item_count), raw_t(item_count), raw_p(item_count-1);
+	std::partial_sum(raw_d.begin(), raw_d.end(), raw_e.begin());
+	std::partial_sum(raw_s.begin(), raw_s.end(), raw_t.begin());
+	const auto e = bench::random_quantities<Wh>(raw_e);
+	const auto t = bench::random_quantities<s >(raw_t);
+	std::vector<W> p(item_count-1);
+
+	runner.measure("raw double loop (baseline)", item_count-1, [&]{
+		for(std::size_t idx=0; idx+1<item_count; ++idx)
+			raw_p[idx] = (raw_e[idx+1] - raw_e[idx]) * 3600. / (raw_t[idx+1] - raw_t[idx]);
+		bench::do_not_optimize(raw_p[0]);
+	});
+	runner.measure("quantity loop", item_count-1, [&]{
+		for(std::size_t idx=0; idx+1<item_count; ++idx)
+			p[idx] = (e[idx+1] - e[idx]) / (t[idx+1] - t[idx]);
+		bench::do_not_optimize(p[0]);
+	});
+	runner.measure("unlib::differentiate", item_count-1, [&]{
+		unlib::differentiate(unlib::make_quantity_span(e), unlib::make_quantity_span(t), unlib::make_quantity_span(p));
+		bench::do_not_optimize(p[0]);
+	});
+}
+
+UNLIB_BENCHMARK(numeric_differentiate_counter) {
+	using kWh_counter = unlib::kilo<unlib::watt_hour<unsigned>>;
+	using   s_counter = unlib::second<unsigned>;
+	std::vector<unsigned>    raw_e, raw_t;
+	std::vector<kWh_counter> e;
+	std::vector<s_counter>   t;
+	for(std::size_t idx=0; idx<item_count; ++idx) {
+		raw_e.push_back(static_cast<unsigned>(idx * 7 % 1000000));
+		raw_t.push_back(static_cast<unsigned>(idx * 900));
+		e.push_back(kWh_counter{raw_e.back()});
+		t.push_back(  s_counter{raw_t.back()});
+	}
+	std::vector<double> raw_p(item_count-1);
+	std::vector<kW>         p(item_count-1);
+
+	runner.measure("raw unsigned loop, wrapping at 10^6 (baseline)", item_count-1, [&]{
+		for(std::size_t idx=0; idx+1<item_count; ++idx) {
+			const unsigned de = raw_e[idx+1] < raw_e[idx] ? raw_e[idx+1] + (1000000u - raw_e[idx]) : raw_e[idx+1] - raw_e[idx];
+			raw_p[idx] = static_cast<double>(de) * 3600. / static_cast<double>(raw_t[idx+1] - raw_t[idx]);
+		}
+		bench::do_not_optimize(raw_p[0]);
+	});
+	runner.measure("unlib::differentiate, wrapping at 10^6", item_count-1, [&]{
+		unlib::differentiate(unlib::make_quantity_span(e), unlib::make_quantity_span(t), unlib::make_quantity_span(p), kWh_counter{1000000});
+		bench::do_not_optimize(p[0]);
+	});
+}
@@ -0,0 +1,86 @@
+#include <unlib/parallel.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <unlib/common.hpp>
+#include <unlib/bench/unlib_bench.hpp>
+
+namespace {
+
+constexpr std::size_t item_count = std::size_t{1} << 22;
+
+using kW = unlib::kilo<unlib::watt<double>>;
+
+std::vector<kW> random_power() {
+	return bench::random_quantities<kW>(bench::random_values<double>(item_count, -1e3, 1e3));
+}
+
+/* 1, 2, 4, ... threads, up to (and including) the number of hardware
+ * threads, but at least 2, so the parallel code path is always measured */
+std::vector<std::size_t> thread_counts() {
+	const std::size_t hardware = std::max<std::size_t>(unlib::thread_pool::default_concurrency(), 2);
+	std::vector<std::size_t> counts;
+	for(std::size_t count=1; count<hardware; count*=2)
+		counts.push_back(count);
+	counts.push_back(hardware);
+	return counts;
+}
+
+std::string threads(std::size_t count)                                    {return std::to_string(count) + (count == 1 ? " thread" : " threads");}
+
+}
+
+UNLIB_BENCHMARK(parallel_sum_kW) {
+	const auto q = random_power();
+	const auto s = unlib::make_quantity_span(q);
+
+	runner.measure("unlib::sum (baseline)", item_count, [&]{
+		bench::do_not_optimize(unlib::sum(s));
+	});
+	for(auto count : thread_counts()) {
+		unlib::thread_pool pool{count};
+		runner.measure("unlib::sum, " + threads(count), item_count, [&]{
+			bench::do_not_optimize(unlib::sum(pool, s));
+		});
+	}
+}
+
+UNLIB_BENCHMARK(parallel_max_kW) {
+	const auto q = random_power();
+	const auto s = unlib::make_quantity_span(q);
+
+	runner.measure("std::max_element (baseline)", item_count, [&]{
+		bench::do_not_optimize(*std::max_element(q.begin(), q.end()));
+	});
+	runner.measure("unlib::max", item_count, [&]{
+		bench::do_not_optimize(unlib::max(s));
+	});
+	for(auto count : thread_counts()) {
+		unlib::thread_pool pool{count};
+		runner.measure("unlib::max, " + threads(count), item_count, [&]{
+			bench::do_not_optimize(unlib::max(pool, s));
+		});
+	}
+}
+
+UNLIB_BENCHMARK(parallel_argmax_kW) {
+	const auto q = random_power();
+	const auto s = unlib::make_quantity_span(q);
+
+	runner.measure("std::max_element (baseline)", item_count, [&]{
+		bench::do_not_optimize(std::max_element(q.begin(), q.end()) - q.begin());
+	});
+	runner.measure("unlib::argmax", item_count, [&]{
+		bench::do_not_optimize(unlib::argmax(s));
+	});
+	for(auto count : thread_counts()) {
+		unlib::thread_pool pool{count};
+		runner.measure("unlib::argmax, " + threads(count), item_count, [&]{
+			bench::do_not_optimize(unlib::argmax(pool, s));
+		});
+	}
+}
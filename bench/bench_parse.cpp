@@ -0,0 +1,62 @@
+#include <unlib/quantity.hpp>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unlib/common.hpp>
+#include <unlib/bench/unlib_bench.hpp>
+
+namespace {
+
+constexpr std::size_t item_count = 1u << 14;
+
+/* one line per quantity, formatted by to_chars() */
+template<typename Q, typename V>
+std::string make_input(const std::vector<V>& values) {
+	std::string input;
+	char buffer[64];
+	for(auto v : values) {
+		input.append(buffer, unlib::to_chars(buffer, buffer+sizeof(buffer), Q{v}).ptr);
+		input += '\n';
+	}
+	return input;
+}
+
+template<typename Q, typename V>
+void bench_parsing(bench::runner& runner, const std::vector<V>& values) {
+	const std::string input = make_input<Q>(values);
+
+	runner.measure("from_chars", item_count, [&]{
+		const char* it = input.data();
+		const char* const last = input.data() + input.size();
+		Q q;
+		typename Q::value_type sum{};
+		while(it != last) {
+			it = unlib::from_chars(it, last, q).ptr + 1;
+			sum += q.get();
+		}
+		bench::do_not_optimize(sum);
+	});
+
+	runner.measure("operator>> (value only)", item_count, [&]{
+		std::istringstream iss{input};
+		std::string unit;
+		Q q;
+		typename Q::value_type sum{};
+		while(iss >> q >> unit)
+			sum += q.get();
+		bench::do_not_optimize(sum);
+	});
+}
+
+}
+
+UNLIB_BENCHMARK(parse_double_kWh) {
+	bench_parsing<unlib::kilo<unlib::watt_hour<double>>>(runner, bench::random_values<double>(item_count, 0., 1e6));
+}
+
+UNLIB_BENCHMARK(parse_int64_Wh) {
+	bench_parsing<unlib::watt_hour<std::int64_t>>(runner, bench::random_values<std::int64_t>(item_count, -1000000000, 1000000000));
+}
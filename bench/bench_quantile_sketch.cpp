@@ -0,0 +1,77 @@
+#include <unlib/quantile_sketch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unlib/common.hpp>
+#include <unlib/bench/unlib_bench.hpp>
+
+namespace {
+
+constexpr std::size_t item_count = std::size_t{1} << 20;
+
+using ms = unlib::milli<unlib::second<double>>;
+
+/* exponentially distributed, i.e. long-tailed, latencies */
+std::vector<ms> random_latencies() {
+	auto raw = bench::random_values<double>(item_count, 0., 1.);
+	for(auto& v : raw)
+		v = -20. * std::log1p(-v);
+	return bench::random_quantities<ms>(raw);
+}
+
+/* describes a sketch by its serialized size and its worst rank error at
+ * a few quantiles, so the variants show the accuracy bought with memory */
+std::string describe(const unlib::quantile_sketch<ms>& sketch, const std::vector<double>& sorted) {
+	std::ostringstream oss;
+	sketch.write(oss);
+	double max_error = 0.;
+	for(double q : {0.5, 0.9, 0.99, 0.999}) {
+		const auto v = sketch.quantile(q).get();
+		const double rank = static_cast<double>(std::lower_bound(sorted.begin(), sorted.end(), v) - sorted.begin()) / static_cast<double>(sorted.size());
+		max_error = std::max(max_error, std::abs(rank - q));
+	}
+	char buffer[128];
+	std::snprintf(buffer, sizeof(buffer), "compression %4.0f, %5zu bytes, rank error %.1e", sketch.compression(), oss.str().size(), max_error);
+	return buffer;
+}
+
+}
+
+UNLIB_BENCHMARK(quantile_sketch_ms) {
+	const auto q = random_latencies();
+	std::vector<double> sorted;
+	for(const auto& l : q)
+		sorted.push_back(l.get());
+	std::sort(sorted.begin(), sorted.end());
+
+	std::vector<double> copy(sorted.size());
+	runner.measure("exact p99 with std::nth_element (baseline)", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			copy[idx] = q[idx].get();
+		const auto p99 = copy.begin() + static_cast<std::ptrdiff_t>(item_count * 99 / 100);
+		std::nth_element(copy.begin(), p99, copy.end());
+		bench::do_not_optimize(*p99);
+	});
+	for(double compression : {50., 100., 200., 500.}) {
+		unlib::quantile_sketch<ms> sketch{compression};
+		sketch.insert(unlib::make_quantity_span(q));
+		const std::string description = describe(sketch, sorted);
+		runner.measure("insert, " + description, item_count, [&]{
+			unlib::quantile_sketch<ms> s{compression};
+			for(const auto& l : q)
+				s.insert(l);
+			bench::do_not_optimize(s.quantile(0.99));
+		});
+		runner.measure("insert(span), " + description, item_count, [&]{
+			unlib::quantile_sketch<ms> s{compression};
+			s.insert(unlib::make_quantity_span(q));
+			bench::do_not_optimize(s.quantile(0.99));
+		});
+	}
+}
@@ -0,0 +1,117 @@
+#include <unlib/quantity_span.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <unlib/common.hpp>
+#include <unlib/quantity_vector.hpp>
+#include <unlib/bench/unlib_bench.hpp>
+
+namespace {
+
+constexpr std::size_t item_count = 1u << 20;
+
+using mWh = unlib::milli<unlib::watt_hour<double>>;
+using kWh = unlib:: kilo<unlib::watt_hour<double>>;
+
+}
+
+UNLIB_BENCHMARK(rescale_mWh_to_kWh) {
+	const auto raw = bench::random_values<double>(item_count, 0., 1e9);
+
+	unlib::quantity_vector<unlib::energy, mWh::scale_type, double> in;
+	in.reserve(item_count);
+	for(auto v : raw)
+		in.push_back(mWh{v});
+	unlib::quantity_vector<unlib::energy, kWh::scale_type, double> out(item_count);
+
+	runner.measure("raw double loop (baseline)", item_count, [&]{
+		const double* src = in.values();
+		double*       dst = out.values();
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			dst[idx] = src[idx] / 1000000.;
+		bench::do_not_optimize(dst[0]);
+	});
+
+	runner.measure("per-quantity conversion", item_count, [&]{
+		for(std::size_t idx=0; idx<item_count; ++idx)
+			out[idx] = in[idx];
+		bench::do_not_optimize(out[0]);
+	});
+
+	runner.measure("rescale_span", item_count, [&]{
+		unlib::rescale_span(unlib::make_quantity_span(in), unlib::make_quantity_span(out));
+		bench::do_not_optimize(out[0]);
+	});
+}
+
+UNLIB_BENCHMARK(rescale_Ws_to_kWh_policies) {
+	// small enough to stay in cache, so the arithmetic is measured, not memory
+	constexpr std::size_t count = 4096;
+	using Ws_scaling = unlib::watt_second<double>::scale_type;
+	using kWh_scaling = kWh::scale_type;
+
+	const auto in = bench::random_values<double>(count, 0., 1e9);
+	std::vector<double> out(count);
+
+	runner.measure("exact (v*num)/den", count, [&]{
+		unlib::detail::rescale_values<kWh_scaling,Ws_scaling>(in.data(), count, out.data(), unlib::detail::exact_floatpt_rescaling{});
+		bench::do_not_optimize(out[0]);
+	});
+
+	runner.measure("fast v*factor", count, [&]{
+		unlib::detail::rescale_values<kWh_scaling,Ws_scaling>(in.data(), count, out.data(), unlib::detail::fast_floatpt_rescaling{});
+		bench::do_not_optimize(out[0]);
+	});
+
+	std::vector<unlib::watt_second<double>> ws;
+	for(auto v : in)
+		ws.push_back(unlib::watt_second<double>{v});
+	const kWh limit{100.};
+
+	runner.measure("compare kWh < Ws (default policy)", count, [&]{
+		std::size_t n = 0;
+		for(const auto& q : ws)
+			n += limit < q;
+		bench::do_not_optimize(n);
+	});
+}
+
+UNLIB_BENCHMARK(rescale_int64_mWh_to_Ws) {
+	constexpr std::size_t count = 4096;
+	using mWh_i64 = unlib::milli<unlib::watt_hour<std::int64_t>>;
+	using  Ws_i64 = unlib::watt_second<std::int64_t>;
+	using rescaler = unlib::detail::value_rescaler<Ws_i64::scale_type, mWh_i64::scale_type>;
+	using conversion = rescaler::conversion_scale;
+
+	const auto in = bench::random_values<std::int64_t>(count, -1000000000000, 1000000000000);
+	std::vector<std::int64_t> out(count);
+
+	runner.measure("(v*num)/den (overflowing)", count, [&]{
+		for(std::size_t idx=0; idx<count; ++idx)
+			out[idx] = (in[idx]*conversion::num)/conversion::den;
+		bench::do_not_optimize(out[0]);
+	});
+
+	runner.measure("integer_rescaler", count, [&]{
+		unlib::detail::rescale_values<Ws_i64::scale_type, mWh_i64::scale_type>(in.data(), count, out.data());
+		bench::do_not_optimize(out[0]);
+	});
+
+	std::vector<mWh_i64> qin;
+	for(auto v : in)
+		qin.push_back(mWh_i64{v});
+	std::vector<Ws_i64> qout(count);
+
+	runner.measure("checked_scale_cast", count, [&]{
+		for(std::size_t idx=0; idx<count; ++idx)
+			qout[idx] = unlib::checked_scale_cast<Ws_i64::scale_type>(qin[idx]);
+		bench::do_not_optimize(qout[0]);
+	});
+
+	runner.measure("saturating_scale_cast", count, [&]{
+		for(std::size_t idx=0; idx<count; ++idx)
+			qout[idx] = unlib::saturating_scale_cast<Ws_i64::scale_type>(qin[idx]);
+		bench::do_not_optimize(qout[0]);
+	});
+}
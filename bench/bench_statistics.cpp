@@ -0,0 +1,56 @@
+#include <unlib/statistics.hpp>
+
+#include <cstddef>
+#include <vector>
+
+#include <unlib/common.hpp>
+#include <unlib/bench/unlib_bench.hpp>
+
+namespace {
+
+constexpr std::size_t item_count = 65536;
+
+using V = unlib::volt<double>;
+
+/* what users wrote before running_stats */
+struct welford {
+	std::size_t count = 0;
+	double      mean  = 0.;
+	double      m2    = 0.;
+	double      min   = 1e300;
+	double      max   = -1e300;
+
+	void push(double v) {
+		++count;
+		const double delta = v - mean;
+		mean += delta / static_cast<double>(count);
+		m2   += delta * (v - mean);
+		min   = v < min ? v : min;
+		max   = max < v ? v : max;
+	}
+};
+
+}
+
+UNLIB_BENCHMARK(statistics_running_stats_V) {
+	const auto raw = bench::random_values<double>(item_count, 220., 240.);
+	const auto q = bench::random_quantities<V>(raw);
+
+	runner.measure("raw Welford loop (baseline)", item_count, [&]{
+		welford stats;
+		for(auto v : raw)
+			stats.push(v);
+		bench::do_not_optimize(stats);
+	});
+	runner.measure("running_stats::push loop", item_count, [&]{
+		unlib::running_stats<V> stats;
+		for(const auto& v : q)
+			stats.push(v);
+		bench::do_not_optimize(stats);
+	});
+	runner.measure("running_stats::push(span)", item_count, [&]{
+		unlib::running_stats<V> stats;
+		stats.push(unlib::make_quantity_span(q));
+		bench::do_not_optimize(stats);
+	});
+}
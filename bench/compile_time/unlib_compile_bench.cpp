@@ -0,0 +1,307 @@
+/*
+ * Compile-time benchmarks
+ *
+ * This generates translation units instantiating increasing numbers of
+ * distinct unit, quantity, and literal trait types, compiles each of them,
+ * and reports the compiler's wall time and peak memory usage. Comparing the
+ * results of different library versions shows the effect of changes on
+ * compile times. Comparing common_io to common_io_extern shows what a
+ * translation unit of a project formatting and parsing common quantities
+ * saves when linking against the unlib_common library.
+ *
+ * usage: unlib_compile_bench [--sizes=<n>,<n>,...] [--json | --json=<file>] [<scenario>...]
+ *
+ * Only scenarios whose names contain one of the <scenario> strings are run.
+ * The compiler and flags used default to those of the build, and can be
+ * overridden by setting UNLIB_COMPILE_BENCH_CXX and
+ * UNLIB_COMPILE_BENCH_FLAGS in the environment.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#if !defined(UNLIB_COMPILE_BENCH_CXX)
+#	define UNLIB_COMPILE_BENCH_CXX "c++"
+#endif
+#if !defined(UNLIB_COMPILE_BENCH_FLAGS)
+#	define UNLIB_COMPILE_BENCH_FLAGS ""
+#endif
+
+namespace {
+
+/* code generation ***********************************************************/
+
+/* the i-th of up to 7^4 distinct units */
+std::string unit_type(std::size_t i) {
+	std::ostringstream oss;
+	oss << "unlib::unit<";
+	for(std::size_t exp=0, div=1; exp<4; ++exp, div*=7)
+		oss << "std::ratio<" << static_cast<int>(i/div%7)-3 << ">,";
+	oss << "std::ratio<0>,std::ratio<0>,std::ratio<0>>";
+	return oss.str();
+}
+
+std::string quantity_type(std::size_t i)                                  {return "unlib::quantity<" + unit_type(i) + ">";}
+
+std::string gen_baseline_quantity(std::size_t) {
+	return "#include <unlib/quantity.hpp>\n";
+}
+
+std::string gen_baseline_common(std::size_t) {
+	return "#include <unlib/common.hpp>\n";
+}
+
+std::string gen_unit(std::size_t n) {
+	std::ostringstream oss;
+	oss << "#include <unlib/unit.hpp>\n";
+	for(std::size_t i=0; i<n; ++i)
+		oss << "static_assert(unlib::length_exponent_t<" << unit_type(i) << ">::num < 100, \"\");\n";
+	return oss.str();
+}
+
+std::string gen_quantity(std::size_t n) {
+	std::ostringstream oss;
+	oss << "#include <unlib/quantity.hpp>\n";
+	for(std::size_t i=0; i<n; ++i)
+		oss << "double f" << i << "(double a, double b) {using q = " << quantity_type(i) << "; return (q{a} + q{b}).get() + (q{a} < q{b});}\n";
+	return oss.str();
+}
+
+std::string gen_mul_quantity(std::size_t n) {
+	std::ostringstream oss;
+	oss << "#include <unlib/quantity.hpp>\n";
+	for(std::size_t i=0; i<n; ++i)
+		oss << "double f" << i << "(double a, double b) {"
+		    << "using q1 = " << quantity_type(i) << "; using q2 = " << quantity_type(i+1) << "; "
+		    << "return (q1{a} * q2{b}).get() + (q1{a} / q2{b}).get();}\n";
+	return oss.str();
+}
+
+std::string gen_pow_quantity(std::size_t n) {
+	std::ostringstream oss;
+	oss << "#include <type_traits>\n#include <unlib/quantity.hpp>\n";
+	for(std::size_t i=0; i<n; ++i)
+		oss << "static_assert(std::is_same<unlib::sqrt_quantity_t<unlib::pow_quantity_t<" << quantity_type(i) << ",std::ratio<2>>>, "
+		    << quantity_type(i) << ">::value, \"\");\n";
+	return oss.str();
+}
+
+std::string gen_literal_traits(std::size_t n) {
+	static const char* const units [] = { "second", "gram", "meter", "hertz", "ampere", "volt", "ohm", "watt", "var", "voltampere"
+	                                    , "watt_second", "var_second", "voltampere_second", "ampere_second", "pascal_" };
+	static const char* const scales[] = { "", "unlib::nano", "unlib::micro", "unlib::milli", "unlib::kilo", "unlib::mega", "unlib::giga" };
+	std::ostringstream oss;
+	oss << "#include <unlib/common.hpp>\n";
+	for(std::size_t i=0; i<n; ++i) {
+		const std::string base  = std::string("unlib::") + units[i%(sizeof(units)/sizeof(units[0]))] + "<double>";
+		const std::string scale = scales[i/(sizeof(units)/sizeof(units[0]))];
+		const std::string q     = scale.empty() ? base : scale + "<" + base + ">";
+		oss << "char* f" << i << "(char* first, char* last) {return unlib::to_chars(first, last, " << q << "{1.}).ptr;}\n";
+	}
+	return oss.str();
+}
+
+/* formats and parses the first n of the quantities in common_extern.hpp */
+std::string gen_common_io(std::size_t n, bool extern_instantiations) {
+	static const char* const quantities[] = { "second", "milli<unlib::second", "minute", "hour", "day", "gram", "kilo<unlib::gram"
+	                                        , "meter", "kilo<unlib::meter", "liter", "degree_kelvin", "degree_celsius", "hertz"
+	                                        , "ampere", "milli<unlib::ampere", "volt", "kilo<unlib::volt", "ohm", "watt"
+	                                        , "kilo<unlib::watt", "mega<unlib::watt", "var", "kilo<unlib::var", "voltampere"
+	                                        , "kilo<unlib::voltampere", "watt_hour", "kilo<unlib::watt_hour", "mega<unlib::watt_hour"
+	                                        , "var_hour", "kilo<unlib::var_hour", "voltampere_hour", "kilo<unlib::voltampere_hour"
+	                                        , "ampere_hour" };
+	const std::size_t count = sizeof(quantities)/sizeof(quantities[0]);
+	std::ostringstream oss;
+	if(extern_instantiations)
+		oss << "#define UNLIB_EXTERN_COMMON_QUANTITIES 1\n";
+	oss << "#include <sstream>\n#include <string>\n#include <unlib/common.hpp>\n";
+	for(std::size_t i=0; i<n; ++i) {
+		const std::string name = quantities[i%count];
+		const std::string q    = "unlib::" + name + (i < count ? "<double>" : "<long>") + (name.find('<') == std::string::npos ? "" : ">");
+		oss << "std::string f" << i << "(const char* first, const char* last, std::stringstream& ss) {"
+		    << "using q = " << q << "; q v{}; unlib::from_chars(first, last, v); ss << v; ss >> v; "
+		    << "char buf[64]; unlib::to_chars(buf, buf+sizeof(buf), v); return unlib::to_string(v);}\n";
+	}
+	return oss.str();
+}
+
+std::string gen_common_io_implicit(std::size_t n)                        {return gen_common_io(n, false);}
+std::string gen_common_io_extern  (std::size_t n)                        {return gen_common_io(n, true );}
+
+struct scenario {
+	const char*        name;
+	std::string      (*generate)(std::size_t);
+	bool               sized;     /* whether the scenario depends on the size */
+	std::size_t        max_size;
+};
+
+const scenario scenarios[] = { {"baseline_quantity_hpp", gen_baseline_quantity , false,    0}
+                             , {"baseline_common_hpp"  , gen_baseline_common   , false,    0}
+                             , {"unit"                 , gen_unit              , true , 2400}
+                             , {"quantity"             , gen_quantity          , true , 2400}
+                             , {"mul_quantity_t"       , gen_mul_quantity      , true , 2400}
+                             , {"pow_quantity_t"       , gen_pow_quantity      , true , 2400}
+                             , {"literal_traits"       , gen_literal_traits    , true ,  105}
+                             , {"common_io"            , gen_common_io_implicit, true ,   66}
+                             , {"common_io_extern"     , gen_common_io_extern  , true ,   66} };
+
+/* measurement ***************************************************************/
+
+struct result {
+	std::string scenario;
+	std::size_t size;
+	double      seconds;
+	long        peak_kb;
+	bool        ok;
+};
+
+std::vector<std::string> split(const std::string& str) {
+	std::vector<std::string> parts;
+	std::istringstream iss(str);
+	for(std::string part; iss >> part;)
+		parts.push_back(part);
+	return parts;
+}
+
+/* compiles a file and measures the compiler's wall time and peak memory */
+result compile(const std::string& cxx, const std::string& flags, const std::string& source, const std::string& object) {
+	std::vector<std::string> args = split(cxx);
+	for(const auto& flag : split(flags))
+		args.push_back(flag);
+	args.insert(args.end(), {"-c", source, "-o", object});
+
+	std::vector<char*> argv;
+	for(auto& arg : args)
+		argv.push_back(&arg[0]);
+	argv.push_back(nullptr);
+
+	result r{};
+	const auto start = std::chrono::steady_clock::now();
+	const pid_t pid = ::fork();
+	if(pid == 0) {
+		::execvp(argv[0], argv.data());
+		std::perror(argv[0]);
+		std::_Exit(127);
+	}
+	int status = 0;
+	struct ::rusage usage{};
+	if(pid < 0 || ::wait4(pid, &status, 0, &usage) < 0)
+		return r;
+	r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	r.peak_kb = usage.ru_maxrss;
+	r.ok      = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+	return r;
+}
+
+std::string json_escape(const std::string& str) {
+	std::string result;
+	for(char c : str) {
+		if(c == '"' || c == '\\')
+			result += '\\';
+		result += c;
+	}
+	return result;
+}
+
+void print_json(std::FILE* file, const std::string& cxx, const std::string& flags, const std::vector<result>& results) {
+	std::fprintf(file, "{\n  \"compiler\": \"%s\",\n  \"flags\": \"%s\",\n  \"results\": [", json_escape(cxx).c_str(), json_escape(flags).c_str());
+	const char* separator = "\n";
+	for(const auto& r : results) {
+		std::fprintf(file, "%s    {\"scenario\": \"%s\", \"size\": %lu, \"seconds\": %.4f, \"peak_kb\": %ld, \"ok\": %s}"
+		           , separator, json_escape(r.scenario).c_str(), static_cast<unsigned long>(r.size), r.seconds, r.peak_kb, r.ok ? "true" : "false");
+		separator = ",\n";
+	}
+	std::fprintf(file, "\n  ]\n}\n");
+}
+
+const char* get_env(const char* name, const char* default_value) {
+	const char* value = std::getenv(name);
+	return value ? value : default_value;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+	std::vector<std::size_t>  sizes{25, 100, 250};
+	std::vector<const char*>  filters;
+	bool                      json_to_stdout = false;
+	const char*               json_file      = nullptr;
+
+	for(int arg=1; arg<argc; ++arg) {
+		if(std::strcmp(argv[arg], "--json") == 0)
+			json_to_stdout = true;
+		else if(std::strncmp(argv[arg], "--json=", 7) == 0)
+			json_file = argv[arg] + 7;
+		else if(std::strncmp(argv[arg], "--sizes=", 8) == 0) {
+			sizes.clear();
+			std::istringstream iss(argv[arg] + 8);
+			for(std::string size; std::getline(iss, size, ',');)
+				sizes.push_back(std::strtoul(size.c_str(), nullptr, 10));
+		} else
+			filters.push_back(argv[arg]);
+	}
+
+	const std::string cxx   = get_env("UNLIB_COMPILE_BENCH_CXX"  , UNLIB_COMPILE_BENCH_CXX  );
+	const std::string flags = get_env("UNLIB_COMPILE_BENCH_FLAGS", UNLIB_COMPILE_BENCH_FLAGS);
+
+	char dir_template[] = "/tmp/unlib_compile_bench_XXXXXX";
+	const char* const dir = ::mkdtemp(dir_template);
+	if(not dir) {
+		std::perror("mkdtemp");
+		return 1;
+	}
+	const std::string source = std::string(dir) + "/tu.cpp";
+	const std::string object = std::string(dir) + "/tu.o";
+
+	std::vector<result> results;
+	bool ok = true;
+	for(const auto& s : scenarios) {
+		bool selected = filters.empty();
+		for(const char* filter : filters)
+			selected = selected || std::strstr(s.name, filter) != nullptr;
+		if(not selected)
+			continue;
+		for(std::size_t size : s.sized ? sizes : std::vector<std::size_t>{0}) {
+			if(size > s.max_size)
+				continue;
+			std::ofstream(source) << s.generate(size);
+			result r = compile(cxx, flags, source, object);
+			r.scenario = s.name;
+			r.size     = size;
+			ok = ok && r.ok;
+			results.push_back(r);
+			if(not json_to_stdout)
+				std::printf("%-24s %6lu %10.3f s %10ld kB%s\n", r.scenario.c_str(), static_cast<unsigned long>(r.size), r.seconds, r.peak_kb, r.ok ? "" : "  FAILED");
+		}
+	}
+
+	std::remove(source.c_str());
+	std::remove(object.c_str());
+	::rmdir(dir);
+
+	if(json_to_stdout)
+		print_json(stdout, cxx, flags, results);
+	if(json_file) {
+		std::FILE* file = std::fopen(json_file, "w");
+		if(not file) {
+			std::fprintf(stderr, "cannot open %s\n", json_file);
+			return 1;
+		}
+		print_json(file, cxx, flags, results);
+		std::fclose(file);
+	}
+
+	return ok ? 0 : 1;
+}
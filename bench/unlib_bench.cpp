@@ -0,0 +1,139 @@
+#include <unlib/bench/unlib_bench.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace bench {
+
+namespace {
+
+struct registered_benchmark {
+	const char*        name;
+	benchmark_function function;
+};
+
+std::vector<registered_benchmark>& registry() {
+	static std::vector<registered_benchmark> benchmarks;
+	return benchmarks;
+}
+
+}
+
+registrar::registrar(const char* name, benchmark_function function) {
+	registry().push_back(registered_benchmark{name, function});
+}
+
+}
+
+namespace {
+
+std::string json_escape(const std::string& str) {
+	std::string result;
+	for(char c : str) {
+		if(c == '"' || c == '\\')
+			result += '\\';
+		result += c;
+	}
+	return result;
+}
+
+/* ratio of a result's time to that of its benchmark's baseline variant, or 0 */
+double relative_to_baseline(const bench::result& result, const std::vector<bench::result>& results) {
+	for(const auto& other : results)
+		if(other.benchmark == result.benchmark && other.variant.find("(baseline)") != std::string::npos && other.ns_per_item > 0)
+			return result.ns_per_item / other.ns_per_item;
+	return 0;
+}
+
+void print_table(const std::vector<bench::result>& results) {
+	for(const auto& result : results) {
+		const double relative = relative_to_baseline(result, results);
+		if(relative > 0)
+			std::printf("%-32s %-48s %10.3f ns/item  %6.2fx\n", result.benchmark.c_str(), result.variant.c_str(), result.ns_per_item, relative);
+		else
+			std::printf("%-32s %-48s %10.3f ns/item\n"        , result.benchmark.c_str(), result.variant.c_str(), result.ns_per_item);
+	}
+}
+
+void print_json(std::FILE* file, const std::vector<bench::result>& results) {
+	std::fprintf(file, "{\n");
+#if defined(__VERSION__)
+	std::fprintf(file, "  \"compiler\": \"%s\",\n", json_escape(__VERSION__).c_str());
+#endif
+	std::fprintf(file, "  \"cplusplus\": %ld,\n", static_cast<long>(__cplusplus));
+#if defined(NDEBUG)
+	std::fprintf(file, "  \"ndebug\": true,\n");
+#else
+	std::fprintf(file, "  \"ndebug\": false,\n");
+#endif
+	std::fprintf(file, "  \"results\": [");
+	const char* separator = "\n";
+	for(const auto& result : results) {
+		std::fprintf(file, "%s    {\"benchmark\": \"%s\", \"variant\": \"%s\", \"ns_per_item\": %.6g, \"items\": %lu"
+		           , separator, json_escape(result.benchmark).c_str(), json_escape(result.variant).c_str()
+		           , result.ns_per_item, static_cast<unsigned long>(result.items) );
+		const double relative = relative_to_baseline(result, results);
+		if(relative > 0)
+			std::fprintf(file, ", \"relative_to_baseline\": %.6g", relative);
+		std::fprintf(file, "}");
+		separator = ",\n";
+	}
+	std::fprintf(file, "\n  ]\n}\n");
+}
+
+}
+
+/*
+ * Runs all registered benchmarks, or those whose name contains any of the
+ * strings passed on the command line, and prints their results. Results of
+ * variants are also given relative to their benchmark's "(baseline)"
+ * variant, if it has one.
+ *
+ * Options:
+ *   --json         print results as JSON instead of a table
+ *   --json=<file>  additionally write results as JSON to <file>
+ */
+int main(int argc, char* argv[]) {
+	std::vector<bench::result> results;
+	std::vector<const char*>   filters;
+	bool                       json_to_stdout = false;
+	const char*                json_file      = nullptr;
+
+	for(int arg=1; arg<argc; ++arg) {
+		if(std::strcmp(argv[arg], "--json") == 0)
+			json_to_stdout = true;
+		else if(std::strncmp(argv[arg], "--json=", 7) == 0)
+			json_file = argv[arg] + 7;
+		else
+			filters.push_back(argv[arg]);
+	}
+
+	for(const auto& benchmark : bench::registry()) {
+		bool selected = filters.empty();
+		for(const char* filter : filters)
+			selected = selected || std::strstr(benchmark.name, filter) != nullptr;
+		if(not selected)
+			continue;
+		bench::runner runner{benchmark.name, results};
+		benchmark.function(runner);
+	}
+
+	if(json_to_stdout)
+		print_json(stdout, results);
+	else
+		print_table(results);
+
+	if(json_file) {
+		std::FILE* file = std::fopen(json_file, "w");
+		if(not file) {
+			std::fprintf(stderr, "cannot open %s\n", json_file);
+			return 1;
+		}
+		print_json(file, results);
+		std::fclose(file);
+	}
+
+	return 0;
+}
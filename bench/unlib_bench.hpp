@@ -0,0 +1,130 @@
+#ifndef UNLIB_BENCH_UNLIB_BENCH_HPP
+#define UNLIB_BENCH_UNLIB_BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/**
+ * Keeps the optimizer from discarding the computation of a value.
+ */
+template<typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static const volatile void* sink;
+	sink = &value;
+#endif
+}
+
+/**
+ * Keeps the optimizer from assuming memory it cannot see has not changed.
+ */
+inline void clobber_memory() {
+#if defined(__GNUC__)
+	asm volatile("" : : : "memory");
+#endif
+}
+
+/** Creates reproducible random values in [min,max) */
+template<typename V>
+std::vector<V> random_values(std::size_t count, V min, V max) {
+	std::mt19937_64 gen{42};
+	std::vector<V> values(count);
+	for(auto& v : values)
+		v = static_cast<V>(min + static_cast<double>(max-min) * std::generate_canonical<double,53>(gen));
+	return values;
+}
+
+/** Creates quantities of type Q from the given values (@sa random_values()) */
+template<typename Q>
+std::vector<Q> random_quantities(const std::vector<typename Q::value_type>& values) {
+	std::vector<Q> quantities;
+	quantities.reserve(values.size());
+	for(auto v : values)
+		quantities.push_back(Q{v});
+	return quantities;
+}
+
+/** The result of running one benchmark variant */
+struct result {
+	std::string benchmark;
+	std::string    variant;
+	double     ns_per_item;
+	std::size_t      items;
+};
+
+/**
+ * Runs benchmark variants and collects their results
+ */
+class runner {
+public:
+	explicit runner(std::string benchmark, std::vector<result>& results)
+	                                                                    : benchmark_{std::move(benchmark)}, results_{results} {}
+
+	/**
+	 * Measures calls to f, which processes items items per call. The time is
+	 * taken as the best of several samples, each of which runs long enough
+	 * for the clock to be precise.
+	 */
+	template<typename F>
+	void measure(const std::string& variant, std::size_t items, F f) {
+		using clock = std::chrono::steady_clock;
+		f();
+		std::size_t iterations = 1;
+		for(;;) {
+			const auto start = clock::now();
+			for(std::size_t i=0; i<iterations; ++i)
+				f();
+			if(clock::now() - start >= min_sample_time || iterations >= max_iterations)
+				break;
+			iterations *= 2;
+		}
+		double best = 0;
+		for(int sample=0; sample<samples; ++sample) {
+			const auto start = clock::now();
+			for(std::size_t i=0; i<iterations; ++i)
+				f();
+			clobber_memory();
+			const std::chrono::duration<double,std::nano> elapsed = clock::now() - start;
+			const double ns_per_item = elapsed.count() / static_cast<double>(iterations*items);
+			if(sample == 0 || ns_per_item < best)
+				best = ns_per_item;
+		}
+		results_.push_back(result{benchmark_, variant, best, items});
+	}
+
+private:
+	static constexpr int                    samples         = 5;
+	static constexpr std::size_t            max_iterations  = std::size_t{1} << 30;
+	static constexpr std::chrono::milliseconds min_sample_time{20};
+
+	std::string                             benchmark_;
+	std::vector<result>&                    results_;
+};
+
+using benchmark_function = void(*)(runner&);
+
+/** registers a benchmark function to be run by the benchmark executable */
+struct registrar {
+	registrar(const char* name, benchmark_function function);
+};
+
+}
+
+/**
+ * Defines and registers a benchmark. The benchmark's body receives a
+ * bench::runner& named runner, on which it calls measure() for each variant.
+ */
+#define UNLIB_BENCHMARK(Name_)                                                \
+	static void Name_(::bench::runner& runner);                               \
+	static const ::bench::registrar Name_##_registrar{#Name_, &Name_};        \
+	static void Name_(::bench::runner& runner)
+
+#endif // UNLIB_BENCH_UNLIB_BENCH_HPP
@@ -0,0 +1,21 @@
+/*
+ * common_extern.cpp
+ *
+ * Copyright sbi http://stackoverflow.com/users/140719
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *     http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+/* The only translation unit of the optional unlib_common library. It emits
+ * the instantiations that common_extern.hpp declares extern. */
+
+#include <unlib/common.hpp>
+#include <unlib/common_extern.hpp>
+
+#if !UNLIB_EXTERN_COMMON_QUANTITIES
+#	error "unlib_common must be compiled with UNLIB_EXTERN_COMMON_QUANTITIES defined to 1"
+#endif
+
+UNLIB_FOR_EACH_COMMON_QUANTITY_TYPE(UNLIB_INSTANTIATE_QUANTITY_IO, )
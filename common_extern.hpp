@@ -0,0 +1,105 @@
+#ifndef UNLIB_COMMON_EXTERN_HPP
+#define UNLIB_COMMON_EXTERN_HPP
+
+/*
+ * common_extern.hpp
+ *
+ * Copyright sbi http://stackoverflow.com/users/140719
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *     http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+/* Explicit instantiations of the I/O functions for the common quantities.
+ *
+ * Being header-only, every translation unit formatting and parsing the
+ * common quantities instantiates the very same to_string(), to_chars(),
+ * from_chars(), operator<<() and operator>>(). Linking against the optional
+ * unlib_common library (built from common_extern.cpp) defines
+ * UNLIB_EXTERN_COMMON_QUANTITIES, which makes common.hpp include this header.
+ * It then declares these instantiations as extern, so that they are only
+ * emitted once, into the library.
+ *
+ * Only quantities with the value types double and long are covered, and
+ * only when UNLIB_EXTERN_COMMON_QUANTITIES is defined to the same value
+ * for the library and all its users. Any other quantity is still
+ * instantiated implicitly, as usual.
+ *
+ * @note get_quantity_c_str() and get_quantity_string() are not covered.
+ *       The former deduces its return type, which (per the standard) cannot
+ *       be suppressed by an explicit instantiation declaration, and the
+ *       latter is merely a wrapper around the former.
+ */
+
+#include <iosfwd>
+#include <string>
+
+#include <unlib/quantity_io.hpp>
+#include <unlib/quantity_stream.hpp>
+#include <unlib/common_units.hpp>
+
+/**
+ * @{
+ * Invokes Macro_(Arg_, Q) for every common quantity Q with value type V_
+ *
+ * @note Every quantity type must only appear once. Aliases resolving to the
+ *       same type as another entry (e.g. milliliter and cubic_centimeter)
+ *       must not be listed.
+ */
+#define UNLIB_FOR_EACH_COMMON_QUANTITY(Macro_, Arg_, V_) \
+	Macro_(Arg_, unlib::second<V_>)                      \
+	Macro_(Arg_, unlib::milli<unlib::second<V_>>)        \
+	Macro_(Arg_, unlib::minute<V_>)                      \
+	Macro_(Arg_, unlib::hour<V_>)                        \
+	Macro_(Arg_, unlib::day<V_>)                         \
+	Macro_(Arg_, unlib::gram<V_>)                        \
+	Macro_(Arg_, unlib::kilo<unlib::gram<V_>>)           \
+	Macro_(Arg_, unlib::meter<V_>)                       \
+	Macro_(Arg_, unlib::kilo<unlib::meter<V_>>)          \
+	Macro_(Arg_, unlib::liter<V_>)                       \
+	Macro_(Arg_, unlib::degree_kelvin<V_>)               \
+	Macro_(Arg_, unlib::degree_celsius<V_>)              \
+	Macro_(Arg_, unlib::hertz<V_>)                       \
+	Macro_(Arg_, unlib::ampere<V_>)                      \
+	Macro_(Arg_, unlib::milli<unlib::ampere<V_>>)        \
+	Macro_(Arg_, unlib::volt<V_>)                        \
+	Macro_(Arg_, unlib::kilo<unlib::volt<V_>>)           \
+	Macro_(Arg_, unlib::ohm<V_>)                         \
+	Macro_(Arg_, unlib::watt<V_>)                        \
+	Macro_(Arg_, unlib::kilo<unlib::watt<V_>>)           \
+	Macro_(Arg_, unlib::mega<unlib::watt<V_>>)           \
+	Macro_(Arg_, unlib::var<V_>)                         \
+	Macro_(Arg_, unlib::kilo<unlib::var<V_>>)            \
+	Macro_(Arg_, unlib::voltampere<V_>)                  \
+	Macro_(Arg_, unlib::kilo<unlib::voltampere<V_>>)     \
+	Macro_(Arg_, unlib::watt_hour<V_>)                   \
+	Macro_(Arg_, unlib::kilo<unlib::watt_hour<V_>>)      \
+	Macro_(Arg_, unlib::mega<unlib::watt_hour<V_>>)      \
+	Macro_(Arg_, unlib::var_hour<V_>)                    \
+	Macro_(Arg_, unlib::kilo<unlib::var_hour<V_>>)       \
+	Macro_(Arg_, unlib::voltampere_hour<V_>)             \
+	Macro_(Arg_, unlib::kilo<unlib::voltampere_hour<V_>>)\
+	Macro_(Arg_, unlib::ampere_hour<V_>)
+
+#define UNLIB_FOR_EACH_COMMON_QUANTITY_TYPE(Macro_, Arg_) \
+	UNLIB_FOR_EACH_COMMON_QUANTITY(Macro_, Arg_, double)  \
+	UNLIB_FOR_EACH_COMMON_QUANTITY(Macro_, Arg_, long  )
+/** @} */
+
+/**
+ * Declares (Extern_ being extern) or defines (Extern_ being empty) the
+ * explicit instantiations of the I/O functions for quantity Q_
+ */
+#define UNLIB_INSTANTIATE_QUANTITY_IO(Extern_, Q_)                                                          \
+	Extern_ template std::string              unlib::to_string (                                   const Q_&); \
+	Extern_ template unlib::to_chars_result   unlib::to_chars  (char*      , char*      ,          const Q_&); \
+	Extern_ template unlib::from_chars_result unlib::from_chars(const char*, const char*,                Q_&); \
+	Extern_ template std::ostream&            unlib::operator<<(std::ostream&,                     const Q_&); \
+	Extern_ template std::istream&            unlib::operator>>(std::istream&,                           Q_&);
+
+#if UNLIB_EXTERN_COMMON_QUANTITIES
+UNLIB_FOR_EACH_COMMON_QUANTITY_TYPE(UNLIB_INSTANTIATE_QUANTITY_IO, extern)
+#endif
+
+#endif /* UNLIB_COMMON_EXTERN_HPP */
@@ -0,0 +1,180 @@
+#ifndef UNLIB_COMMON_LITERAL_TRAITS_HPP
+#define UNLIB_COMMON_LITERAL_TRAITS_HPP
+
+/*
+ * common_literal_traits.hpp
+ *
+ * Copyright sbi http://stackoverflow.com/users/140719
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *     http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <unlib/quantity.hpp>
+#include <unlib/quantity_io.hpp>
+#include <unlib/common_units.hpp>
+
+namespace unlib {
+
+/** @{
+ *
+ * Macros to define strings for units
+ *
+ * These macros allow fine-tuning the unit string which can be obtained by
+ * calling @sa get_unit_string() on a common quantity.
+ *
+ * Users should not need to extend the scaling prefixes, but might want to
+ * use @sa UNLIB_DEFINE_UNIT_LITERAL_TRAITS() to define strings for their
+ * own units.
+ *
+ * For quantities with non-regular scaling (minutes, cubic kilometers),
+ * @sa UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE() can be used. This can also be
+ * used if a units is not explicitly defined (meter_per_second).
+ *
+ * Finally, @sa UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_SCALED() can be used for
+ * quantities where some particular scalings are named irregularly (tons).
+ *
+ * @param     Scale_  Scale (e.g., kilo)
+ * @param PrefixStr_  Scale prefix string (e.g., k)
+ * @param   UnitStr_  Unit string (e.g., m)
+ * @param       Qty_  Quantity (e.g., meter)
+ * @param    QtyStr_  Quantity string (e.g., km)
+ *
+ * @note All of these _must_ be used within the namespace unlib::literals.
+ */
+#define UNLIB_DEFINE_SCALE_LITERAL_TRAITS(Scale_,PrefixStr_)              namespace literals {                                                                 \
+	                                                                          template<>                                                                       \
+	                                                                          struct scaling_traits<Scale_> {                                                  \
+		                                                                          using is_specialized = std::true_type;                                       \
+		                                                                          static constexpr const auto& get_string() {return PrefixStr_;}               \
+	                                                                          };                                                                               \
+                                                                          }
+
+#define UNLIB_DEFINE_UNIT_LITERAL_TRAITS(Unit_,Tag_,UnitStr_)             namespace literals {                                                                 \
+	                                                                          template<>                                                                       \
+	                                                                          struct unit_traits<Unit_,Tag_> {                                                 \
+		                                                                           using is_specialized = std::true_type;                                      \
+		                                                                           static constexpr const auto& get_string() {return UnitStr_  ;}              \
+	                                                                          };                                                                               \
+                                                                          }
+#define UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(Qty_,QtyStr_)        namespace literals {                                                                 \
+	                                                                          template<>                                                                       \
+	                                                                          struct quantity_traits<Qty_<literals::integer_value_type>:: unit_type            \
+	                                                                                                ,Qty_<literals::integer_value_type>::scale_type            \
+	                                                                                                ,Qty_<literals::integer_value_type>::  tag_type> {         \
+		                                                                          using is_specialized = std::true_type;                                       \
+		                                                                          static constexpr const auto& get_string() {return QtyStr_   ;}               \
+	                                                                          };                                                                               \
+                                                                          }
+#define UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_SCALED(Scale_,Qty_,QtyStr_)  namespace literals {                                                                 \
+	                                                                          template<>                                                                       \
+	                                                                          struct quantity_traits<Scale_<Qty_<literals::integer_value_type>>:: unit_type    \
+	                                                                                                ,Scale_<Qty_<literals::integer_value_type>>::scale_type    \
+	                                                                                                ,Scale_<Qty_<literals::integer_value_type>>::  tag_type> { \
+		                                                                          using is_specialized = std::true_type;                                       \
+		                                                                          static constexpr const auto& get_string() {return QtyStr_   ;}               \
+	                                                                          };                                                                               \
+                                                                          }
+/** @} */
+
+/** define strings for the ISO scaling prefixes */
+UNLIB_DEFINE_SCALE_LITERAL_TRAITS( atto_scaling,  "a")
+UNLIB_DEFINE_SCALE_LITERAL_TRAITS(femto_scaling,  "f")
+UNLIB_DEFINE_SCALE_LITERAL_TRAITS( pico_scaling,  "p")
+UNLIB_DEFINE_SCALE_LITERAL_TRAITS( nano_scaling,  "n")
+UNLIB_DEFINE_SCALE_LITERAL_TRAITS(micro_scaling,  "u")
+UNLIB_DEFINE_SCALE_LITERAL_TRAITS(milli_scaling,  "m")
+UNLIB_DEFINE_SCALE_LITERAL_TRAITS(centi_scaling,  "c")
+UNLIB_DEFINE_SCALE_LITERAL_TRAITS( deci_scaling,  "d")
+UNLIB_DEFINE_SCALE_LITERAL_TRAITS(   no_scaling,   "")
+UNLIB_DEFINE_SCALE_LITERAL_TRAITS( deca_scaling, "dk")
+UNLIB_DEFINE_SCALE_LITERAL_TRAITS(hecto_scaling,  "h")
+UNLIB_DEFINE_SCALE_LITERAL_TRAITS( kilo_scaling,  "k")
+UNLIB_DEFINE_SCALE_LITERAL_TRAITS( mega_scaling,  "M")
+UNLIB_DEFINE_SCALE_LITERAL_TRAITS( giga_scaling,  "G")
+UNLIB_DEFINE_SCALE_LITERAL_TRAITS( tera_scaling,  "T")
+//UNLIB_DEFINE_SCALE_LITERAL_TRAITS(peta , P)
+//UNLIB_DEFINE_SCALE_LITERAL_TRAITS(exa  , E)
+/** @} */
+
+/** define strings for commonly used units  */
+UNLIB_DEFINE_UNIT_LITERAL_TRAITS(time           ,             no_tag, "s"   )
+UNLIB_DEFINE_UNIT_LITERAL_TRAITS(mass           ,             no_tag, "g"   )
+UNLIB_DEFINE_UNIT_LITERAL_TRAITS(length         ,             no_tag, "m"   )
+UNLIB_DEFINE_UNIT_LITERAL_TRAITS(area           ,             no_tag, "m2"  )
+UNLIB_DEFINE_UNIT_LITERAL_TRAITS(volume         ,             no_tag, "m3"  )
+UNLIB_DEFINE_UNIT_LITERAL_TRAITS(frequency      ,             no_tag, "Hz"  )
+UNLIB_DEFINE_UNIT_LITERAL_TRAITS(current        ,             no_tag, "A"   )
+UNLIB_DEFINE_UNIT_LITERAL_TRAITS(voltage        ,             no_tag, "V"   )
+UNLIB_DEFINE_UNIT_LITERAL_TRAITS(resistance     ,             no_tag, "O"   )
+
+UNLIB_DEFINE_UNIT_LITERAL_TRAITS(power          ,             no_tag, "W"   )
+UNLIB_DEFINE_UNIT_LITERAL_TRAITS(power          , reactive_power_tag, "VAr" )
+UNLIB_DEFINE_UNIT_LITERAL_TRAITS(power          , apparent_power_tag, "VA"  )
+UNLIB_DEFINE_UNIT_LITERAL_TRAITS(energy         ,          joule_tag, "J"   )
+UNLIB_DEFINE_UNIT_LITERAL_TRAITS(energy         ,             no_tag, "Ws"  )
+UNLIB_DEFINE_UNIT_LITERAL_TRAITS(energy         , reactive_power_tag, "VArs")
+UNLIB_DEFINE_UNIT_LITERAL_TRAITS(energy         , apparent_power_tag, "VAs" )
+UNLIB_DEFINE_UNIT_LITERAL_TRAITS(electric_charge,             no_tag, "As"  )
+UNLIB_DEFINE_UNIT_LITERAL_TRAITS(pressure       ,             no_tag, "Pa"  )
+/** @} */
+
+/** define strings for commonly used quantities  */
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(       minute              ,  "min" )
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(         hour              ,  "h"   )
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(          day              ,  "d"   )
+
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(       ton                 ,    "t" )
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_SCALED (kilo , ton                 ,   "kt" )
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_SCALED (mega , ton                 ,   "Mt" )
+
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(       square_millimeter   ,  "mm2" )
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(       square_centimeter   ,  "cm2" )
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(        square_kilometer   ,  "km2" )
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(                 hectare   ,   "ha" )
+
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(        cubic_millimeter   ,  "mm3" )
+//UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(        cubic_centimeter   ,  "cm3" ) // alias of ml
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(         cubic_kilometer   ,  "km3" )
+
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(              milliliter   ,   "ml" )
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(                   liter   ,    "l" )
+
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(       degree_kelvin       ,    "K" )
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(       degree_celsius      ,    "C" )
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(       degree_fahrenheit   ,    "F" )
+
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(       joule               ,    "J" )
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(             watt_hour     ,    "Wh")
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_SCALED (kilo ,       watt_hour     ,   "kWh")
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_SCALED (mega ,       watt_hour     ,   "MWh")
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_SCALED (giga ,       watt_hour     ,   "GWh")
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(              var_hour     ,  "VArh")
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_SCALED (kilo ,        var_hour     , "kVArh")
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_SCALED (mega ,        var_hour     , "MVArh")
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_SCALED (giga ,        var_hour     , "GVArh")
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(       voltampere_hour     ,   "VAh")
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_SCALED (kilo , voltampere_hour     ,  "kVAh")
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_SCALED (mega , voltampere_hour     ,  "MVAh")
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_SCALED (giga , voltampere_hour     ,  "GVAh")
+
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(           ampere_hour     ,    "Ah")
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_SCALED (kilo ,     ampere_hour     ,   "kAh")
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_SCALED (mega ,     ampere_hour     ,   "MAh")
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_SCALED (giga ,     ampere_hour     ,   "GAh")
+
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(       percent             ,    "%" )
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(       permill             ,    "" ) //"‰"
+
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(       bar                 ,   "bar")
+
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(           meter_per_second,   "m/s")
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(       kilometer_per_hour  ,  "km/h")
+
+UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS_NOSCALE(       liter_per_hour      ,   "l/h")
+/** @} */
+
+}
+
+#endif /* UNLIB_COMMON_LITERAL_TRAITS_HPP */
@@ -0,0 +1,116 @@
+#ifndef UNLIB_COMMON_LITERALS_HPP
+#define UNLIB_COMMON_LITERALS_HPP
+
+/*
+ * common_literals.hpp
+ *
+ * Copyright sbi http://stackoverflow.com/users/140719
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *     http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <unlib/quantity.hpp>
+#include <unlib/common_units.hpp>
+
+namespace unlib {
+
+/** @{
+ *
+ * Macros to define literal operators for units and for their prefixed versions
+ *
+ * @param       Qty_  Quantity (e.g., meter)
+ * @param        Sc_  Scale (e.g., kilo)
+ * @param UnitShort_  Unit's short name (e.g., km)
+ * @param       OpT_  Operand type for literal operator (e.g., unsigned long long or long double)
+ * @param         R_  Return type of literal operator (e.g., long long or double)
+ */
+/** defines a literal operator; do not call this directly */
+#define UNLIB_DEFINE_LITERAL_OPERATOR(Qty_,Sc_,UnitShort_,OpT_, R_)       inline constexpr auto operator""_##UnitShort_(OpT_ v) noexcept {return Sc_<Qty_<R_>>{static_cast<R_>(v)};}
+/** defines a set of literal operators for a unit return double and long long */
+#define UNLIB_DEFINE_SCALED_LITERAL(Qty_,Sc_,UnitShort_)                  namespace literals {                                                                          \
+	                                                                          UNLIB_DEFINE_LITERAL_OPERATOR(Qty_,Sc_,UnitShort_,long double       , floatpt_value_type) \
+	                                                                          UNLIB_DEFINE_LITERAL_OPERATOR(Qty_,Sc_,UnitShort_,unsigned long long, integer_value_type) \
+                                                                          }
+/** define the literal operators for all the micro unit prefixes (atto-deci) */
+#define UNLIB_DEFINE_METRIC_MICRO_PREFIXED_LITERAL(Qty_,UnitShort_)       UNLIB_DEFINE_SCALED_LITERAL(Qty_,atto , a##UnitShort_) \
+                                                                          UNLIB_DEFINE_SCALED_LITERAL(Qty_,femto, f##UnitShort_) \
+                                                                          UNLIB_DEFINE_SCALED_LITERAL(Qty_,pico , p##UnitShort_) \
+                                                                          UNLIB_DEFINE_SCALED_LITERAL(Qty_,nano , n##UnitShort_) \
+                                                                          UNLIB_DEFINE_SCALED_LITERAL(Qty_,micro, u##UnitShort_) \
+                                                                          UNLIB_DEFINE_SCALED_LITERAL(Qty_,milli, m##UnitShort_) \
+                                                                          UNLIB_DEFINE_SCALED_LITERAL(Qty_,centi, c##UnitShort_) \
+                                                                          UNLIB_DEFINE_SCALED_LITERAL(Qty_,deci , d##UnitShort_)
+/** define the literal operators for all the macro unit prefixes (deca-tera) */
+#define UNLIB_DEFINE_METRIC_MACRO_PREFIXED_LITERAL(Qty_,UnitShort_)       UNLIB_DEFINE_SCALED_LITERAL(Qty_,deca ,dk##UnitShort_) \
+                                                                          UNLIB_DEFINE_SCALED_LITERAL(Qty_,hecto, h##UnitShort_) \
+                                                                          UNLIB_DEFINE_SCALED_LITERAL(Qty_,kilo , k##UnitShort_) \
+                                                                          UNLIB_DEFINE_SCALED_LITERAL(Qty_,mega , M##UnitShort_) \
+                                                                          UNLIB_DEFINE_SCALED_LITERAL(Qty_,giga , G##UnitShort_) \
+                                                                          UNLIB_DEFINE_SCALED_LITERAL(Qty_,tera , T##UnitShort_)
+                                                                        //UNLIB_DEFINE_SCALED_LITERAL(Qty_,peta , P##UnitShort_)
+                                                                        //UNLIB_DEFINE_SCALED_LITERAL(Qty_,exa  , E##UnitShort_)
+/** define the literal operators for all unit prefixes (atto-tera) */
+#define UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(Qty_,UnitShort_)            UNLIB_DEFINE_METRIC_MICRO_PREFIXED_LITERAL(Qty_,UnitShort_) \
+                                                                          UNLIB_DEFINE_METRIC_MACRO_PREFIXED_LITERAL(Qty_,UnitShort_)
+/** define the literal operators for a physical unit (nor prefixes) */
+#define UNLIB_DEFINE_LITERAL(Qty_,UnitShort_)                             UNLIB_DEFINE_SCALED_LITERAL(Qty_,no_scale,UnitShort_)
+/** @} */
+
+UNLIB_DEFINE_LITERAL(second, s   )                    UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(second, s)
+UNLIB_DEFINE_LITERAL(minute, min )
+UNLIB_DEFINE_LITERAL(  hour, h   )
+UNLIB_DEFINE_LITERAL(   day, d   )
+UNLIB_DEFINE_LITERAL(  week, week)
+
+UNLIB_DEFINE_LITERAL(gram, g)                         UNLIB_DEFINE_METRIC_PREFIXED_LITERALS     (gram, g)
+UNLIB_DEFINE_LITERAL( ton, t)                         UNLIB_DEFINE_METRIC_MACRO_PREFIXED_LITERAL(ton, t)
+
+UNLIB_DEFINE_LITERAL(meter, m)                        UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(meter, m)
+
+UNLIB_DEFINE_LITERAL(square_millimeter, mm2)
+UNLIB_DEFINE_LITERAL(square_centimeter, cm2)
+UNLIB_DEFINE_LITERAL(     square_meter,  m2)
+UNLIB_DEFINE_LITERAL( square_kilometer, km2)
+UNLIB_DEFINE_LITERAL(          hectare,  ha)
+
+UNLIB_DEFINE_LITERAL( cubic_millimeter, mm3)
+UNLIB_DEFINE_LITERAL( cubic_centimeter, cm3)
+UNLIB_DEFINE_LITERAL(      cubic_meter,  m3)
+UNLIB_DEFINE_LITERAL(  cubic_kilometer, km3)
+UNLIB_DEFINE_LITERAL(       milliliter,  ml)
+UNLIB_DEFINE_LITERAL(            liter,   l)
+
+UNLIB_DEFINE_LITERAL(hertz, Hz)                       UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(hertz, Hz)
+
+UNLIB_DEFINE_LITERAL(ampere, A)                       UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(ampere, A)
+UNLIB_DEFINE_LITERAL(  volt, V)                       UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(volt  , V)
+UNLIB_DEFINE_LITERAL(   ohm, O)                       UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(ohm   , O)
+
+UNLIB_DEFINE_LITERAL(      watt, W  )                 UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(watt      , W  )
+UNLIB_DEFINE_LITERAL(       var, VAr)                 UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(var       , VAr)
+UNLIB_DEFINE_LITERAL(voltampere, VA )                 UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(voltampere, VA )
+
+UNLIB_DEFINE_LITERAL(            joule, J   )         UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(      joule      , J   )
+UNLIB_DEFINE_LITERAL(      watt_second, Ws  )         UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(      watt_second, Ws  )
+UNLIB_DEFINE_LITERAL(      watt_hour  , Wh  )         UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(      watt_hour  , Wh  )
+UNLIB_DEFINE_LITERAL(       var_second, VArs)         UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(       var_second, VArs)
+UNLIB_DEFINE_LITERAL(       var_hour  , VArh)         UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(       var_hour  , VArh)
+UNLIB_DEFINE_LITERAL(voltampere_second, VAs )         UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(voltampere_second, VAs )
+UNLIB_DEFINE_LITERAL(voltampere_hour  , VAh )         UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(voltampere_hour  , VAh )
+
+UNLIB_DEFINE_LITERAL(ampere_second, As)               UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(ampere_second, As)
+UNLIB_DEFINE_LITERAL(ampere_hour  , Ah)               UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(ampere_hour  , Ah)
+
+UNLIB_DEFINE_LITERAL(pascal_, Pa )                    UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(pascal_, Pa )
+UNLIB_DEFINE_LITERAL(bar    , bar)                    UNLIB_DEFINE_METRIC_PREFIXED_LITERALS(bar    , bar)
+
+UNLIB_DEFINE_LITERAL(    meter_per_second, m_per_s )
+UNLIB_DEFINE_LITERAL(kilometer_per_hour  , km_per_h)
+
+UNLIB_DEFINE_LITERAL(liter_per_hour, l_per_h)
+
+}
+
+#endif /* UNLIB_COMMON_LITERALS_HPP */
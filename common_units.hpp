@@ -0,0 +1,267 @@
+#ifndef UNLIB_COMMON_UNITS_HPP
+#define UNLIB_COMMON_UNITS_HPP
+
+/*
+ * common_units.hpp
+ *
+ * Copyright sbi http://stackoverflow.com/users/140719
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *     http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <unlib/quantity_fwd.hpp>
+
+/*
+ * This defines common units and quantities. It only needs quantities to be
+ * declared, so including this is enough to name common quantity types. For
+ * using them, quantity.hpp needs to be included, too. Literal operators and
+ * unit strings for these are defined in common_literals.hpp and
+ * common_literal_traits.hpp. Including common.hpp includes all of these.
+ */
+
+namespace unlib {
+
+/** @{
+ * @brief some common physical units derived from the seven base units
+ *
+ * This defines a few derived physical units. They can be used to declare
+ * templates which refer to a quantity of some unit at any scale.
+ *
+ * @code
+ * template<typename Scale>
+ * void f(unlib::quantity<unlib::velocity, Scale, double, void>);
+ *
+ */
+using            frequency = reciprocal_unit_t< time >;
+using             velocity =        div_unit_t< length , time >;
+using                 area =     square_unit_t< length >;
+using               volume =       cube_unit_t< length >;
+using             pressure =        div_unit_t< mass   , mul_unit_t<length, square_unit_t<time>> >;
+
+using              voltage =        div_unit_t< mul_unit_t<mass   , square_unit_t<length>>
+                                              , mul_unit_t<current,   cube_unit_t<time  >> >;
+using                power =        mul_unit_t< current, voltage >;
+using               energy =        mul_unit_t< power  , time    >;
+using      electric_charge =        mul_unit_t< current, time    >;
+using           resistance =        div_unit_t< voltage, current >;
+using volumetric_flow_rate =        div_unit_t< volume , time    >;
+/** @} */
+
+#if !defined(UNLIB_LITERAL_OPERATOR_INTEGER_VALUE_TYPE)
+#   define UNLIB_LITERAL_OPERATOR_INTEGER_VALUE_TYPE  long
+#endif
+#if !defined(UNLIB_LITERAL_OPERATOR_FLOATPT_VALUE_TYPE)
+#   define UNLIB_LITERAL_OPERATOR_FLOATPT_VALUE_TYPE  double
+#endif
+
+namespace literals {
+using integer_value_type = UNLIB_LITERAL_OPERATOR_INTEGER_VALUE_TYPE; /**< value type of quantity return by integer literal operator */
+using floatpt_value_type = UNLIB_LITERAL_OPERATOR_FLOATPT_VALUE_TYPE; /**< value type of quantity return by float   literal operator */
+}
+
+
+
+/**
+ * @{
+ *
+ * time quantities
+ *
+ * @tparam V  value type
+ */
+template<typename V> using   second = quantity<time, no_scaling, V>;
+template<typename V> using   minute = minute_scale<second<V>>;
+template<typename V> using     hour =   hour_scale<second<V>>;
+template<typename V> using      day =    day_scale<second<V>>;
+template<typename V> using     week =   week_scale<second<V>>;
+/** @} */
+
+/**
+ * @{
+ *
+ * mass quantities
+ *
+ * @tparam V  value type
+ */
+template<typename V> using     gram = quantity<mass, no_scaling, V>;
+template<typename V> using      ton = to_mega<gram<V>>;
+/** @} */
+
+/**
+ * @{
+ *
+ * length quantities
+ *
+ * @tparam V  value type
+ */
+template<typename V> using    meter = quantity<length, no_scaling, V>;
+/** @} */
+
+/**
+ * @{
+ *
+ * area quantities
+ *
+ * @tparam V  value type
+ */
+template<typename V> using  square_millimeter = quantity<area, micro_scaling, V>;
+template<typename V> using  square_centimeter = quantity<area, std::ratio<1,10000>, V>;
+template<typename V> using       square_meter = quantity<area,    no_scaling, V>;
+template<typename V> using   square_kilometer = quantity<area,  mega_scaling, V>;
+template<typename V> using                are = quantity<area, std::ratio<100,1>, V>;
+template<typename V> using            hectare = quantity<area, std::ratio<10000,1>, V>;
+/** @} */
+
+/**
+ * @{
+ *
+ * volume quantities
+ *
+ * @tparam V  value type
+ */
+template<typename V> using   cubic_millimeter = quantity<volume,  nano_scaling, V>;
+template<typename V> using   cubic_centimeter = quantity<volume, micro_scaling, V>;
+template<typename V> using   cubic_meter      = quantity<volume,    no_scaling, V>;
+template<typename V> using   cubic_kilometer  = quantity<volume,  giga_scaling, V>;
+template<typename V> using         milliliter = cubic_centimeter<V>;
+template<typename V> using              liter = quantity<volume, milli_scaling, V>;
+/** @} */
+
+/**
+ * @{
+ *
+ * temperature quantities
+ *
+ * @tparam V  value type
+ */
+using    celsius_tag = tag_t<struct    celsius_tag_id>;
+using fahrenheit_tag = tag_t<struct fahrenheit_tag_id>;
+template<typename V> using  degree_kelvin     = quantity<temperature, no_scaling     , V>;
+template<typename V> using  degree_celsius    = quantity<temperature, no_scaling     , V,    celsius_tag>;
+template<typename V> using  degree_fahrenheit = quantity<temperature, std::ratio<5,9>, V, fahrenheit_tag>;
+/** @} */
+
+/**
+ * @{
+ *
+ * frequency quantities
+ *
+ * @tparam V  value type
+ */
+template<typename V> using    hertz = quantity<frequency, no_scaling, V>;
+/** @} */
+
+/**
+ * @{
+ *
+ * electrical quantities
+ *
+ * @tparam V  value type
+ */
+template<typename V> using     ampere = quantity<current   , no_scaling, V>;
+template<typename V> using       volt = quantity<voltage   , no_scaling, V>;
+template<typename V> using        ohm = quantity<resistance, no_scaling, V>;
+/** @} */
+
+/**
+ * @{
+ *
+ * power quantities
+ *
+ * @tparam V  value type
+ */
+using reactive_power_tag = tag_t<struct reactive_power_tag_id>;
+using apparent_power_tag = tag_t<struct apparent_power_tag_id>;
+template<typename V> using       watt = quantity<power, no_scaling, V>;
+template<typename V> using        var = quantity<power, no_scaling, V, reactive_power_tag>;
+template<typename V> using voltampere = quantity<power, no_scaling, V, apparent_power_tag>;
+/** @} */
+
+/**
+ * @{
+ *
+ * energy quantities
+ *
+ * @tparam V  value type
+ */
+using joule_tag = tag_t<struct jule_tag_id>;
+template<typename V> using             joule = quantity<energy, no_scaling, V, joule_tag>;
+
+template<typename V> using       watt_second = quantity<energy, no_scaling, V>;
+template<typename V> using       watt_hour   = scale_to_t<hour_scaling,       watt_second<V>>;
+
+template<typename V> using        var_second = quantity<energy, no_scaling, V, reactive_power_tag>;
+template<typename V> using        var_hour   = scale_to_t<hour_scaling,        var_second<V>>;
+
+template<typename V> using voltampere_second = quantity<energy, no_scaling, V, apparent_power_tag>;
+template<typename V> using voltampere_hour   = scale_to_t<hour_scaling, voltampere_second<V>>;
+/** @} */
+
+/**
+ * @{
+ *
+ * electric charge quantities
+ *
+ * @tparam V  value type
+ */
+template<typename V> using ampere_second = quantity<electric_charge, no_scaling, V>;
+template<typename V> using ampere_hour   = hour_scale<ampere_second<V>>;
+/** @} */
+
+/**
+ * @{
+ *
+ * pressure quantities
+ *
+ * @tparam V  value type
+ *
+ * @note Sadly, `pascal` is a keyword/macro on Windows; hence `pascal_`.
+ */
+template<typename V> using pascal_ = quantity<pressure, no_scaling   , V>;
+template<typename V> using     bar = quantity<pressure, scale_t<100000>, V>;
+/** @} */
+
+/**
+ * @{
+ *
+ * velocity quantities
+ *
+ * @tparam V  value type
+ */
+template<typename V> using     meter_per_second = div_quantity_t<meter<V>, second<V>>;
+template<typename V> using kilometer_per_hour   = div_quantity_t<to_kilo<meter<V>>, hour<V>>;
+/** @} */
+
+/**
+ * @{
+ *
+ * volumetric flow rate
+ *
+ * @tparam V  value type
+ */
+template<typename V> using       liter_per_hour = div_quantity_t<liter<V>, hour<V>>;
+/** @} */
+
+/**
+ * @{
+ *
+ * @brief scalar quantities
+ *
+ * Scalars are quantities with a dimensionless unit. The offer little
+ * advantage over a plain value type when untagged, so they should always
+ * have a tag.
+ *
+ * @tparam V  value type
+ * @tparam T  tag
+ * @tparam S  scale
+ */
+template<typename V, typename T       , typename S=scale_t<1>> using scalar   = quantity<dimensionless, S, V, T>;
+template<typename V, typename T=no_tag, typename S=scale_t<1>> using fraction = scalar<V, T, S>;
+template<typename V, typename T=no_tag>                        using percent  = scalar<V, T, centi_scaling>;
+template<typename V, typename T=no_tag>                        using permill  = scalar<V, T, milli_scaling>;
+/** @} */
+
+}
+
+#endif /* UNLIB_COMMON_UNITS_HPP */
@@ -0,0 +1,427 @@
+#ifndef UNLIB_DYNAMIC_QUANTITY_HPP
+#define UNLIB_DYNAMIC_QUANTITY_HPP
+
+/*
+ * dynamic_quantity.hpp
+ *
+ * Copyright sbi http://stackoverflow.com/users/140719
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *     http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include <unlib/quantity.hpp>
+#include <unlib/common_units.hpp>
+
+namespace unlib {
+
+/**
+ * @brief Error thrown by operations on dynamic quantities with incompatible units
+ */
+class dimension_error : public std::runtime_error {
+public:
+	using std::runtime_error::runtime_error;
+};
+
+/**
+ * Specializations of this template assign the ids used by dynamic quantities
+ * to tags. Ids must be unique and nonzero (zero denotes "no tag"). Ids 1-31
+ * are reserved for the library.
+ *
+ * @note Use the @sa UNLIB_DEFINE_DYNAMIC_TAG_ID() macro to define
+ *       specializations.
+ *
+ * @tparam TagID  the ID type of a tag (tag::id)
+ */
+template<typename TagID>
+struct dynamic_tag_id;
+
+#define UNLIB_DEFINE_DYNAMIC_TAG_ID(Tag_,Id_)                            template<>                                                                       \
+	                                                                          struct dynamic_tag_id<Tag_::id> {                                                \
+		                                                                          static_assert(Id_ > 0 and Id_ < 256, "dynamic tag ids must be in [1,255]"); \
+		                                                                          static constexpr std::uint8_t value = Id_;                                   \
+	                                                                          };
+
+UNLIB_DEFINE_DYNAMIC_TAG_ID(       celsius_tag, 1)
+UNLIB_DEFINE_DYNAMIC_TAG_ID(    fahrenheit_tag, 2)
+UNLIB_DEFINE_DYNAMIC_TAG_ID(reactive_power_tag, 3)
+UNLIB_DEFINE_DYNAMIC_TAG_ID(apparent_power_tag, 4)
+UNLIB_DEFINE_DYNAMIC_TAG_ID(         joule_tag, 5)
+
+namespace detail {
+
+/*
+ * Dynamic units are stored as two words of eight signed 8 bit lanes each, so
+ * that multiplying and dividing units boils down to adding and subtracting
+ * lanes, which is done for all lanes at once (SWAR).
+ */
+constexpr std::uint64_t lane_high_bits = 0x8080808080808080u;
+
+constexpr std::uint64_t lane(int value, std::size_t idx)                  {return std::uint64_t{static_cast<std::uint8_t>(value)} << (8*idx);}
+constexpr int           get_lane(std::uint64_t word, std::size_t idx)     {return static_cast<std::int8_t>(static_cast<std::uint8_t>(word >> (8*idx)));}
+
+constexpr std::uint64_t lanes_add(std::uint64_t a, std::uint64_t b)      {return ((a & ~lane_high_bits) + (b & ~lane_high_bits)) ^ ((a ^ b) & lane_high_bits);}
+constexpr std::uint64_t lanes_sub(std::uint64_t a, std::uint64_t b)      {return ((a | lane_high_bits) - (b & ~lane_high_bits)) ^ ((a ^ ~b) & lane_high_bits);}
+/* lanes that overflowed in an addition/subtraction resulting in r */
+constexpr std::uint64_t lanes_add_overflow(std::uint64_t a, std::uint64_t b, std::uint64_t r)
+                                                                          {return ~(a ^ b) & (a ^ r) & lane_high_bits;}
+constexpr std::uint64_t lanes_sub_overflow(std::uint64_t a, std::uint64_t b, std::uint64_t r)
+                                                                          {return  (a ^ b) & (a ^ r) & lane_high_bits;}
+
+/* the primes scales are factored into */
+constexpr std::intmax_t scale_prime(std::size_t idx) {
+	return idx==0 ?  2 : idx==1 ?  3 : idx==2 ?  5 : idx==3 ? 7
+	     : idx==4 ? 11 : idx==5 ? 13 :               17;
+}
+
+constexpr std::size_t scale_primes = 7;
+constexpr std::size_t tag_lane     = 7;
+
+constexpr std::uint64_t tag_lane_mask = lane(-1, tag_lane);
+
+/* unit and tag exponents are stored as multiples of 1/exponent_denominator */
+constexpr int exponent_denominator = 12;
+
+constexpr int pack_exponent(std::intmax_t num, std::intmax_t den, int denominator) {
+	return (num*denominator) % den != 0 or (num*denominator)/den < -128 or (num*denominator)/den > 127
+	     ? throw std::domain_error("exponent cannot be represented by dynamic_unit")
+	     : static_cast<int>((num*denominator)/den);
+}
+
+constexpr std::uint64_t pack_scale(std::intmax_t num, std::intmax_t den) {
+	std::uint64_t word = 0;
+	for(std::size_t idx=0; idx<scale_primes; ++idx) {
+		const std::intmax_t prime = scale_prime(idx);
+		int exp = 0;
+		for(; num % prime == 0; num /= prime) ++exp;
+		for(; den % prime == 0; den /= prime) --exp;
+		word |= lane(exp, idx);
+	}
+	return num != 1 or den != 1 ? throw std::domain_error("scale cannot be represented by dynamic_unit") : word;
+}
+
+/* packs the unit exponents and the tag exponent into one word */
+template<typename U, typename T>
+constexpr std::uint64_t pack_exponents() {
+	constexpr int d = exponent_denominator;
+	return lane(pack_exponent(            time_exponent_t<U>::num,             time_exponent_t<U>::den, d), 0)
+	     | lane(pack_exponent(            mass_exponent_t<U>::num,             mass_exponent_t<U>::den, d), 1)
+	     | lane(pack_exponent(          length_exponent_t<U>::num,           length_exponent_t<U>::den, d), 2)
+	     | lane(pack_exponent(         current_exponent_t<U>::num,          current_exponent_t<U>::den, d), 3)
+	     | lane(pack_exponent(      luminosity_exponent_t<U>::num,       luminosity_exponent_t<U>::den, d), 4)
+	     | lane(pack_exponent(     temperature_exponent_t<U>::num,      temperature_exponent_t<U>::den, d), 5)
+	     | lane(pack_exponent(substance_amount_exponent_t<U>::num, substance_amount_exponent_t<U>::den, d), 6)
+	     | lane(pack_exponent(T::exponent::num, T::exponent::den, d), tag_lane);
+}
+
+template<typename Tag>
+struct dynamic_tag_traits;
+template<std::intmax_t Num, std::intmax_t Den>
+struct dynamic_tag_traits<tag<void,std::ratio<Num,Den>>> {
+	static constexpr std::uint8_t id = 0;
+};
+template<typename ID, std::intmax_t Num, std::intmax_t Den>
+struct dynamic_tag_traits<tag<ID,std::ratio<Num,Den>>> {
+	static constexpr std::uint8_t id = dynamic_tag_id<ID>::value;
+};
+
+}
+
+/**
+ * @brief Runtime descriptor of a quantity's unit, scale, and tag
+ *
+ * This packs the seven exponents of the basic units, the scale, and the tag
+ * of a quantity into 16 bytes:
+ *
+ * - The unit exponents and the tag's exponent are stored as multiples of
+ *   1/exponent_denominator in 8 bit lanes of one word.
+ * - The scale is stored as the exponents of its prime factors 2 to 17 in the
+ *   lanes of the other word, whose last lane holds the tag id.
+ *
+ * Multiplying and dividing descriptors only adds and subtracts all lanes at
+ * once, so it takes a few integer operations.
+ *
+ * @note Descriptors can be created for quantity types using
+ *       make_dynamic_unit(). Creating them for units whose exponents, or
+ *       scales whose prime factors, cannot be represented, will fail.
+ */
+class dynamic_unit {
+public:
+	/** unit and tag exponents are stored as multiples of 1/exponent_denominator */
+	static constexpr int exponent_denominator = detail::exponent_denominator;
+
+	/** a dimensionless, unscaled, untagged unit */
+	constexpr dynamic_unit() noexcept                                     : exponents_{0}, scale_{0} {}
+
+	/**
+	 * @brief Create a descriptor from its raw representation
+	 *
+	 * @param exponents  the unit and tag exponent word (see get_exponents_word())
+	 * @param     scale  the scale and tag id word (see get_scale_word())
+	 */
+	constexpr dynamic_unit(std::uint64_t exponents, std::uint64_t scale) noexcept
+	                                                                      : exponents_{exponents}, scale_{scale} {}
+
+	/** @{ raw representation (e.g., for serialization) */
+	constexpr std::uint64_t get_exponents_word()                    const {return exponents_;}
+	constexpr std::uint64_t get_scale_word    ()                    const {return scale_;}
+	/** @} */
+
+	/**
+	 * @brief get the exponent of a basic unit
+	 *
+	 * @param idx  index of the basic unit (time, mass, length, current,
+	 *             luminosity, temperature, substance amount)
+	 *
+	 * @return the exponent multiplied by exponent_denominator
+	 */
+	constexpr int           get_exponent(std::size_t idx)           const {return detail::get_lane(exponents_, idx);}
+	/** get the tag's exponent, multiplied by exponent_denominator */
+	constexpr int           get_tag_exponent()                      const {return detail::get_lane(exponents_, detail::tag_lane);}
+	/** get the tag's id (zero if the unit has no tag) */
+	constexpr std::uint8_t  get_tag_id()                            const {return static_cast<std::uint8_t>(scale_ >> (8*detail::tag_lane));}
+
+	/** get the factor the scale represents */
+	double get_scale_factor() const                                       {return get_factor(scale_);}
+
+	/** check whether quantities of this and another unit can be added and compared */
+	constexpr bool is_compatible(const dynamic_unit& rhs)           const {return exponents_ == rhs.exponents_ and get_tag_id() == rhs.get_tag_id();}
+
+	/** the factor to multiply values with to rescale them to another unit's scale */
+	double get_rescale_factor(const dynamic_unit& to)               const {return get_factor(detail::lanes_sub(scale_ & ~detail::tag_lane_mask, to.scale_ & ~detail::tag_lane_mask));}
+
+	friend constexpr bool operator==(const dynamic_unit& lhs, const dynamic_unit& rhs)
+	                                                                      {return lhs.exponents_ == rhs.exponents_ and lhs.scale_ == rhs.scale_;}
+	friend constexpr bool operator!=(const dynamic_unit& lhs, const dynamic_unit& rhs)
+	                                                                      {return not (lhs == rhs);}
+
+	/**
+	 * @{
+	 *
+	 * @brief Multiply and divide units
+	 *
+	 * @throw dimension_error if the units have different tags or exponents
+	 *        overflow
+	 */
+	friend dynamic_unit operator*(const dynamic_unit& lhs, const dynamic_unit& rhs) {
+		const std::uint64_t exponents = detail::lanes_add(lhs.exponents_, rhs.exponents_);
+		const std::uint64_t lhs_scale = lhs.scale_ & ~detail::tag_lane_mask;
+		const std::uint64_t rhs_scale = rhs.scale_ & ~detail::tag_lane_mask;
+		const std::uint64_t scale     = detail::lanes_add(lhs_scale, rhs_scale);
+		if( detail::lanes_add_overflow(lhs.exponents_, rhs.exponents_, exponents)
+		  | detail::lanes_add_overflow(lhs_scale     , rhs_scale     , scale    ) )
+			throw dimension_error("dynamic_unit: exponent overflow");
+		return dynamic_unit{exponents, scale | combine_tags(lhs, rhs, exponents)};
+	}
+	friend dynamic_unit operator/(const dynamic_unit& lhs, const dynamic_unit& rhs) {
+		const std::uint64_t exponents = detail::lanes_sub(lhs.exponents_, rhs.exponents_);
+		const std::uint64_t lhs_scale = lhs.scale_ & ~detail::tag_lane_mask;
+		const std::uint64_t rhs_scale = rhs.scale_ & ~detail::tag_lane_mask;
+		const std::uint64_t scale     = detail::lanes_sub(lhs_scale, rhs_scale);
+		if( detail::lanes_sub_overflow(lhs.exponents_, rhs.exponents_, exponents)
+		  | detail::lanes_sub_overflow(lhs_scale     , rhs_scale     , scale    ) )
+			throw dimension_error("dynamic_unit: exponent overflow");
+		return dynamic_unit{exponents, scale | combine_tags(lhs, rhs, exponents)};
+	}
+	/** @} */
+
+private:
+	std::uint64_t                                   exponents_;
+	std::uint64_t                                   scale_;
+
+	/* tags can be combined if they are equal or one of them is no tag;
+	 * if the resulting tag's exponent is zero, the result has no tag */
+	static std::uint64_t combine_tags(const dynamic_unit& lhs, const dynamic_unit& rhs, std::uint64_t exponents) {
+		const std::uint8_t lhs_id = lhs.get_tag_id();
+		const std::uint8_t rhs_id = rhs.get_tag_id();
+		if(lhs_id != rhs_id and lhs_id != 0 and rhs_id != 0)
+			throw dimension_error("dynamic_unit: incompatible tags");
+		if(detail::get_lane(exponents, detail::tag_lane) == 0)
+			return 0;
+		return detail::lane(lhs_id | rhs_id, detail::tag_lane);
+	}
+
+	static double get_factor(std::uint64_t scale) {
+		double num = 1;
+		double den = 1;
+		for(std::size_t idx=0; idx<detail::scale_primes; ++idx) {
+			const auto prime = static_cast<double>(detail::scale_prime(idx));
+			for(int exp = detail::get_lane(scale, idx); exp > 0; --exp) num *= prime;
+			for(int exp = detail::get_lane(scale, idx); exp < 0; ++exp) den *= prime;
+		}
+		return num/den;
+	}
+};
+
+static_assert(sizeof(dynamic_unit) <= 16, "dynamic_unit should be compact");
+
+/**
+ * @{
+ *
+ * @brief Create the dynamic_unit descriptor for a quantity type
+ *
+ * @tparam Q  quantity type
+ * @tparam U  unit type
+ * @tparam S  scale
+ * @tparam T  tag
+ */
+template<typename U, typename S, typename T>
+constexpr dynamic_unit make_dynamic_unit()                                {return dynamic_unit{ detail::pack_exponents<U,T>()
+                                                                                              , detail::pack_scale(S::num, S::den) | detail::lane(detail::dynamic_tag_traits<T>::id, detail::tag_lane) };}
+template<typename Q>
+constexpr dynamic_unit make_dynamic_unit()                                {return make_dynamic_unit<typename Q::unit_type, typename Q::scale_type, typename Q::tag_type>();}
+/** @} */
+
+namespace detail {
+
+/* the descriptor of a quantity type as a constant, so that creating it for
+ * units or scales which cannot be represented fails to compile */
+template<typename U, typename S, typename T>
+struct dynamic_unit_constant {
+	static constexpr dynamic_unit value = make_dynamic_unit<U,S,T>();
+};
+template<typename U, typename S, typename T>
+constexpr dynamic_unit dynamic_unit_constant<U,S,T>::value;
+
+}
+
+/**
+ * @brief Quantity with a unit only known at runtime
+ *
+ * This stores a value together with a dynamic_unit descriptor. Arithmetic
+ * operations check the descriptors at runtime (throwing dimension_error
+ * where the static quantity type would fail to compile) and rescale values
+ * where necessary. Static quantities convert implicitly to dynamic ones, and
+ * quantity_cast() converts back.
+ *
+ * @tparam ValueType  the quantity's value type (must be a floating point type)
+ */
+template<typename ValueType = double>
+class dynamic_quantity {
+public:
+	static_assert(std::is_floating_point<ValueType>::value, "dynamic quantities need floating point value types");
+
+	using value_type = ValueType;
+
+	/** a dimensionless zero */
+	constexpr dynamic_quantity() noexcept                                 : value_{}, unit_{} {}
+
+	constexpr dynamic_quantity(value_type v, const dynamic_unit& u) noexcept
+	                                                                      : value_{v}, unit_{u} {}
+
+	/** converts a static quantity (fails to compile if its unit or scale cannot be represented) */
+	template<typename U, typename S, typename V, typename T>
+	constexpr dynamic_quantity(const quantity<U,S,V,T>& q) noexcept       : value_{static_cast<value_type>(q.get())}, unit_{detail::dynamic_unit_constant<U,S,T>::value} {}
+
+	constexpr value_type          get     ()                        const {return value_;}
+	constexpr const dynamic_unit& get_unit()                        const {return unit_;}
+
+	/** get the value rescaled to the scale of another unit */
+	value_type get_scaled(const dynamic_unit& u) const {
+		check_compatible(u);
+		return unit_ == u ? value_ : value_ * static_cast<value_type>(unit_.get_rescale_factor(u));
+	}
+
+	/**
+	 * @{
+	 *
+	 * @brief Arithmetic operations
+	 *
+	 * These rescale rhs to the scale of this quantity where needed.
+	 *
+	 * @throw dimension_error if the quantities' units are incompatible
+	 */
+	dynamic_quantity& operator+=(const dynamic_quantity& rhs)             {value_ += rhs.get_scaled(unit_); return *this;}
+	dynamic_quantity& operator-=(const dynamic_quantity& rhs)             {value_ -= rhs.get_scaled(unit_); return *this;}
+	dynamic_quantity& operator*=(value_type rhs)                          {value_ *= rhs; return *this;}
+	dynamic_quantity& operator/=(value_type rhs)                          {value_ /= rhs; return *this;}
+	dynamic_quantity& operator*=(const dynamic_quantity& rhs)             {value_ *= rhs.value_; unit_ = unit_ * rhs.unit_; return *this;}
+	dynamic_quantity& operator/=(const dynamic_quantity& rhs)             {value_ /= rhs.value_; unit_ = unit_ / rhs.unit_; return *this;}
+
+	friend dynamic_quantity operator+(dynamic_quantity lhs, const dynamic_quantity& rhs)
+	                                                                      {return lhs += rhs;}
+	friend dynamic_quantity operator-(dynamic_quantity lhs, const dynamic_quantity& rhs)
+	                                                                      {return lhs -= rhs;}
+	friend dynamic_quantity operator*(dynamic_quantity lhs, const dynamic_quantity& rhs)
+	                                                                      {return lhs *= rhs;}
+	friend dynamic_quantity operator/(dynamic_quantity lhs, const dynamic_quantity& rhs)
+	                                                                      {return lhs /= rhs;}
+	friend dynamic_quantity operator*(dynamic_quantity lhs, value_type rhs)
+	                                                                      {return lhs *= rhs;}
+	friend dynamic_quantity operator*(value_type lhs, dynamic_quantity rhs)
+	                                                                      {return rhs *= lhs;}
+	friend dynamic_quantity operator/(dynamic_quantity lhs, value_type rhs)
+	                                                                      {return lhs /= rhs;}
+	friend dynamic_quantity operator/(value_type lhs, const dynamic_quantity& rhs)
+	                                                                      {return dynamic_quantity{lhs / rhs.value_, dynamic_unit{} / rhs.unit_};}
+
+	friend dynamic_quantity operator-(const dynamic_quantity& q)          {return dynamic_quantity{-q.value_, q.unit_};}
+	friend dynamic_quantity operator+(const dynamic_quantity& q)          {return q;}
+	/** @} */
+
+	/**
+	 * @{
+	 *
+	 * @brief Comparison
+	 *
+	 * @throw dimension_error if the quantities' units are incompatible
+	 */
+	friend bool operator==(const dynamic_quantity& lhs, const dynamic_quantity& rhs)
+	                                                                      {return lhs.value_ == rhs.get_scaled(lhs.unit_);}
+	friend bool operator!=(const dynamic_quantity& lhs, const dynamic_quantity& rhs)
+	                                                                      {return lhs.value_ != rhs.get_scaled(lhs.unit_);}
+	friend bool operator< (const dynamic_quantity& lhs, const dynamic_quantity& rhs)
+	                                                                      {return lhs.value_ <  rhs.get_scaled(lhs.unit_);}
+	friend bool operator> (const dynamic_quantity& lhs, const dynamic_quantity& rhs)
+	                                                                      {return lhs.value_ >  rhs.get_scaled(lhs.unit_);}
+	friend bool operator<=(const dynamic_quantity& lhs, const dynamic_quantity& rhs)
+	                                                                      {return lhs.value_ <= rhs.get_scaled(lhs.unit_);}
+	friend bool operator>=(const dynamic_quantity& lhs, const dynamic_quantity& rhs)
+	                                                                      {return lhs.value_ >= rhs.get_scaled(lhs.unit_);}
+	/** @} */
+
+private:
+	value_type                                      value_;
+	dynamic_unit                                    unit_;
+
+	void check_compatible(const dynamic_unit& u) const {
+		if(not unit_.is_compatible(u))
+			throw dimension_error("dynamic_quantity: incompatible units");
+	}
+};
+
+/**
+ * @brief Cast a dynamic quantity to a static quantity type
+ *
+ * If the dynamic quantity's descriptor equals that of NewQuantity, this only
+ * compares the descriptors and copies the value. If it differs only in
+ * scale, the value is rescaled.
+ *
+ * @tparam NewQuantity  static quantity type to cast to
+ *
+ * @param dq  dynamic quantity to cast
+ *
+ * @throw dimension_error if the units are incompatible
+ *
+ * @code
+ * const dynamic_quantity<> dq = read_meter_value();
+ * const auto energy = quantity_cast<kilo<watt_hour<double>>>(dq);
+ */
+template<typename NewQuantity, typename V>
+NewQuantity quantity_cast(const dynamic_quantity<V>& dq) {
+	using new_value_type = typename NewQuantity::value_type;
+	constexpr dynamic_unit new_unit = make_dynamic_unit<NewQuantity>();
+	if(dq.get_unit() == new_unit)
+		return NewQuantity{static_cast<new_value_type>(dq.get())};
+	return NewQuantity{static_cast<new_value_type>(dq.get_scaled(new_unit))};
+}
+
+}
+
+#endif //UNLIB_DYNAMIC_QUANTITY_HPP
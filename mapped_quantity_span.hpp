@@ -0,0 +1,244 @@
+#ifndef UNLIB_MAPPED_QUANTITY_SPAN_HPP
+#define UNLIB_MAPPED_QUANTITY_SPAN_HPP
+
+/*
+ * mapped_quantity_span.hpp
+ *
+ * Copyright sbi http://stackoverflow.com/users/140719
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *     http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <unlib/quantity.hpp>
+#include <unlib/quantity_span.hpp>
+#include <unlib/quantity_columns.hpp>
+
+namespace unlib {
+
+/**
+ * @brief Access pattern hints for memory-mapped column files
+ *
+ * These are passed to the OS (using madvise()) and affect read-ahead.
+ */
+enum class mapping_advice { normal     /**< no special treatment                                           */
+                          , sequential /**< data will be accessed sequentially, aggressive read-ahead      */
+                          , random     /**< data will be accessed in random order, no read-ahead           */
+                          , willneed   /**< data will be needed soon, start reading it in the background   */
+                          };
+
+namespace detail {
+
+/* RAII wrapper of a read-only memory mapping of a whole file */
+class file_mapping {
+public:
+	file_mapping(const std::string& path, mapping_advice advice, bool use_huge_pages) : data_{nullptr}, size_{0} {
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		if(fd < 0)
+			throw std::system_error(errno, std::generic_category(), "cannot open " + path);
+		struct ::stat st;
+		if(::fstat(fd, &st) != 0) {
+			const int err = errno;
+			::close(fd);
+			throw std::system_error(err, std::generic_category(), "cannot stat " + path);
+		}
+		size_ = static_cast<std::size_t>(st.st_size);
+		if(size_ > 0) {
+			void* const data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+			if(data == MAP_FAILED) {
+				const int err = errno;
+				::close(fd);
+				throw std::system_error(err, std::generic_category(), "cannot map " + path);
+			}
+			data_ = static_cast<const char*>(data);
+		}
+		::close(fd);
+		advise(advice, use_huge_pages);
+	}
+
+	~file_mapping()                                                       {if(data_) ::munmap(const_cast<char*>(data_), size_);}
+
+	file_mapping(const file_mapping&) = delete;
+	file_mapping& operator=(const file_mapping&) = delete;
+
+	const char*                                     data()          const {return data_;}
+	std::size_t                                     size()          const {return size_;}
+
+private:
+	const char*                                     data_;
+	std::size_t                                     size_;
+
+	/* these are only hints, so failures are ignored */
+	void advise(mapping_advice advice, bool use_huge_pages) {
+		if(not data_)
+			return;
+		void* const addr = const_cast<char*>(data_);
+		switch(advice) {
+			case mapping_advice::normal    :                                            break;
+			case mapping_advice::sequential: ::madvise(addr, size_, MADV_SEQUENTIAL); break;
+			case mapping_advice::random    : ::madvise(addr, size_, MADV_RANDOM    ); break;
+			case mapping_advice::willneed  : ::madvise(addr, size_, MADV_WILLNEED  ); break;
+		}
+#if defined(MADV_HUGEPAGE)
+		if(use_huge_pages)
+			::madvise(addr, size_, MADV_HUGEPAGE);
+#else
+		(void)use_huge_pages;
+#endif
+	}
+};
+
+}
+
+template<typename Q>
+class mapped_quantity_span;
+
+/**
+ * @brief Read-only memory mapping of a column file
+ *
+ * This maps a column file (@sa quantity_columns.hpp) into memory and
+ * validates its header. Columns can then be accessed as spans of quantities
+ * without reading or copying their values. The mapping is shared by all
+ * spans created from it and stays alive as long as any of them does.
+ *
+ * @note This is only available on POSIX systems.
+ */
+class mapped_column_file {
+public:
+	/**
+	 * @brief Map a column file into memory
+	 *
+	 * @param           path  path of the file
+	 * @param         advice  how the file's data is going to be accessed
+	 * @param use_huge_pages  ask the OS to back the mapping by huge pages
+	 *                        (only a hint; whether this is honored for file
+	 *                        mappings depends on the OS and file system)
+	 *
+	 * @throw std::system_error if the file cannot be opened or mapped
+	 * @throw column_format_error if the file is not a valid column file
+	 */
+	explicit mapped_column_file( const std::string& path
+	                           , mapping_advice advice = mapping_advice::sequential
+	                           , bool use_huge_pages = false )
+	                                                                      : mapping_{std::make_shared<detail::file_mapping>(path, advice, use_huge_pages)}
+	                                                                      , header_{nullptr}
+	                                                                      , descriptors_{nullptr} {
+		if(mapping_->size() < sizeof(quantity_columns_header))
+			throw column_format_error("unexpected end of quantity column file");
+		header_ = reinterpret_cast<const quantity_columns_header*>(mapping_->data());
+		detail::check_columns_header(*header_, mapping_->size() - sizeof(quantity_columns_header));
+		descriptors_ = reinterpret_cast<const quantity_column_descriptor*>(mapping_->data() + sizeof(quantity_columns_header));
+		for(std::size_t idx=0; idx<get_column_count(); ++idx)
+			detail::check_column_descriptor(descriptors_[idx], mapping_->size());
+	}
+
+	std::size_t                       get_column_count()            const {return static_cast<std::size_t>(header_->column_count);}
+	const quantity_column_descriptor& get_descriptor(std::size_t idx) const
+	                                                                      {return idx < get_column_count() ? descriptors_[idx] : throw std::out_of_range("quantity column index out of range");}
+
+	/**
+	 * @brief Access a column as a span of quantities
+	 *
+	 * @tparam Q  quantity type
+	 *
+	 * @param idx  column index
+	 *
+	 * @throw column_format_error if the column's unit, scale, tag, or value
+	 *        type do not match those of Q
+	 */
+	template<typename Q>
+	mapped_quantity_span<Q> get_column(std::size_t idx) const {
+		const quantity_column_descriptor& descriptor = get_descriptor(idx);
+		detail::check_column<Q>(descriptor, false);
+		const auto data = reinterpret_cast<const Q*>(mapping_->data() + descriptor.offset);
+		return mapped_quantity_span<Q>{mapping_, quantity_span<const Q>{data, static_cast<std::size_t>(descriptor.count)}};
+	}
+
+private:
+	std::shared_ptr<const detail::file_mapping>     mapping_;
+	const quantity_columns_header*                  header_;
+	const quantity_column_descriptor*               descriptors_;
+};
+
+/**
+ * @brief Read-only span of quantities stored in a memory-mapped column file
+ *
+ * This behaves like a quantity_span<const Q>, referring directly to the
+ * values in the mapped file, and keeps the mapping alive.
+ *
+ * @tparam Q  quantity type
+ *
+ * @code
+ * const mapped_quantity_span<kilo<watt_hour<double>>> energy("meter.col", 0);
+ * const auto total = std::accumulate(energy.begin(), energy.end(), kilo<watt_hour<double>>{});
+ */
+template<typename Q>
+class mapped_quantity_span {
+public:
+	using          span_type = quantity_span<const Q>;
+	using      quantity_type = typename span_type::quantity_type;
+	using          unit_type = typename span_type::unit_type;
+	using         scale_type = typename span_type::scale_type;
+	using         value_type = typename span_type::value_type;
+	using           tag_type = typename span_type::tag_type;
+	using          size_type = typename span_type::size_type;
+	using           iterator = typename span_type::iterator;
+
+	/**
+	 * @brief Map a column file and access one of its columns
+	 *
+	 * @param           path  path of the file
+	 * @param            idx  column index
+	 * @param         advice  how the file's data is going to be accessed
+	 * @param use_huge_pages  ask the OS to back the mapping by huge pages
+	 *                        (@sa mapped_column_file)
+	 *
+	 * @throw std::system_error if the file cannot be opened or mapped
+	 * @throw column_format_error if the file is not a valid column file, or
+	 *        the column does not match Q
+	 */
+	explicit mapped_quantity_span( const std::string& path
+	                             , std::size_t idx = 0
+	                             , mapping_advice advice = mapping_advice::sequential
+	                             , bool use_huge_pages = false )
+	                                                                      : mapped_quantity_span{mapped_column_file{path, advice, use_huge_pages}.get_column<Q>(idx)} {}
+
+	const span_type&     get_span()                                    const {return span_;}
+	operator const span_type&()                                        const {return span_;}
+
+	size_type            size()                                        const {return span_.size();}
+	bool                 empty()                                       const {return span_.empty();}
+	const quantity_type* data()                                        const {return span_.data();}
+	const value_type*    values()                                      const {return span_.values();}
+	iterator             begin()                                       const {return span_.begin();}
+	iterator             end()                                         const {return span_.end();}
+	const quantity_type& operator[](size_type idx)                     const {return span_[idx];}
+
+private:
+	friend class mapped_column_file;
+
+	mapped_quantity_span(std::shared_ptr<const detail::file_mapping> mapping, span_type span)
+	                                                                      : mapping_{std::move(mapping)}, span_{span} {}
+
+	std::shared_ptr<const detail::file_mapping>     mapping_;
+	span_type                                       span_;
+};
+
+}
+
+#endif //UNLIB_MAPPED_QUANTITY_SPAN_HPP
@@ -11,10 +11,23 @@
  *
  */
 
+#include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#if defined(__AVX__)
+#	include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#	include <arm_neon.h>
+#endif
 
 #include <unlib/ratio.hpp>
 #include <unlib/quantity.hpp>
+#include <unlib/quantity_span.hpp>
 
 namespace unlib {
 
@@ -26,14 +39,35 @@ template<typename Float1, typename Float2, typename T>
 using if_float2_pt_t = typename std::enable_if< is_floating_point<Float1>::value
                                             and is_floating_point<Float2>::value, T >::type;
 
-template<typename D, typename S, typename V, typename T, std::intmax_t Nom, std::intmax_t Den>
-auto pow(const quantity<D,S,T,V>& q, const std::ratio<Nom,Den>) {
-	return pow_quantity_t<quantity<D,S,T,V>, std::ratio<Nom,Den>>{ std::pow( static_cast<double>(q.get()), static_cast<double>(Nom)/Den ) };
+/* Integer powers are computed by repeated multiplication (exponentiation by
+ * squaring), which keeps the value type, and can be evaluated at compile time.
+ * Negative powers are the reciprocals of these, so for integer value types
+ * they truncate like any other integer division does. */
+template<typename V>
+constexpr V pow_by_squaring(V  , std::integral_constant<std::intmax_t,0>)  {return static_cast<V>(1);}
+template<typename V>
+constexpr V pow_by_squaring(V v, std::integral_constant<std::intmax_t,1>)  {return v;}
+template<typename V, std::intmax_t N>
+constexpr V pow_by_squaring(V v, std::integral_constant<std::intmax_t,N>) {
+	const V half = pow_by_squaring(static_cast<V>(v*v), std::integral_constant<std::intmax_t,N/2>{});
+	return N%2 ? static_cast<V>(v*half) : half;
 }
 
-template<typename U, typename S, typename V, typename T>
-auto pow(const quantity<U,S,T,V>& q, const std::ratio<1,2>) {
-	return pow_quantity_t<quantity<U,S,T,V>,std::ratio<1,2>>(std::sqrt(q.get()));
+template<typename V, std::intmax_t Nom>
+constexpr V pow_integer_value(V v, std::true_type /*non-negative*/)      {return pow_by_squaring(v, std::integral_constant<std::intmax_t, Nom>{});}
+template<typename V, std::intmax_t Nom>
+constexpr V pow_integer_value(V v, std::false_type/*non-negative*/)      {return static_cast<V>(static_cast<V>(1) / pow_by_squaring(v, std::integral_constant<std::intmax_t,-Nom>{}));}
+
+template<typename V, std::intmax_t Nom, std::intmax_t Den>
+V pow_value(V v, std::ratio<Nom,Den>)                                     {return static_cast<V>(std::pow(static_cast<double>(v), static_cast<double>(Nom)/Den));}
+template<typename V>
+V pow_value(V v, std::ratio<1,2>)                                         {return static_cast<V>(std::sqrt(v));}
+template<typename V, std::intmax_t Nom>
+constexpr V pow_value(V v, std::ratio<Nom,1>)                             {return pow_integer_value<V,Nom>(v, std::integral_constant<bool,(Nom>=0)>{});}
+
+template<typename U, typename S, typename V, typename T, std::intmax_t Nom, std::intmax_t Den>
+constexpr auto pow(const quantity<U,S,V,T>& q, const std::ratio<Nom,Den>) {
+	return pow_quantity_t<quantity<U,S,V,T>,std::ratio<Nom,Den>>{pow_value(q.get(), std::ratio<Nom,Den>{})};
 }
 
 template<typename TolTag, typename F, typename>
@@ -83,12 +117,16 @@ auto abs(quantity<U,S,T,V> q)                                             {retur
  * @param q  Quantity to raise
  *
  * @return @p q, raised to Power, as pow_quantity_t<quantity<U,S,T,V>,
+ *
+ * @note Integer powers are computed by repeated multiplication in the value
+ *       type V, and can be evaluated at compile time. Negative integer powers
+ *       of integer quantities truncate like integer division.
  */
 template<typename Power, typename U, typename S, typename V, typename T>
-auto pow(const quantity<U,S,T,V>& q)                                      {return detail::pow(q, typename Power::type{});}
+constexpr auto pow(const quantity<U,S,T,V>& q)                            {return detail::pow(q, typename Power::type{});}
 
 template<int Power, typename U, typename S, typename V, typename T>
-auto pow(quantity<U,S,T,V> q)                                             {return pow<ratio_t<Power>>(q);}
+constexpr auto pow(quantity<U,S,T,V> q)                                   {return pow<ratio_t<Power>>(q);}
 /** @} */
 
 /**
@@ -161,6 +199,182 @@ max(const unlib::quantity<D,S1,F,T> lhs, const unlib::quantity<D,S2,F,T> rhs) {
 	return unlib::quantity<D,S1,F,T>{max(lhs.get(), rhs.template get_scaled<S1>())};
 }
 
+namespace detail {
+
+/* Elementwise kernels for the span functions below. These process values in
+ * blocks of fixed size through a local buffer. This relieves the compiler of
+ * proving that input and output do not overlap, so it vectorizes the blocks
+ * even at -O2. (In-place operation is fine, as every block is read before it
+ * is written.) */
+constexpr std::size_t math_block_size = 8;
+
+template<typename In, typename Out, typename F>
+void transform_values(const In* in, std::size_t n, Out* out, F f) {
+	std::size_t idx = 0;
+	for(; idx+math_block_size<=n; idx+=math_block_size) {
+		Out block[math_block_size];
+		for(std::size_t blk=0; blk<math_block_size; ++blk)
+			block[blk] = f(in[idx+blk]);
+		for(std::size_t blk=0; blk<math_block_size; ++blk)
+			out[idx+blk] = block[blk];
+	}
+	for(; idx<n; ++idx)
+		out[idx] = f(in[idx]);
+}
+
+template<typename In1, typename In2, typename Out, typename F>
+void transform_values(const In1* in1, const In2* in2, std::size_t n, Out* out, F f) {
+	std::size_t idx = 0;
+	for(; idx+math_block_size<=n; idx+=math_block_size) {
+		Out block[math_block_size];
+		for(std::size_t blk=0; blk<math_block_size; ++blk)
+			block[blk] = f(in1[idx+blk], in2[idx+blk]);
+		for(std::size_t blk=0; blk<math_block_size; ++blk)
+			out[idx+blk] = block[blk];
+	}
+	for(; idx<n; ++idx)
+		out[idx] = f(in1[idx], in2[idx]);
+}
+
+/* Compilers do not vectorize std::sqrt() unless they may ignore errno, so
+ * where available, the SIMD square root instructions are used directly.
+ * Being correctly rounded, they produce the same results as std::sqrt(). */
+template<typename V>
+void sqrt_values(const V* in, std::size_t n, V* out)                      {transform_values(in, n, out, [](V v){return static_cast<V>(std::sqrt(v));});}
+
+#if defined(__AVX__)
+inline void sqrt_values(const double* in, std::size_t n, double* out) {
+	std::size_t idx = 0;
+	for(; idx+4<=n; idx+=4)
+		_mm256_storeu_pd(out+idx, _mm256_sqrt_pd(_mm256_loadu_pd(in+idx)));
+	for(; idx<n; ++idx)
+		out[idx] = std::sqrt(in[idx]);
+}
+inline void sqrt_values(const float* in, std::size_t n, float* out) {
+	std::size_t idx = 0;
+	for(; idx+8<=n; idx+=8)
+		_mm256_storeu_ps(out+idx, _mm256_sqrt_ps(_mm256_loadu_ps(in+idx)));
+	for(; idx<n; ++idx)
+		out[idx] = std::sqrt(in[idx]);
+}
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+inline void sqrt_values(const double* in, std::size_t n, double* out) {
+	std::size_t idx = 0;
+	for(; idx+2<=n; idx+=2)
+		_mm_storeu_pd(out+idx, _mm_sqrt_pd(_mm_loadu_pd(in+idx)));
+	for(; idx<n; ++idx)
+		out[idx] = std::sqrt(in[idx]);
+}
+inline void sqrt_values(const float* in, std::size_t n, float* out) {
+	std::size_t idx = 0;
+	for(; idx+4<=n; idx+=4)
+		_mm_storeu_ps(out+idx, _mm_sqrt_ps(_mm_loadu_ps(in+idx)));
+	for(; idx<n; ++idx)
+		out[idx] = std::sqrt(in[idx]);
+}
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+inline void sqrt_values(const double* in, std::size_t n, double* out) {
+	std::size_t idx = 0;
+	for(; idx+2<=n; idx+=2)
+		vst1q_f64(out+idx, vsqrtq_f64(vld1q_f64(in+idx)));
+	for(; idx<n; ++idx)
+		out[idx] = std::sqrt(in[idx]);
+}
+inline void sqrt_values(const float* in, std::size_t n, float* out) {
+	std::size_t idx = 0;
+	for(; idx+4<=n; idx+=4)
+		vst1q_f32(out+idx, vsqrtq_f32(vld1q_f32(in+idx)));
+	for(; idx<n; ++idx)
+		out[idx] = std::sqrt(in[idx]);
+}
+#endif
+
+template<typename V, std::intmax_t Nom, std::intmax_t Den>
+void pow_values(const V* in, std::size_t n, V* out, std::ratio<Nom,Den>)  {transform_values(in, n, out, [](V v){return pow_value(v, std::ratio<Nom,Den>{});});}
+template<typename V>
+void pow_values(const V* in, std::size_t n, V* out, std::ratio<1,2>)      {sqrt_values(in, n, out);}
+
+template<typename Q1, typename Q2>
+using if_same_but_scale_t = std::enable_if_t< std::is_same<typename Q1::unit_type , typename Q2::unit_type >::value
+                                          and std::is_same<typename Q1::value_type, typename Q2::value_type>::value
+                                          and std::is_same<typename Q1::  tag_type, typename Q2::  tag_type>::value >;
+
+}
+
+/**
+ * @{
+ *
+ * @brief Math functions for sequences of quantities
+ *
+ * These apply abs(), sqrt(), cbrt(), pow(), min(), and max() to all
+ * quantities in @p in (or in @p lhs and @p rhs), and write the results to
+ * @p out. The results are the same the scalar functions produce for each
+ * quantity, and so is the type of the quantities in @p out. (For example,
+ * the square roots of square meters must be written to meters.) But the
+ * computation is done in loops over contiguous memory that are vectorized.
+ *
+ * @note min_span() and max_span() rescale @p rhs to the scale of @p lhs,
+ *       whose quantities' type is also the result type.
+ *
+ * @param   in        quantities to apply the function to
+ * @param   lhs, rhs  quantities to compare
+ * @param   out       quantities to write the results to
+ *
+ * @note All spans must have the same size. Inputs and output must either not
+ *       overlap, or refer to exactly the same memory.
+ *
+ * @note Where the SIMD square root instructions are used, sqrt_span() does
+ *       not set errno for negative values.
+ */
+template<typename Q>
+void abs_span(quantity_span<Q> in, quantity_span<std::remove_const_t<Q>> out) {
+	using value_type = typename quantity_span<Q>::value_type;
+	assert(in.size() == out.size());
+	detail::transform_values(in.values(), in.size(), out.values(), [](value_type v){using std::abs; return static_cast<value_type>(abs(v));});
+}
+
+template<typename Q>
+void sqrt_span(quantity_span<Q> in, quantity_span<sqrt_quantity_t<std::remove_const_t<Q>>> out) {
+	assert(in.size() == out.size());
+	detail::sqrt_values(in.values(), in.size(), out.values());
+}
+
+template<typename Q>
+void cbrt_span(quantity_span<Q> in, quantity_span<cbrt_quantity_t<std::remove_const_t<Q>>> out) {
+	assert(in.size() == out.size());
+	detail::pow_values(in.values(), in.size(), out.values(), std::ratio<1,3>{});
+}
+
+template<typename Power, typename Q>
+void pow_span(quantity_span<Q> in, quantity_span<pow_quantity_t<std::remove_const_t<Q>,typename Power::type>> out) {
+	assert(in.size() == out.size());
+	detail::pow_values(in.values(), in.size(), out.values(), typename Power::type{});
+}
+template<int Power, typename Q>
+void pow_span(quantity_span<Q> in, quantity_span<pow_quantity_t<std::remove_const_t<Q>,ratio_t<Power>>> out)
+                                                                          {pow_span<ratio_t<Power>>(in, out);}
+
+template<typename Q1, typename Q2, typename = detail::if_same_but_scale_t<std::remove_const_t<Q1>,std::remove_const_t<Q2>>>
+void min_span(quantity_span<Q1> lhs, quantity_span<Q2> rhs, quantity_span<std::remove_const_t<Q1>> out) {
+	using value_type = typename quantity_span<Q1>::value_type;
+	using  lhs_scale = typename quantity_span<Q1>::scale_type;
+	using  rhs_scale = typename quantity_span<Q2>::scale_type;
+	assert(lhs.size() == rhs.size() and lhs.size() == out.size());
+	detail::transform_values( lhs.values(), rhs.values(), lhs.size(), out.values()
+	                        , [](value_type l, value_type r){r = detail::rescale_value<lhs_scale,rhs_scale>(r); return r < l ? r : l;} );
+}
+
+template<typename Q1, typename Q2, typename = detail::if_same_but_scale_t<std::remove_const_t<Q1>,std::remove_const_t<Q2>>>
+void max_span(quantity_span<Q1> lhs, quantity_span<Q2> rhs, quantity_span<std::remove_const_t<Q1>> out) {
+	using value_type = typename quantity_span<Q1>::value_type;
+	using  lhs_scale = typename quantity_span<Q1>::scale_type;
+	using  rhs_scale = typename quantity_span<Q2>::scale_type;
+	assert(lhs.size() == rhs.size() and lhs.size() == out.size());
+	detail::transform_values( lhs.values(), rhs.values(), lhs.size(), out.values()
+	                        , [](value_type l, value_type r){r = detail::rescale_value<lhs_scale,rhs_scale>(r); return l < r ? r : l;} );
+}
+/** @} */
+
 /**
  * @{
  *
@@ -413,6 +627,245 @@ bool is_greater_zero(F val, detail::tolerance_aux<TT1,TF1,X1> tol1, detail::tole
 
 /** @} */
 
+
+/**
+ * @brief Result of comparing sequences of quantities
+ *
+ * @tparam Q  type of the left hand side quantities
+ */
+template<typename Q>
+struct near_span_result {
+	std::size_t mismatches;                                               /**< number of quantities not near each other         */
+	std::size_t first_mismatch;                                           /**< index of the first of them, or the spans' size   */
+	std::size_t worst;                                                    /**< index of the largest deviation, or the spans' size */
+	Q           worst_deviation;                                          /**< the largest deviation                            */
+
+	constexpr bool all_near()                                       const {return mismatches == 0;}
+};
+
+namespace detail {
+
+template<typename S, typename U, typename S2, typename V, typename T>
+constexpr V tolerance_in_scale(tolerance_val<quantity<U,S2,V,T>> tol)     {using std::abs; return abs(tol.v.template get_scaled<S>());}
+
+/* Comparing sequences is done in blocks. For each block, the deviations are
+ * computed (with the rhs values rescaled to the lhs scale) in a loop the
+ * compiler vectorizes, and then compared to the tolerance and to the largest
+ * deviation so far. Compilers do not reliably vectorize the latter, because
+ * of the conversions of comparison results into integers, so where available
+ * this is done using SIMD comparisons and their masks directly. Only in the
+ * blocks where these comparisons find something are the positions looked at
+ * individually. NaN deviations count as mismatches, as they do for is_near(),
+ * but are never greater than another deviation. */
+struct near_block_stats {
+	unsigned mismatches;                                                  /* bit i is set for a mismatch at index i */
+	bool     greater;                                                     /* any deviation greater than the limit   */
+};
+
+using full_near_block = std::integral_constant<std::size_t,math_block_size>;
+
+template<typename S1, typename S2, typename V>
+void deviations(const V* lhs, const V* rhs, std::size_t len, V* dev) {
+	using std::abs;
+	for(std::size_t blk=0; blk<len; ++blk)
+		dev[blk] = abs(lhs[blk] - rescale_value<S1,S2>(rhs[blk]));
+}
+
+template<typename V>
+near_block_stats compare_deviations(const V* dev, std::size_t len, V tol, V limit) {
+	near_block_stats stats{0u, false};
+	for(std::size_t blk=0; blk<len; ++blk) {
+		if(not (dev[blk] <= tol))
+			stats.mismatches |= 1u << blk;
+		stats.greater = stats.greater or dev[blk] > limit;
+	}
+	return stats;
+}
+template<typename V>
+near_block_stats compare_deviations(const V* dev, full_near_block, V tol, V limit)
+                                                                          {return compare_deviations(dev, math_block_size, tol, limit);}
+
+#if defined(__AVX__)
+inline near_block_stats compare_deviations(const double* dev, full_near_block, double tol, double limit) {
+	const __m256d t = _mm256_set1_pd(tol), l = _mm256_set1_pd(limit);
+	const __m256d d0 = _mm256_loadu_pd(dev), d1 = _mm256_loadu_pd(dev+4);
+	const unsigned mismatches = static_cast<unsigned>( _mm256_movemask_pd(_mm256_cmp_pd(d0, t, _CMP_NLE_UQ))
+	                                                 | _mm256_movemask_pd(_mm256_cmp_pd(d1, t, _CMP_NLE_UQ)) << 4 );
+	const int greater = _mm256_movemask_pd(_mm256_or_pd(_mm256_cmp_pd(d0, l, _CMP_GT_OQ), _mm256_cmp_pd(d1, l, _CMP_GT_OQ)));
+	return {mismatches, greater != 0};
+}
+inline near_block_stats compare_deviations(const float* dev, full_near_block, float tol, float limit) {
+	const __m256 d = _mm256_loadu_ps(dev);
+	const unsigned mismatches = static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(d, _mm256_set1_ps(tol  ), _CMP_NLE_UQ)));
+	const int      greater    =                       _mm256_movemask_ps(_mm256_cmp_ps(d, _mm256_set1_ps(limit), _CMP_GT_OQ ));
+	return {mismatches, greater != 0};
+}
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+inline near_block_stats compare_deviations(const double* dev, full_near_block, double tol, double limit) {
+	const __m128d t = _mm_set1_pd(tol), l = _mm_set1_pd(limit);
+	unsigned mismatches = 0;
+	__m128d  greater    = _mm_setzero_pd();
+	for(std::size_t blk=0; blk<math_block_size; blk+=2) {
+		const __m128d d = _mm_loadu_pd(dev+blk);
+		mismatches |= static_cast<unsigned>(_mm_movemask_pd(_mm_cmpnle_pd(d, t))) << blk;
+		greater     = _mm_or_pd(greater, _mm_cmpgt_pd(d, l));
+	}
+	return {mismatches, _mm_movemask_pd(greater) != 0};
+}
+inline near_block_stats compare_deviations(const float* dev, full_near_block, float tol, float limit) {
+	const __m128 t = _mm_set1_ps(tol), l = _mm_set1_ps(limit);
+	const __m128 d0 = _mm_loadu_ps(dev), d1 = _mm_loadu_ps(dev+4);
+	const unsigned mismatches = static_cast<unsigned>( _mm_movemask_ps(_mm_cmpnle_ps(d0, t))
+	                                                 | _mm_movemask_ps(_mm_cmpnle_ps(d1, t)) << 4 );
+	const int greater = _mm_movemask_ps(_mm_or_ps(_mm_cmpgt_ps(d0, l), _mm_cmpgt_ps(d1, l)));
+	return {mismatches, greater != 0};
+}
+#endif
+
+inline std::size_t count_bits(unsigned mask)                              {std::size_t count = 0; for(; mask; mask &= mask-1) ++count; return count;}
+inline std::size_t lowest_bit(unsigned mask)                              {std::size_t bit = 0; for(; not (mask & 1u); mask >>= 1) ++bit; return bit;}
+
+template<typename V>
+struct near_accumulator {
+	near_span_result<V> result;
+	V                   worst_deviation;
+	unsigned char*      mismatch_mask;
+
+	void add_block(std::size_t idx, const V* dev, std::size_t len, near_block_stats stats) {
+		if(mismatch_mask)
+			mismatch_mask[idx/math_block_size] = static_cast<unsigned char>(stats.mismatches);
+		if(stats.mismatches) {
+			if(result.mismatches == 0)
+				result.first_mismatch = idx + lowest_bit(stats.mismatches);
+			result.mismatches += count_bits(stats.mismatches);
+		}
+		if(stats.greater) {
+			for(std::size_t blk=0; blk<len; ++blk)
+				if(dev[blk] > worst_deviation) {
+					worst_deviation = dev[blk];
+					result.worst = idx + blk;
+				}
+		}
+	}
+};
+
+template<typename S1, typename S2, typename V>
+near_span_result<V> compare_near(const V* lhs, const V* rhs, std::size_t n, V tol, unsigned char* mismatch_mask) {
+	static_assert(math_block_size == 8, "mismatch masks are written one byte per block");
+	near_accumulator<V> acc{{0, n, n, V{}}, static_cast<V>(-1), mismatch_mask};
+	V dev[math_block_size];
+	std::size_t idx = 0;
+	for(; idx+math_block_size<=n; idx+=math_block_size) {
+		deviations<S1,S2>(lhs+idx, rhs+idx, math_block_size, dev);
+		acc.add_block(idx, dev, math_block_size, compare_deviations(dev, full_near_block{}, tol, acc.worst_deviation));
+	}
+	if(idx < n) {
+		deviations<S1,S2>(lhs+idx, rhs+idx, n-idx, dev);
+		acc.add_block(idx, dev, n-idx          , compare_deviations(dev, n-idx            , tol, acc.worst_deviation));
+	}
+	if(acc.result.worst != n)
+		acc.result.worst_deviation = acc.worst_deviation;
+	return acc.result;
+}
+
+template<typename S1, typename S2, typename V>
+std::size_t find_not_near(const V* lhs, const V* rhs, std::size_t n, V tol) {
+	const V no_limit = std::numeric_limits<V>::infinity();
+	V dev[math_block_size];
+	std::size_t idx = 0;
+	for(; idx+math_block_size<=n; idx+=math_block_size) {
+		deviations<S1,S2>(lhs+idx, rhs+idx, math_block_size, dev);
+		const near_block_stats stats = compare_deviations(dev, full_near_block{}, tol, no_limit);
+		if(stats.mismatches)
+			return idx + lowest_bit(stats.mismatches);
+	}
+	if(idx < n) {
+		deviations<S1,S2>(lhs+idx, rhs+idx, n-idx, dev);
+		const near_block_stats stats = compare_deviations(dev, n-idx, tol, no_limit);
+		if(stats.mismatches)
+			return idx + lowest_bit(stats.mismatches);
+	}
+	return n;
+}
+
+template<typename Q1, typename Q2, typename Tol>
+auto is_near_span(quantity_span<Q1> lhs, quantity_span<Q2> rhs, unsigned char* mismatch_mask, Tol tol) {
+	using quantity_type = std::remove_const_t<Q1>;
+	using    value_type = typename quantity_type::value_type;
+	using     lhs_scale = typename quantity_type::scale_type;
+	using     rhs_scale = typename quantity_span<Q2>::scale_type;
+	static_assert(std::is_floating_point<value_type>::value, "is_near_span() compares floating point quantities");
+	assert(lhs.size() == rhs.size());
+	const auto result = compare_near<lhs_scale,rhs_scale>( lhs.values(), rhs.values(), lhs.size()
+	                                                     , tolerance_in_scale<lhs_scale>(tol), mismatch_mask );
+	return near_span_result<quantity_type>{result.mismatches, result.first_mismatch, result.worst, quantity_type{result.worst_deviation}};
+}
+
+template<typename Q1, typename Q2, typename Tol>
+std::size_t find_not_near(quantity_span<Q1> lhs, quantity_span<Q2> rhs, Tol tol) {
+	using quantity_type = std::remove_const_t<Q1>;
+	using    value_type = typename quantity_type::value_type;
+	using     lhs_scale = typename quantity_type::scale_type;
+	using     rhs_scale = typename quantity_span<Q2>::scale_type;
+	static_assert(std::is_floating_point<value_type>::value, "find_not_near() compares floating point quantities");
+	assert(lhs.size() == rhs.size());
+	return find_not_near<lhs_scale,rhs_scale>(lhs.values(), rhs.values(), lhs.size(), tolerance_in_scale<lhs_scale>(tol));
+}
+
+}
+
+/**
+ * @{
+ *
+ * @brief compare sequences of floating point quantities
+ *
+ * These compare each quantity in @p lhs with the one at the same index in
+ * @p rhs the way is_near() does. However, the tolerance is only resolved
+ * once, and the comparisons are done in vectorized loops.
+ *
+ * is_near_span() compares all quantities and returns the number of pairs
+ * that are not near each other, the index of the first of these, and the
+ * index and amount of the largest deviation. If @p mismatch_mask is passed,
+ * bit i%8 of byte i/8 of it is set if the quantities at index i are not near
+ * each other, and cleared otherwise. The mask must provide (size+7)/8 bytes.
+ *
+ * find_not_near() stops at the first pair of quantities not near each other
+ * and returns its index, or the spans' size if all are near each other.
+ *
+ * @param lhs, rhs          quantities to compare
+ * @param mismatch_mask     bit mask of mismatches to write
+ * @param tol, tol1, tol2   tolerance (see is_near())
+ *
+ * @note The quantities do not need to be of the same scale, but they need to
+ *       have the same unit, value type, and tag. Deviations are computed in,
+ *       and returned as, the quantity type of @p lhs.
+ *
+ * @note Deviations that are NaN count as mismatches, but are never the
+ *       largest deviation.
+ *
+ * @note Both spans must have the same size.
+ */
+template<typename Q1, typename Q2, typename TT, typename TF, typename X, typename = detail::if_same_but_scale_t<std::remove_const_t<Q1>,std::remove_const_t<Q2>>>
+near_span_result<std::remove_const_t<Q1>> is_near_span(quantity_span<Q1> lhs, quantity_span<Q2> rhs, detail::tolerance_aux<TT,TF,X> tol)
+                                                                          {return detail::is_near_span(lhs, rhs, nullptr, detail::get_tol_val(tol));}
+template<typename Q1, typename Q2, typename TT1, typename TF1, typename TT2, typename TF2, typename X1, typename X2, typename = detail::if_same_but_scale_t<std::remove_const_t<Q1>,std::remove_const_t<Q2>>>
+near_span_result<std::remove_const_t<Q1>> is_near_span(quantity_span<Q1> lhs, quantity_span<Q2> rhs, detail::tolerance_aux<TT1,TF1,X1> tol1, detail::tolerance_aux<TT2,TF2,X2> tol2)
+                                                                          {return detail::is_near_span(lhs, rhs, nullptr, detail::get_tol_val(tol1,tol2));}
+template<typename Q1, typename Q2, typename TT, typename TF, typename X, typename = detail::if_same_but_scale_t<std::remove_const_t<Q1>,std::remove_const_t<Q2>>>
+near_span_result<std::remove_const_t<Q1>> is_near_span(quantity_span<Q1> lhs, quantity_span<Q2> rhs, unsigned char* mismatch_mask, detail::tolerance_aux<TT,TF,X> tol)
+                                                                          {return detail::is_near_span(lhs, rhs, mismatch_mask, detail::get_tol_val(tol));}
+template<typename Q1, typename Q2, typename TT1, typename TF1, typename TT2, typename TF2, typename X1, typename X2, typename = detail::if_same_but_scale_t<std::remove_const_t<Q1>,std::remove_const_t<Q2>>>
+near_span_result<std::remove_const_t<Q1>> is_near_span(quantity_span<Q1> lhs, quantity_span<Q2> rhs, unsigned char* mismatch_mask, detail::tolerance_aux<TT1,TF1,X1> tol1, detail::tolerance_aux<TT2,TF2,X2> tol2)
+                                                                          {return detail::is_near_span(lhs, rhs, mismatch_mask, detail::get_tol_val(tol1,tol2));}
+
+template<typename Q1, typename Q2, typename TT, typename TF, typename X, typename = detail::if_same_but_scale_t<std::remove_const_t<Q1>,std::remove_const_t<Q2>>>
+std::size_t find_not_near(quantity_span<Q1> lhs, quantity_span<Q2> rhs, detail::tolerance_aux<TT,TF,X> tol)
+                                                                          {return detail::find_not_near(lhs, rhs, detail::get_tol_val(tol));}
+template<typename Q1, typename Q2, typename TT1, typename TF1, typename TT2, typename TF2, typename X1, typename X2, typename = detail::if_same_but_scale_t<std::remove_const_t<Q1>,std::remove_const_t<Q2>>>
+std::size_t find_not_near(quantity_span<Q1> lhs, quantity_span<Q2> rhs, detail::tolerance_aux<TT1,TF1,X1> tol1, detail::tolerance_aux<TT2,TF2,X2> tol2)
+                                                                          {return detail::find_not_near(lhs, rhs, detail::get_tol_val(tol1,tol2));}
+/** @} */
+
 }
 
 #endif //UNLIB_MATH_HPP
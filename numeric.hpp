@@ -0,0 +1,561 @@
+#ifndef UNLIB_NUMERIC_HPP
+#define UNLIB_NUMERIC_HPP
+
+/*
+ * numeric.hpp
+ *
+ * Copyright sbi http://stackoverflow.com/users/140719
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *     http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+#include <unlib/quantity.hpp>
+#include <unlib/quantity_span.hpp>
+#include <unlib/math.hpp>
+
+namespace unlib {
+
+namespace detail {
+
+/* Sums are computed in sum_lanes independent partial sums, which the compiler
+ * keeps in SIMD registers without having to reorder additions. (Reordering
+ * is what it needs -ffast-math for when vectorizing a plain summing loop.)
+ * Sequences longer than pairwise_sum_base are split in halves, which are
+ * summed recursively. This bounds the rounding error by O(log(n)) ulps of the
+ * sum of the absolute values, instead of O(n) for summing one by one. */
+constexpr std::size_t sum_lanes         = math_block_size;
+constexpr std::size_t pairwise_sum_base = 16 * sum_lanes;
+
+template<typename V>
+V sum_lanes_total(const V (&lanes)[sum_lanes]) {
+	static_assert(sum_lanes == 8, "lanes are added pairwise");
+	return ((lanes[0]+lanes[1]) + (lanes[2]+lanes[3])) + ((lanes[4]+lanes[5]) + (lanes[6]+lanes[7]));
+}
+
+template<typename V>
+V sum_block(const V* in, std::size_t n) {
+	V lanes[sum_lanes] = {};
+	std::size_t idx = 0;
+	for(; idx+sum_lanes<=n; idx+=sum_lanes)
+		for(std::size_t lane=0; lane<sum_lanes; ++lane)
+			lanes[lane] += in[idx+lane];
+	V result = sum_lanes_total(lanes);
+	for(; idx<n; ++idx)
+		result += in[idx];
+	return result;
+}
+
+/* Sums the blocks [first,first+n) is split into pairwise, with
+ * sum_block(first,count) summing one block. How the range is split only
+ * depends on n. */
+template<typename V, typename SumBlock>
+V pairwise_sum_blocks(std::size_t first, std::size_t n, SumBlock sum_block) {
+	if(n <= pairwise_sum_base)
+		return sum_block(first, n);
+	const std::size_t half = n / 2 / sum_lanes * sum_lanes;
+	return pairwise_sum_blocks<V>(first, half, sum_block) + pairwise_sum_blocks<V>(first+half, n-half, sum_block);
+}
+
+template<typename V>
+V pairwise_sum(const V* in, std::size_t n)                                {return pairwise_sum_blocks<V>(0, n, [in](std::size_t first, std::size_t count){return sum_block(in+first, count);});}
+
+/* The trapezoidal rule, with the halving of the sums of adjacent values
+ * deferred until the end. For integer values this only truncates once.
+ *
+ * With its four loads per term, compilers do not keep the lanes for the sum
+ * of the trapezoids in registers (at least not at -O2), so where available,
+ * full blocks are summed using SIMD instructions directly. These compute
+ * the same lanes, so the results are identical. */
+template<typename V>
+void add_trapezoid_lanes(const V* values, const V* timestamps, std::size_t n, V (&lanes)[sum_lanes]) {
+	for(std::size_t idx=0; idx+sum_lanes<=n; idx+=sum_lanes)
+		for(std::size_t lane=0; lane<sum_lanes; ++lane)
+			lanes[lane] += (timestamps[idx+lane+1] - timestamps[idx+lane]) * (values[idx+lane] + values[idx+lane+1]);
+}
+
+#if defined(__AVX__)
+inline __m256d trapezoids(const double* values, const double* timestamps) {
+	return _mm256_mul_pd( _mm256_sub_pd(_mm256_loadu_pd(timestamps+1), _mm256_loadu_pd(timestamps))
+	                    , _mm256_add_pd(_mm256_loadu_pd(values    ), _mm256_loadu_pd(values+1  )) );
+}
+inline __m256 trapezoids(const float* values, const float* timestamps) {
+	return _mm256_mul_ps( _mm256_sub_ps(_mm256_loadu_ps(timestamps+1), _mm256_loadu_ps(timestamps))
+	                    , _mm256_add_ps(_mm256_loadu_ps(values    ), _mm256_loadu_ps(values+1  )) );
+}
+inline void add_trapezoid_lanes(const double* values, const double* timestamps, std::size_t n, double (&lanes)[sum_lanes]) {
+	__m256d lanes0 = _mm256_loadu_pd(lanes), lanes1 = _mm256_loadu_pd(lanes+4);
+	for(std::size_t idx=0; idx+sum_lanes<=n; idx+=sum_lanes) {
+		lanes0 = _mm256_add_pd(lanes0, trapezoids(values+idx  , timestamps+idx  ));
+		lanes1 = _mm256_add_pd(lanes1, trapezoids(values+idx+4, timestamps+idx+4));
+	}
+	_mm256_storeu_pd(lanes, lanes0); _mm256_storeu_pd(lanes+4, lanes1);
+}
+inline void add_trapezoid_lanes(const float* values, const float* timestamps, std::size_t n, float (&lanes)[sum_lanes]) {
+	__m256 lanes0 = _mm256_loadu_ps(lanes);
+	for(std::size_t idx=0; idx+sum_lanes<=n; idx+=sum_lanes)
+		lanes0 = _mm256_add_ps(lanes0, trapezoids(values+idx, timestamps+idx));
+	_mm256_storeu_ps(lanes, lanes0);
+}
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+inline __m128d trapezoids(const double* values, const double* timestamps) {
+	return _mm_mul_pd( _mm_sub_pd(_mm_loadu_pd(timestamps+1), _mm_loadu_pd(timestamps))
+	                 , _mm_add_pd(_mm_loadu_pd(values    ), _mm_loadu_pd(values+1  )) );
+}
+inline __m128 trapezoids(const float* values, const float* timestamps) {
+	return _mm_mul_ps( _mm_sub_ps(_mm_loadu_ps(timestamps+1), _mm_loadu_ps(timestamps))
+	                 , _mm_add_ps(_mm_loadu_ps(values    ), _mm_loadu_ps(values+1  )) );
+}
+inline void add_trapezoid_lanes(const double* values, const double* timestamps, std::size_t n, double (&lanes)[sum_lanes]) {
+	__m128d lanes0 = _mm_loadu_pd(lanes  ), lanes1 = _mm_loadu_pd(lanes+2);
+	__m128d lanes2 = _mm_loadu_pd(lanes+4), lanes3 = _mm_loadu_pd(lanes+6);
+	for(std::size_t idx=0; idx+sum_lanes<=n; idx+=sum_lanes) {
+		lanes0 = _mm_add_pd(lanes0, trapezoids(values+idx  , timestamps+idx  ));
+		lanes1 = _mm_add_pd(lanes1, trapezoids(values+idx+2, timestamps+idx+2));
+		lanes2 = _mm_add_pd(lanes2, trapezoids(values+idx+4, timestamps+idx+4));
+		lanes3 = _mm_add_pd(lanes3, trapezoids(values+idx+6, timestamps+idx+6));
+	}
+	_mm_storeu_pd(lanes  , lanes0); _mm_storeu_pd(lanes+2, lanes1);
+	_mm_storeu_pd(lanes+4, lanes2); _mm_storeu_pd(lanes+6, lanes3);
+}
+inline void add_trapezoid_lanes(const float* values, const float* timestamps, std::size_t n, float (&lanes)[sum_lanes]) {
+	__m128 lanes0 = _mm_loadu_ps(lanes), lanes1 = _mm_loadu_ps(lanes+4);
+	for(std::size_t idx=0; idx+sum_lanes<=n; idx+=sum_lanes) {
+		lanes0 = _mm_add_ps(lanes0, trapezoids(values+idx  , timestamps+idx  ));
+		lanes1 = _mm_add_ps(lanes1, trapezoids(values+idx+4, timestamps+idx+4));
+	}
+	_mm_storeu_ps(lanes, lanes0); _mm_storeu_ps(lanes+4, lanes1);
+}
+#endif
+
+template<typename V>
+V trapezoid_block(const V* values, const V* timestamps, std::size_t n) {
+	V lanes[sum_lanes] = {};
+	add_trapezoid_lanes(values, timestamps, n, lanes);
+	V result = sum_lanes_total(lanes);
+	for(std::size_t idx=n/sum_lanes*sum_lanes; idx<n; ++idx)
+		result += (timestamps[idx+1] - timestamps[idx]) * (values[idx] + values[idx+1]);
+	return result;
+}
+
+template<typename V>
+V trapezoid_sum(const V* values, const V* timestamps, std::size_t n) {
+	if(n < 2)
+		return V{};
+	return pairwise_sum_blocks<V>(0, n-1, [values,timestamps](std::size_t first, std::size_t count){return trapezoid_block(values+first, timestamps+first, count);}) / 2;
+}
+
+template<typename V>
+V trapezoid_sum(const V* values, std::size_t n, V step) {
+	if(n < 2)
+		return V{};
+	return step * (2 * pairwise_sum(values, n) - values[0] - values[n-1]) / 2;
+}
+
+template<typename Q1, typename Q2>
+using if_same_value_type_t = std::enable_if_t<std::is_same<typename Q1::value_type, typename Q2::value_type>::value>;
+
+/* Difference quotients of consecutive values, with the rescaling to the
+ * result's scale folded into one factor applied to the differences. The
+ * differences are computed in the values' type, so integer counters can wrap
+ * (delta() takes care of that), and only then converted to the result type.
+ * The blocks through a local buffer are for the same reason as in
+ * transform_values(). */
+template<typename NewScale, typename OldScale, typename V, typename R, typename Delta>
+void difference_quotients(const V* values, const V* timestamps, std::size_t n, R* out, Delta delta) {
+	const auto quotient = [=](std::size_t idx) {
+		return rescale_value<NewScale,OldScale>(static_cast<R>(delta(values[idx], values[idx+1])))
+		     / static_cast<R>(timestamps[idx+1] - timestamps[idx]);
+	};
+	std::size_t idx = 0;
+	for(; idx+math_block_size<=n; idx+=math_block_size) {
+		R block[math_block_size];
+		for(std::size_t blk=0; blk<math_block_size; ++blk)
+			block[blk] = quotient(idx+blk);
+		for(std::size_t blk=0; blk<math_block_size; ++blk)
+			out[idx+blk] = block[blk];
+	}
+	for(; idx<n; ++idx)
+		out[idx] = quotient(idx);
+}
+
+struct difference {
+	template<typename V>
+	constexpr V operator()(V prev, V next)                          const {return static_cast<V>(next - prev);}
+};
+
+/* Counters wrapping at modulus (i.e., going from modulus-1 to 0) */
+template<typename V>
+struct wrapping_difference {
+	V modulus;
+	constexpr V operator()(V prev, V next)                          const {return static_cast<V>(next < prev ? next + (modulus - prev) : next - prev);}
+};
+
+template<typename Q, typename T, typename R>
+void check_differentiate_types() {
+	using value_type = typename Q::value_type;
+	using  rate_type = div_quantity_t<Q,T>;
+	static_assert(detail::is_same_v<value_type, typename T::value_type>, "values and timestamps must have the same value type");
+	static_assert(are_units_compatible_v<typename rate_type::unit_type, typename R::unit_type>, "fundamentally incompatible units");
+	static_assert(detail::is_same_v<typename rate_type::tag_type, typename R::tag_type>, "different unit tags (use tag_cast)");
+	static_assert( detail::is_same_v<value_type, typename R::value_type>
+	            or (std::is_integral<value_type>::value and std::is_floating_point<typename R::value_type>::value)
+	             , "rates must have the values' value type (or a floating point type for integer values)" );
+}
+
+/* Compensated summation: the rounding error of each addition is computed
+ * exactly and accumulated separately. The error is computed using Knuth's
+ * TwoSum, which (unlike Kahan's original algorithm) also works if the added
+ * value is larger than the sum, as does Neumaier's variant. Unlike the
+ * latter, it does not need to compare magnitudes, so it can be vectorized.
+ * The error of the result is bounded by 2 ulps of the sum of the absolute
+ * values (plus a term in n*eps² that is negligible for any practical n), no
+ * matter how many values are added.
+ *
+ * The compensation relies on the exact IEEE semantics of the additions, so
+ * this must not be compiled with -ffast-math (or /fp:fast) or similar. */
+template<typename V>
+void compensated_add(V& sum, V& compensation, V v) {
+	const V t  = sum + v;
+	const V vt = t - sum;
+	compensation += (sum - (t - vt)) + (v - vt);
+	sum = t;
+}
+
+/* The minimum and maximum are searched in lanes, too, which compilers turn
+ * into SIMD min/max instructions. Their index is then found in a second pass,
+ * which checks whole blocks for the value before looking at single values. */
+template<typename V, typename Better>
+V extreme_value(const V* in, std::size_t n, Better better) {
+	V result = in[0];
+	std::size_t idx = 1;
+	if(n >= 2*sum_lanes) {
+		V lanes[sum_lanes];
+		for(std::size_t lane=0; lane<sum_lanes; ++lane)
+			lanes[lane] = in[lane];
+		for(idx=sum_lanes; idx+sum_lanes<=n; idx+=sum_lanes)
+			for(std::size_t lane=0; lane<sum_lanes; ++lane)
+				lanes[lane] = better(in[idx+lane], lanes[lane]) ? in[idx+lane] : lanes[lane];
+		result = lanes[0];
+		for(std::size_t lane=1; lane<sum_lanes; ++lane)
+			result = better(lanes[lane], result) ? lanes[lane] : result;
+	}
+	for(; idx<n; ++idx)
+		result = better(in[idx], result) ? in[idx] : result;
+	return result;
+}
+
+template<typename V>
+std::size_t find_value(const V* in, std::size_t n, V value) {
+	std::size_t idx = 0;
+	for(; idx+sum_lanes<=n; idx+=sum_lanes) {
+		bool found = false;
+		for(std::size_t lane=0; lane<sum_lanes; ++lane)
+			found |= in[idx+lane] == value;
+		if(found)
+			break;
+	}
+	for(; idx<n; ++idx)
+		if(in[idx] == value)
+			return idx;
+	return n;
+}
+
+struct less_than    { template<typename V> constexpr bool operator()(V lhs, V rhs) const {return lhs < rhs;} };
+struct greater_than { template<typename V> constexpr bool operator()(V lhs, V rhs) const {return rhs < lhs;} };
+
+template<typename V>
+void compensated_sum(const V* in, std::size_t n, V& sum, V& compensation) {
+	V sums[sum_lanes] = {}, compensations[sum_lanes] = {};
+	std::size_t idx = 0;
+	for(; idx+sum_lanes<=n; idx+=sum_lanes)
+		for(std::size_t lane=0; lane<sum_lanes; ++lane)
+			compensated_add(sums[lane], compensations[lane], in[idx+lane]);
+	for(; idx<n; ++idx)
+		compensated_add(sum, compensation, in[idx]);
+	for(std::size_t lane=0; lane<sum_lanes; ++lane) {
+		compensated_add(sum, compensation, sums[lane]);
+		compensation += compensations[lane];
+	}
+}
+
+}
+
+/**
+ * @brief Sum a sequence of quantities
+ *
+ * This adds all quantities in @p in and returns the result as a quantity of
+ * the same type. For floating point values the sum is computed pairwise in
+ * a vectorized loop, which is both faster and more accurate than adding the
+ * quantities one by one: the rounding error grows with the logarithm of the
+ * number of quantities, rather than linearly. (Use compensated_sum() where
+ * that is not good enough.) Integer sums are exact, as long as they do not
+ * overflow.
+ *
+ * @param in  quantities to add
+ *
+ * @return the sum of all quantities (zero for an empty span)
+ *
+ * @note To get the sum in another scale, convert the result, rather than the
+ *       quantities. This rescales only once.
+ *
+ * @code
+ * const kilo<watt_hour<double>> total = sum(make_quantity_span(watt_seconds));
+ */
+template<typename Q>
+std::remove_const_t<Q> sum(quantity_span<Q> in)                           {return std::remove_const_t<Q>{detail::pairwise_sum(in.values(), in.size())};}
+
+/**
+ * @brief Average of a sequence of quantities
+ *
+ * @param in  quantities to average (must not be empty)
+ *
+ * @return sum(in) divided by the number of quantities
+ *
+ * @note For integer value types the result is truncated.
+ */
+template<typename Q>
+std::remove_const_t<Q> mean(quantity_span<Q> in) {
+	using value_type = typename quantity_span<Q>::value_type;
+	assert(not in.empty());
+	return std::remove_const_t<Q>{static_cast<value_type>(detail::pairwise_sum(in.values(), in.size()) / static_cast<value_type>(in.size()))};
+}
+
+/**
+ * @{
+ *
+ * @brief Minimum and maximum of a sequence of quantities
+ *
+ * min() and max() return the smallest and the largest quantity, argmin() and
+ * argmax() the index of the first occurrence of it. They are computed in
+ * vectorized loops.
+ *
+ * @param in  quantities to search (must not be empty)
+ *
+ * @note The results are unspecified if @p in contains NaNs.
+ */
+template<typename Q>
+std::remove_const_t<Q> min(quantity_span<Q> in)                           {assert(not in.empty()); return std::remove_const_t<Q>{detail::extreme_value(in.values(), in.size(), detail::less_than   {})};}
+template<typename Q>
+std::remove_const_t<Q> max(quantity_span<Q> in)                           {assert(not in.empty()); return std::remove_const_t<Q>{detail::extreme_value(in.values(), in.size(), detail::greater_than{})};}
+
+template<typename Q>
+std::size_t argmin(quantity_span<Q> in)                                   {return detail::find_value(in.values(), in.size(), min(in).get());}
+template<typename Q>
+std::size_t argmax(quantity_span<Q> in)                                   {return detail::find_value(in.values(), in.size(), max(in).get());}
+/** @} */
+
+/**
+ * @{
+ *
+ * @brief Integrate a sampled quantity over time
+ *
+ * This integrates quantities sampled at the times given by @p timestamps
+ * (or at uniform time steps of @p step) using the trapezoidal rule, e.g.,
+ * power samples to energy. The result is of the type multiplying a quantity
+ * by a time yields. If a result type is specified, the result is converted
+ * to that. Either way, the samples are not rescaled; the scales are only
+ * taken into account for the result. The products and sums are computed in
+ * a vectorized loop, and summed pairwise (@sa sum()).
+ *
+ * @tparam Result  the quantity type of the result (optional)
+ *
+ * @param     values  sampled quantities
+ * @param timestamps  times the quantities were sampled at (same size as
+ *                    @p values, ascending)
+ * @param       step  time between two samples
+ *
+ * @return the integral over all samples (zero for less than two samples)
+ *
+ * @note The quantities and times must have the same value type. For integer
+ *       value types, the result is truncated once, at the end.
+ *
+ * @code
+ * const auto power = make_quantity_span(watt_samples);    // watt<double>
+ * const auto times = make_quantity_span(sample_times);    // second<double>
+ * const auto energy = integrate<kilo<watt_hour<double>>>(power, times);
+ */
+template<typename Q, typename T, typename = detail::if_same_value_type_t<std::remove_const_t<Q>,std::remove_const_t<T>>>
+mul_quantity_t<std::remove_const_t<Q>,std::remove_const_t<T>> integrate(quantity_span<Q> values, quantity_span<T> timestamps) {
+	using result_type = mul_quantity_t<std::remove_const_t<Q>,std::remove_const_t<T>>;
+	assert(values.size() == timestamps.size());
+	return result_type{detail::trapezoid_sum(values.values(), timestamps.values(), values.size())};
+}
+template<typename Q, typename T, typename = std::enable_if_t<is_quantity<T>::value>, typename = detail::if_same_value_type_t<std::remove_const_t<Q>,T>>
+mul_quantity_t<std::remove_const_t<Q>,T> integrate(quantity_span<Q> values, T step) {
+	using result_type = mul_quantity_t<std::remove_const_t<Q>,T>;
+	return result_type{detail::trapezoid_sum(values.values(), values.size(), step.get())};
+}
+
+template<typename Result, typename Q, typename T>
+Result integrate(quantity_span<Q> values, quantity_span<T> timestamps)    {return integrate(values, timestamps);}
+template<typename Result, typename Q, typename T, typename = std::enable_if_t<is_quantity<T>::value>>
+Result integrate(quantity_span<Q> values, T step)                         {return integrate(values, step);}
+/** @} */
+
+/**
+ * @{
+ *
+ * @brief Differentiate a sampled quantity with respect to time
+ *
+ * This computes the rates of change between consecutive samples, e.g. the
+ * power from the readings of an energy register: out[i] is the difference of
+ * values[i+1] and values[i], divided by the time elapsed between them. The
+ * rates must be of the unit dividing a quantity by a time yields, but can be
+ * of any scale. The values are not rescaled; instead the conversion to the
+ * rates' scale is folded into a single factor applied to the differences.
+ * The computation is done in a vectorized loop.
+ *
+ * For integer values, the rates can be of a floating point type, as the
+ * differences are computed as integers first. Unsigned counters wrapping
+ * around at the end of their value type's range are taken care of by this.
+ * For counters wrapping around at another value, pass that as @p modulus:
+ * If a value is smaller than its predecessor, the counter is assumed to have
+ * passed modulus, and wrapped to zero.
+ *
+ * @param     values  sampled quantities
+ * @param timestamps  times the quantities were sampled at (same size as
+ *                    @p values, strictly ascending)
+ * @param        out  rates to write (one less than the number of values)
+ * @param    modulus  value integer counters wrap around at
+ *
+ * @code
+ * const auto energy = make_quantity_span(register_readings); // watt_hour<double>
+ * const auto times  = make_quantity_span(reading_times);     // second<double>
+ * std::vector<watt<double>> power(energy.size()-1);
+ * differentiate(energy, times, make_quantity_span(power));
+ */
+template<typename Q, typename T, typename R>
+void differentiate(quantity_span<Q> values, quantity_span<T> timestamps, quantity_span<R> out) {
+	using rate_type = div_quantity_t<std::remove_const_t<Q>,std::remove_const_t<T>>;
+	detail::check_differentiate_types<std::remove_const_t<Q>,std::remove_const_t<T>,R>();
+	assert(values.size() == timestamps.size() and out.size()+1 == std::max<std::size_t>(values.size(),1));
+	detail::difference_quotients<typename R::scale_type,typename rate_type::scale_type>( values.values(), timestamps.values(), out.size(), out.values()
+	                                                                                   , detail::difference{} );
+}
+template<typename Q, typename T, typename R>
+void differentiate(quantity_span<Q> values, quantity_span<T> timestamps, quantity_span<R> out, std::remove_const_t<Q> modulus) {
+	using rate_type = div_quantity_t<std::remove_const_t<Q>,std::remove_const_t<T>>;
+	using value_type = typename quantity_span<Q>::value_type;
+	static_assert(std::is_integral<value_type>::value, "only integer counters wrap around");
+	detail::check_differentiate_types<std::remove_const_t<Q>,std::remove_const_t<T>,R>();
+	assert(values.size() == timestamps.size() and out.size()+1 == std::max<std::size_t>(values.size(),1));
+	detail::difference_quotients<typename R::scale_type,typename rate_type::scale_type>( values.values(), timestamps.values(), out.size(), out.values()
+	                                                                                   , detail::wrapping_difference<value_type>{modulus.get()} );
+}
+/** @} */
+
+/**
+ * @brief Accumulator adding quantities using compensated summation
+ *
+ * This adds quantities using a variant of Kahan summation, which keeps
+ * track of the rounding errors of the additions and adds them to the result.
+ * The result is as accurate as if the quantities were added with twice the
+ * precision of their value type, independent of the number of quantities
+ * added. This comes at the cost of about four times as many operations as
+ * naive adding, which add() reduces by processing sequences of quantities
+ * in vectorized loops.
+ *
+ * Partial sums (e.g., computed by different threads) can be combined using
+ * merge().
+ *
+ * @tparam Q  the quantity type to accumulate (value type must be floating
+ *            point)
+ *
+ * @note Quantities of other scales are rescaled before they are added. When
+ *       a sequence of quantities of another scale is added, its sum is
+ *       rescaled, rather than every single quantity.
+ *
+ * @note The compensation relies on exact IEEE floating point semantics, so
+ *       code using this must not be compiled with -ffast-math or similar.
+ *
+ * @code
+ * kahan_accumulator<kilo<watt_hour<double>>> energy;
+ * for(const auto& chunk : chunks_of_watt_seconds)
+ *     energy.add(make_quantity_span(chunk));
+ * report(energy.sum());
+ */
+template<typename Q>
+class kahan_accumulator {
+public:
+	using quantity_type = Q;                                              /**< the accumulated quantity type      */
+	using     unit_type = typename quantity_type:: unit_type;             /**< the quantities' unit type          */
+	using    scale_type = typename quantity_type::scale_type;             /**< the quantities' scale              */
+	using    value_type = typename quantity_type::value_type;             /**< the quantities' value type         */
+	using      tag_type = typename quantity_type::  tag_type;             /**< the quantities' tag                */
+
+	static_assert(is_quantity<quantity_type>::value, "kahan_accumulator must accumulate quantities");
+	static_assert(std::is_floating_point<value_type>::value, "compensated summation needs floating point values");
+
+	/**
+	 * @{
+	 *
+	 * @brief Constructors
+	 *
+	 * @param initial  initial sum (zero by default)
+	 */
+	constexpr kahan_accumulator()                                         : sum_{}, compensation_{} {}
+	constexpr explicit kahan_accumulator(const quantity_type& initial)    : sum_{initial.get()}, compensation_{} {}
+	/** @} */
+
+	/** @{ add or subtract a single quantity */
+	kahan_accumulator& operator+=(const quantity_type& q)                 {detail::compensated_add(sum_, compensation_,  q.get()); return *this;}
+	kahan_accumulator& operator-=(const quantity_type& q)                 {detail::compensated_add(sum_, compensation_, -q.get()); return *this;}
+	/** @} */
+
+	/**
+	 * @brief Add a sequence of quantities
+	 *
+	 * @param in  quantities to add (of any scale)
+	 */
+	template<typename Q2, typename = detail::if_same_but_scale_t<quantity_type,std::remove_const_t<Q2>>>
+	kahan_accumulator& add(quantity_span<Q2> in) {
+		using other_scale = typename quantity_span<Q2>::scale_type;
+		value_type partial_sum{}, partial_compensation{};
+		detail::compensated_sum(in.values(), in.size(), partial_sum, partial_compensation);
+		detail::compensated_add(sum_, compensation_, detail::rescale_value<scale_type,other_scale>(partial_sum));
+		compensation_ += detail::rescale_value<scale_type,other_scale>(partial_compensation);
+		return *this;
+	}
+
+	/**
+	 * @brief Add another accumulator's sum
+	 *
+	 * @param other  accumulator to merge into this one
+	 */
+	kahan_accumulator& merge(const kahan_accumulator& other) {
+		detail::compensated_add(sum_, compensation_, other.sum_);
+		compensation_ += other.compensation_;
+		return *this;
+	}
+
+	/** the sum of all added quantities */
+	constexpr quantity_type sum()                                   const {return quantity_type{sum_ + compensation_};}
+
+private:
+	value_type                                        sum_;
+	value_type                                        compensation_;
+};
+
+/**
+ * @brief Sum a sequence of quantities using compensated summation
+ *
+ * This is a shorthand for adding all quantities in @p in to a
+ * kahan_accumulator, and returning its sum.
+ *
+ * @param in  quantities to add
+ *
+ * @return the sum of all quantities (zero for an empty span)
+ */
+template<typename Q>
+std::remove_const_t<Q> compensated_sum(quantity_span<Q> in)               {return kahan_accumulator<std::remove_const_t<Q>>{}.add(in).sum();}
+
+}
+
+#endif //UNLIB_NUMERIC_HPP
@@ -0,0 +1,334 @@
+#ifndef UNLIB_PARALLEL_HPP
+#define UNLIB_PARALLEL_HPP
+
+/*
+ * parallel.hpp
+ *
+ * Copyright sbi http://stackoverflow.com/users/140719
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *     http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <unlib/quantity.hpp>
+#include <unlib/quantity_span.hpp>
+#include <unlib/numeric.hpp>
+
+namespace unlib {
+
+/**
+ * @brief Pool of threads the parallel algorithms split their work across
+ *
+ * A pool of concurrency()-1 worker threads, which are started when the pool
+ * is created, and which wait for work until it is destroyed. The thread
+ * invoking run() participates in the work, so a pool with a concurrency of
+ * one does not start any threads at all.
+ *
+ * Splitting work only pays off if every thread gets enough of it, so the
+ * parallel algorithms do not give any thread less than min_chunk_size()
+ * quantities. Inputs smaller than twice that are processed by the calling
+ * thread only, using the same vectorized loops as the sequential algorithms.
+ *
+ * @note run() can be called from several threads, but these calls are
+ *       serialized. Tasks must not call run() on the pool executing them.
+ */
+class thread_pool {
+public:
+	/** the minimum number of quantities per thread used by default */
+	static constexpr std::size_t default_min_chunk_size = 32768;
+
+	/**
+	 * @brief Create a thread pool
+	 *
+	 * @param    concurrency  number of threads working on a task, including
+	 *                        the one calling run() (by default the number of
+	 *                        hardware threads)
+	 * @param min_chunk_size  minimum number of quantities processed by one
+	 *                        thread
+	 */
+	explicit thread_pool( std::size_t concurrency    = default_concurrency()
+	                    , std::size_t min_chunk_size = default_min_chunk_size )
+	                                                                      : min_chunk_size_{std::max<std::size_t>(min_chunk_size,1)} {
+		for(std::size_t idx=1; idx<concurrency; ++idx)
+			workers_.emplace_back([this]{work();});
+	}
+
+	thread_pool(const thread_pool&)            = delete;
+	thread_pool& operator=(const thread_pool&) = delete;
+
+	~thread_pool() {
+		{
+			std::lock_guard<std::mutex> lock{mutex_};
+			stop_ = true;
+		}
+		start_.notify_all();
+		for(auto& worker : workers_)
+			worker.join();
+	}
+
+	/** number of hardware threads (at least one) */
+	static std::size_t default_concurrency()                              {return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);}
+
+	/** number of threads working on a task, including the one calling run() */
+	std::size_t concurrency()                                       const {return workers_.size() + 1;}
+
+	/** minimum number of quantities the parallel algorithms give a thread */
+	std::size_t min_chunk_size()                                    const {return min_chunk_size_;}
+
+	/**
+	 * @brief Invoke a function for a number of tasks
+	 *
+	 * This invokes @p f(idx) for every idx in [0,tasks), distributed over the
+	 * pool's threads, and returns when all invocations have returned. If any
+	 * of them throws, the first exception caught is rethrown.
+	 *
+	 * @param tasks  number of invocations
+	 * @param     f  function to invoke
+	 */
+	template<typename F>
+	void run(std::size_t tasks, F&& f) {
+		using function_type = std::remove_reference_t<F>;
+		std::lock_guard<std::mutex> run_lock{run_mutex_};
+		{
+			std::lock_guard<std::mutex> lock{mutex_};
+			job_     = {[](void* fn, std::size_t idx){(*static_cast<function_type*>(fn))(idx);}, &f, tasks};
+			next_    = 0;
+			busy_    = workers_.size();
+			error_   = nullptr;
+			++generation_;
+		}
+		start_.notify_all();
+		execute(job_);
+		std::unique_lock<std::mutex> lock{mutex_};
+		done_.wait(lock, [this]{return busy_ == 0;});
+		if(error_)
+			std::rethrow_exception(error_);
+	}
+
+private:
+	struct job {
+		void                                     (*invoke)(void*, std::size_t);
+		void*                                      function;
+		std::size_t                                tasks;
+	};
+
+	void execute(const job& j) {
+		for(std::size_t idx=next_++; idx<j.tasks; idx=next_++) {
+			try {
+				j.invoke(j.function, idx);
+			} catch(...) {
+				std::lock_guard<std::mutex> lock{mutex_};
+				if(not error_)
+					error_ = std::current_exception();
+			}
+		}
+	}
+
+	void work() {
+		std::size_t generation = 0;
+		for(;;) {
+			job j;
+			{
+				std::unique_lock<std::mutex> lock{mutex_};
+				start_.wait(lock, [&]{return stop_ or generation_ != generation;});
+				if(stop_)
+					return;
+				generation = generation_;
+				j = job_;
+			}
+			execute(j);
+			std::lock_guard<std::mutex> lock{mutex_};
+			if(--busy_ == 0)
+				done_.notify_one();
+		}
+	}
+
+	std::size_t                                       min_chunk_size_;
+	std::vector<std::thread>                          workers_;
+
+	std::mutex                                        run_mutex_;
+	std::mutex                                        mutex_;
+	std::condition_variable                           start_;
+	std::condition_variable                           done_;
+	job                                               job_{nullptr, nullptr, 0};
+	std::atomic<std::size_t>                          next_{0};
+	std::size_t                                       busy_{0};
+	std::size_t                                       generation_{0};
+	std::exception_ptr                                error_;
+	bool                                              stop_{false};
+};
+
+namespace detail {
+
+/* Number of chunks to split n quantities into. Using more chunks than
+ * threads evens out differences in how fast threads get through theirs. */
+inline std::size_t parallel_chunks(const thread_pool& pool, std::size_t n) {
+	constexpr std::size_t chunks_per_thread = 4;
+	const std::size_t chunks = std::min(pool.concurrency() * chunks_per_thread, n / pool.min_chunk_size());
+	return pool.concurrency() > 1 ? chunks : std::min<std::size_t>(chunks, 1);
+}
+
+/* Invokes f(first, count) for consecutive chunks of n values, and returns the
+ * results in order. Chunk boundaries are multiples of sum_lanes. */
+template<typename F>
+auto map_chunks(thread_pool& pool, std::size_t n, std::size_t chunks, F f) {
+	const std::size_t chunk_size = (n / chunks + sum_lanes - 1) / sum_lanes * sum_lanes;
+	chunks = (n + chunk_size - 1) / chunk_size;
+	std::vector<decltype(f(std::size_t{}, std::size_t{}))> results(chunks);
+	pool.run(chunks, [&](std::size_t chunk) {
+		const std::size_t first = chunk * chunk_size;
+		results[chunk] = f(first, std::min(chunk_size, n - first));
+	});
+	return results;
+}
+
+/* The parallel sum splits the values exactly like pairwise_sum() does, down
+ * to a depth which gives enough chunks, sums these in parallel, and then
+ * adds the partial sums in the same order pairwise_sum() does. So the result
+ * is identical to the sequential sum, no matter how many threads are used. */
+template<typename V>
+void pairwise_sum_leaves(const V* in, std::size_t n, unsigned depth, std::vector<std::pair<const V*,std::size_t>>& leaves) {
+	if(depth == 0 or n <= pairwise_sum_base) {
+		leaves.emplace_back(in, n);
+		return;
+	}
+	const std::size_t half = n / 2 / sum_lanes * sum_lanes;
+	pairwise_sum_leaves(in     , half  , depth-1, leaves);
+	pairwise_sum_leaves(in+half, n-half, depth-1, leaves);
+}
+
+template<typename V>
+V pairwise_sum_combine(std::size_t n, unsigned depth, const V*& partial) {
+	if(depth == 0 or n <= pairwise_sum_base)
+		return *partial++;
+	const std::size_t half = n / 2 / sum_lanes * sum_lanes;
+	const V lhs = pairwise_sum_combine(half  , depth-1, partial);
+	const V rhs = pairwise_sum_combine(n-half, depth-1, partial);
+	return lhs + rhs;
+}
+
+template<typename V>
+V parallel_sum(thread_pool& pool, const V* in, std::size_t n) {
+	const std::size_t chunks = parallel_chunks(pool, n);
+	if(chunks <= 1)
+		return pairwise_sum(in, n);
+	unsigned depth = 0;
+	while((std::size_t{1} << depth) < chunks)
+		++depth;
+	std::vector<std::pair<const V*,std::size_t>> leaves;
+	pairwise_sum_leaves(in, n, depth, leaves);
+	std::vector<V> partials(leaves.size());
+	pool.run(leaves.size(), [&](std::size_t idx){partials[idx] = pairwise_sum(leaves[idx].first, leaves[idx].second);});
+	const V* partial = partials.data();
+	return pairwise_sum_combine(n, depth, partial);
+}
+
+template<typename V, typename Better>
+V parallel_extreme(thread_pool& pool, const V* in, std::size_t n, Better better) {
+	const std::size_t chunks = parallel_chunks(pool, n);
+	if(chunks <= 1)
+		return extreme_value(in, n, better);
+	const auto results = map_chunks(pool, n, chunks, [&](std::size_t first, std::size_t count){return extreme_value(in+first, count, better);});
+	return extreme_value(results.data(), results.size(), better);
+}
+
+template<typename V, typename Better>
+std::pair<V,std::size_t> parallel_arg_extreme(thread_pool& pool, const V* in, std::size_t n, Better better) {
+	const std::size_t chunks = parallel_chunks(pool, n);
+	if(chunks <= 1) {
+		const V value = extreme_value(in, n, better);
+		return {value, find_value(in, n, value)};
+	}
+	const auto results = map_chunks(pool, n, chunks, [&](std::size_t first, std::size_t count) {
+		const V value = extreme_value(in+first, count, better);
+		return std::make_pair(value, first + find_value(in+first, count, value));
+	});
+	auto result = results.front();
+	for(const auto& r : results)
+		if(better(r.first, result.first))
+			result = r;
+	return result;
+}
+
+}
+
+/**
+ * @{
+ *
+ * @brief Parallel reductions of sequences of quantities
+ *
+ * These compute the same results as the sequential algorithms of the same
+ * names, but split the quantities into chunks which are processed by the
+ * threads of @p pool, using the same vectorized loops. (Inputs too small to
+ * be split are processed by the calling thread only.)
+ *
+ * sum() and mean() yield results identical to the sequential algorithms, no
+ * matter how many threads are used. compensated_sum() merges per-chunk
+ * kahan_accumulator objects; its result is just as accurate as the
+ * sequential one, but might differ in the last bit.
+ *
+ * @param pool  threads to distribute the work across
+ * @param   in  quantities to reduce (must not be empty for mean(), min(),
+ *              max(), argmin(), and argmax())
+ *
+ * @note The results of min(), max(), argmin(), and argmax() are unspecified
+ *       if @p in contains NaNs.
+ *
+ * @code
+ * thread_pool pool;
+ * const auto peak = max(pool, make_quantity_span(feeder_power));
+ */
+template<typename Q>
+std::remove_const_t<Q> sum(thread_pool& pool, quantity_span<Q> in)        {return std::remove_const_t<Q>{detail::parallel_sum(pool, in.values(), in.size())};}
+
+template<typename Q>
+std::remove_const_t<Q> compensated_sum(thread_pool& pool, quantity_span<Q> in) {
+	using accumulator = kahan_accumulator<std::remove_const_t<Q>>;
+	const std::size_t chunks = detail::parallel_chunks(pool, in.size());
+	if(chunks <= 1)
+		return compensated_sum(in);
+	const auto partials = detail::map_chunks(pool, in.size(), chunks, [&](std::size_t first, std::size_t count) {
+		accumulator partial;
+		partial.add(in.subspan(first, count));
+		return partial;
+	});
+	accumulator result;
+	for(const auto& partial : partials)
+		result.merge(partial);
+	return result.sum();
+}
+
+template<typename Q>
+std::remove_const_t<Q> mean(thread_pool& pool, quantity_span<Q> in) {
+	using value_type = typename quantity_span<Q>::value_type;
+	assert(not in.empty());
+	return std::remove_const_t<Q>{static_cast<value_type>(detail::parallel_sum(pool, in.values(), in.size()) / static_cast<value_type>(in.size()))};
+}
+
+template<typename Q>
+std::remove_const_t<Q> min(thread_pool& pool, quantity_span<Q> in)        {assert(not in.empty()); return std::remove_const_t<Q>{detail::parallel_extreme    (pool, in.values(), in.size(), detail::less_than   {})};}
+template<typename Q>
+std::remove_const_t<Q> max(thread_pool& pool, quantity_span<Q> in)        {assert(not in.empty()); return std::remove_const_t<Q>{detail::parallel_extreme    (pool, in.values(), in.size(), detail::greater_than{})};}
+
+template<typename Q>
+std::size_t argmin(thread_pool& pool, quantity_span<Q> in)                {assert(not in.empty()); return detail::parallel_arg_extreme(pool, in.values(), in.size(), detail::less_than   {}).second;}
+template<typename Q>
+std::size_t argmax(thread_pool& pool, quantity_span<Q> in)                {assert(not in.empty()); return detail::parallel_arg_extreme(pool, in.values(), in.size(), detail::greater_than{}).second;}
+/** @} */
+
+}
+
+#endif //UNLIB_PARALLEL_HPP
@@ -0,0 +1,522 @@
+#ifndef UNLIB_QUANTILE_SKETCH_HPP
+#define UNLIB_QUANTILE_SKETCH_HPP
+
+/*
+ * quantile_sketch.hpp
+ *
+ * Copyright sbi http://stackoverflow.com/users/140719
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *     http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <unlib/quantity.hpp>
+#include <unlib/quantity_span.hpp>
+#include <unlib/quantity_columns.hpp>
+
+namespace unlib {
+
+/**
+ * @brief Error thrown when reading serialized quantile sketches that are
+ *        malformed or do not match the quantities requested
+ */
+class sketch_format_error : public std::runtime_error {
+public:
+	using std::runtime_error::runtime_error;
+};
+
+/** header of a serialized quantile sketch */
+struct quantile_sketch_header {
+	char          magic[8];        /**< "UNLIBQSK" */
+	std::uint32_t byte_order;      /**< byte_order_mark, as written by the writer */
+	std::uint32_t version;         /**< format version */
+	std::uint64_t exponents;       /**< unit and tag exponents, as in dynamic_unit::get_exponents_word() */
+	std::int64_t  scale_num;       /**< numerator of the quantities' scale */
+	std::int64_t  scale_den;       /**< denominator of the quantities' scale */
+	std::uint8_t  value_kind;      /**< a column_value_kind */
+	std::uint8_t  value_size;      /**< sizeof the value type */
+	std::uint8_t  tag_id;          /**< tag id (@sa dynamic_tag_id) */
+	std::uint8_t  reserved[5];
+	double        compression;     /**< the sketch's compression */
+	std::uint64_t count;           /**< number of quantities inserted */
+	std::uint64_t centroid_count;  /**< number of centroids following */
+
+	static constexpr std::uint32_t byte_order_mark = 0x01020304u;
+	static constexpr std::uint32_t current_version = 1;
+};
+
+static_assert(sizeof(quantile_sketch_header) == 72, "quantile sketch header must not have padding");
+
+namespace detail {
+
+/* a cluster of adjacent quantities, represented by their mean */
+template<typename V>
+struct sketch_centroid {
+	V             mean;
+	std::uint64_t weight;
+};
+
+template<typename V>
+bool operator<(const sketch_centroid<V>& lhs, const sketch_centroid<V>& rhs)
+                                                                          {return lhs.mean < rhs.mean;}
+
+/* Sorting the buffer is what inserting quantities costs. Floating point
+ * values are sorted using an LSD radix sort on unsigned integer keys of the
+ * same size, which order like the values: positive values get their sign
+ * bit set, negative values all their bits flipped. Passes over bytes all
+ * keys share are skipped. This is about 1.5 times faster than std::sort(),
+ * which is used for other value types. */
+template<typename V>
+struct radix_key                                                          {using type = unsigned char; static constexpr bool is_sortable = false;};
+template<>
+struct radix_key<float>                                                   {using type = std::uint32_t; static constexpr bool is_sortable = true;};
+template<>
+struct radix_key<double>                                                  {using type = std::uint64_t; static constexpr bool is_sortable = true;};
+
+template<typename V>
+using radix_key_t = typename radix_key<V>::type;
+
+template<typename K, typename V>
+K to_radix_key(V value) {
+	K bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits ^ ((K{0} - (bits >> (sizeof(K)*8-1))) | (K{1} << (sizeof(K)*8-1)));
+}
+template<typename V, typename K>
+V from_radix_key(K key) {
+	const K bits = key ^ (((key >> (sizeof(K)*8-1)) - K{1}) | (K{1} << (sizeof(K)*8-1)));
+	V value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+/* sorts n values, using keys (of 2*n elements) as scratch memory */
+template<typename V>
+void sort_values(V* values, std::size_t n, radix_key_t<V>* keys, std::true_type) {
+	using key_type = radix_key_t<V>;
+	std::uint32_t counts[sizeof(key_type)][256] = {};
+	key_type* src = keys;
+	key_type* dst = keys + n;
+	for(std::size_t idx=0; idx<n; ++idx) {
+		const key_type key = to_radix_key<key_type>(values[idx]);
+		src[idx] = key;
+		for(std::size_t byte=0; byte<sizeof(key_type); ++byte)
+			++counts[byte][(key >> (8*byte)) & 0xFF];
+	}
+	for(std::size_t byte=0; byte<sizeof(key_type); ++byte) {
+		std::uint32_t* offsets = counts[byte];
+		if(offsets[(src[0] >> (8*byte)) & 0xFF] == n)
+			continue;
+		std::uint32_t offset = 0;
+		for(std::size_t digit=0; digit<256; ++digit) {
+			const std::uint32_t count = offsets[digit];
+			offsets[digit] = offset;
+			offset += count;
+		}
+		for(std::size_t idx=0; idx<n; ++idx)
+			dst[offsets[(src[idx] >> (8*byte)) & 0xFF]++] = src[idx];
+		std::swap(src, dst);
+	}
+	for(std::size_t idx=0; idx<n; ++idx)
+		values[idx] = from_radix_key<V>(src[idx]);
+}
+template<typename V>
+void sort_values(V* values, std::size_t n, radix_key_t<V>*, std::false_type)
+                                                                          {std::sort(values, values + n);}
+
+/* The scale function k(q) = compression/z * log(q/(1-q)), with the
+ * normalizer z = 4*log(total/compression) + 24, maps quantiles to k. A
+ * centroid may only span one unit of k, which makes centroids tiny near
+ * the minimum and the maximum, and large near the median. Given the weight
+ * of all centroids left of a centroid, this returns the maximum weight up
+ * to and including that centroid. */
+inline double sketch_weight_limit(double weight_so_far, double total, double compression) {
+	const double z = 4 * std::log(std::max(total / compression, 1.)) + 24;
+	const double q = weight_so_far / total;
+	const double k = compression / z * std::log(q / (1-q)) + 1;
+	return total / (1 + std::exp(-k * z / compression));
+}
+
+template<typename V>
+V interpolate_quantile(double rank, double rank1, V value1, double rank2, V value2) {
+	if(rank2 <= rank1)
+		return value2;
+	return static_cast<V>(value1 + (value2 - value1) * ((rank - rank1) / (rank2 - rank1)));
+}
+
+}
+
+/**
+ * @brief Mergeable sketch of the distribution of quantities
+ *
+ * This estimates quantiles (e.g., the median, or the 99th percentile) of
+ * any number of quantities in a fixed amount of memory. It is a merging
+ * t-digest: quantities inserted are collected in a buffer, which, when it
+ * is full, is sorted and merged into a sorted list of centroids, each
+ * representing the mean and number of adjacent quantities. Centroids near
+ * the minimum and the maximum represent few quantities, so the estimates
+ * of extreme quantiles are much more accurate than those of the median.
+ *
+ * The compression determines the trade-off between accuracy and memory:
+ * there are never more than about compression centroids, and the buffer
+ * holds a few times as many quantities. All memory is allocated when the
+ * sketch is created.
+ *
+ * Sketches of separate streams of quantities (e.g., from different threads
+ * or processes) can be merged, and written to and read from streams.
+ *
+ * @tparam Q  the quantity type (value type must be floating point)
+ *
+ * @code
+ * quantile_sketch<milli<second<double>>> latencies;
+ * for(const auto& request : requests)
+ *     latencies.insert(request.latency);
+ * report(latencies.quantile(0.5), latencies.quantile(0.99));
+ */
+template<typename Q>
+class quantile_sketch {
+public:
+	using quantity_type = Q;                                              /**< the quantity type                  */
+	using    value_type = typename quantity_type::value_type;             /**< the quantities' value type         */
+
+	static_assert(is_quantity<quantity_type>::value, "quantile sketches must contain quantities");
+	static_assert(std::is_floating_point<value_type>::value, "quantile sketches need floating point values");
+
+	/**
+	 * @brief Create an empty sketch
+	 *
+	 * @param compression  accuracy/memory trade-off (between 10 and 10000)
+	 */
+	explicit quantile_sketch(double compression = 100.)                   : compression_{compression}, count_{0}
+	                                                                      , min_{ std::numeric_limits<value_type>::infinity()}
+	                                                                      , max_{-std::numeric_limits<value_type>::infinity()}
+	                                                                      , centroids_{}, buffer_{}, scratch_{}, keys_{} {
+		assert(compression >= min_compression and compression <= max_compression);
+		centroids_.reserve(centroid_capacity());
+		buffer_   .reserve(buffer_capacity());
+		scratch_  .reserve(centroid_capacity() + buffer_capacity());
+		keys_     .resize(detail::radix_key<value_type>::is_sortable ? 2 * buffer_capacity() : 0);
+	}
+
+	static constexpr double min_compression = 10.;
+	static constexpr double max_compression = 10000.;
+
+	/**
+	 * @{
+	 *
+	 * @brief Add quantities to the sketch
+	 *
+	 * @param q   quantity to add
+	 * @param in  quantities to add
+	 *
+	 * @note The quantities must not be NaN.
+	 */
+	void insert(const quantity_type& q) {
+		buffer_.push_back(q.get());
+		if(buffer_.size() == buffer_capacity())
+			compress();
+	}
+	void insert(quantity_span<const quantity_type> in)                    {insert_values(in.values(), in.size());}
+	/** @} */
+
+	/**
+	 * @brief Combine sketches
+	 *
+	 * After this, the sketch represents all quantities added to this sketch
+	 * and to @p other.
+	 *
+	 * @param other  sketch to merge into this one
+	 */
+	quantile_sketch& merge(const quantile_sketch& other) {
+		if(&other == this)
+			return merge(quantile_sketch{other});
+		insert_values(other.buffer_.data(), other.buffer_.size());
+		compress();
+		if(other.centroids_.empty())
+			return *this;
+		scratch_.clear();
+		std::merge( centroids_.begin(), centroids_.end()
+		          , other.centroids_.begin(), other.centroids_.end()
+		          , std::back_inserter(scratch_) );
+		count_ += other.count_;
+		min_    = std::min(min_, other.min_);
+		max_    = std::max(max_, other.max_);
+		merge_centroids();
+		return *this;
+	}
+
+	/**
+	 * @brief Merge the buffered quantities into the centroids
+	 *
+	 * This is done whenever the buffer is full. quantile() must work on a
+	 * copy if the buffer is not empty, so compressing before querying many
+	 * quantiles is faster.
+	 */
+	void compress() {
+		if(buffer_.empty())
+			return;
+		detail::sort_values(buffer_.data(), buffer_.size(), keys_.data(), std::integral_constant<bool,detail::radix_key<value_type>::is_sortable>{});
+		min_    = std::min(min_, buffer_.front());
+		max_    = std::max(max_, buffer_.back ());
+		count_ += buffer_.size();
+		scratch_.clear();
+		auto it = buffer_.begin();
+		for(const auto& centroid : centroids_) {
+			for(; it != buffer_.end() and *it < centroid.mean; ++it)
+				scratch_.push_back(detail::sketch_centroid<value_type>{*it, 1});
+			scratch_.push_back(centroid);
+		}
+		for(; it != buffer_.end(); ++it)
+			scratch_.push_back(detail::sketch_centroid<value_type>{*it, 1});
+		buffer_.clear();
+		merge_centroids();
+	}
+
+	/**
+	 * @brief Estimate a quantile
+	 *
+	 * This interpolates linearly between the minimum, the centroids' means,
+	 * and the maximum. quantile(0.) and quantile(1.) are the exact minimum
+	 * and maximum.
+	 *
+	 * @note This must not be called on an empty sketch.
+	 *
+	 * @param q  quantile to estimate (between 0 and 1)
+	 *
+	 * @return estimated quantile of the quantities added
+	 */
+	quantity_type quantile(double q) const {
+		assert(not empty());
+		assert(q >= 0. and q <= 1.);
+		if(not buffer_.empty()) {
+			quantile_sketch compressed{*this};
+			compressed.compress();
+			return compressed.quantile(q);
+		}
+		const double rank = q * static_cast<double>(count_);
+		double      prev_rank  = 0.;
+		value_type  prev_value = min_;
+		double      weight_so_far = 0.;
+		for(const auto& centroid : centroids_) {
+			const double center = weight_so_far + static_cast<double>(centroid.weight) / 2;
+			if(rank < center)
+				return quantity_type{detail::interpolate_quantile(rank, prev_rank, prev_value, center, centroid.mean)};
+			prev_rank      = center;
+			prev_value     = centroid.mean;
+			weight_so_far += static_cast<double>(centroid.weight);
+		}
+		return quantity_type{detail::interpolate_quantile(rank, prev_rank, prev_value, weight_so_far, max_)};
+	}
+
+	/** number of quantities added */
+	std::uint64_t           count()                                 const {return count_ + buffer_.size();}
+	bool                    empty()                                 const {return count() == 0;}
+
+	double                  compression()                           const {return compression_;}
+
+	/**
+	 * @{
+	 *
+	 * @brief Exact minimum and maximum of the quantities added
+	 *
+	 * @note These must not be called on an empty sketch.
+	 */
+	quantity_type           min()                                   const {assert(not empty()); return quantity_type{buffer_.empty() ? min_ : std::min(min_, *std::min_element(buffer_.begin(), buffer_.end()))};}
+	quantity_type           max()                                   const {assert(not empty()); return quantity_type{buffer_.empty() ? max_ : std::max(max_, *std::max_element(buffer_.begin(), buffer_.end()))};}
+	/** @} */
+
+	/**
+	 * @brief Write the sketch to a stream
+	 *
+	 * This writes a quantile_sketch_header, the minimum and maximum, and
+	 * the centroids' means and weights. Buffered quantities are merged into
+	 * the centroids first. All numbers are written in the machine's byte
+	 * order.
+	 *
+	 * @note Errors are reported through the stream's state.
+	 *
+	 * @param os  stream to write to (should be opened in binary mode)
+	 */
+	void write(std::ostream& os) const {
+		if(not buffer_.empty()) {
+			quantile_sketch compressed{*this};
+			compressed.compress();
+			compressed.write(os);
+			return;
+		}
+		const quantity_column_descriptor descriptor = make_quantity_column_descriptor<quantity_type>();
+		quantile_sketch_header header{};
+		std::memcpy(header.magic, "UNLIBQSK", sizeof(header.magic));
+		header.byte_order     = quantile_sketch_header::byte_order_mark;
+		header.version        = quantile_sketch_header::current_version;
+		header.exponents      = descriptor.exponents;
+		header.scale_num      = descriptor.scale_num;
+		header.scale_den      = descriptor.scale_den;
+		header.value_kind     = descriptor.value_kind;
+		header.value_size     = descriptor.value_size;
+		header.tag_id         = descriptor.tag_id;
+		header.compression    = compression_;
+		header.count          = count_;
+		header.centroid_count = centroids_.size();
+		os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		os.write(reinterpret_cast<const char*>(&min_), sizeof(min_));
+		os.write(reinterpret_cast<const char*>(&max_), sizeof(max_));
+		for(const auto& centroid : centroids_)
+			os.write(reinterpret_cast<const char*>(&centroid.mean  ), sizeof(centroid.mean  ));
+		for(const auto& centroid : centroids_)
+			os.write(reinterpret_cast<const char*>(&centroid.weight), sizeof(centroid.weight));
+	}
+
+	/**
+	 * @brief Read a sketch from a stream
+	 *
+	 * If the sketch was written with another scale, its values are rescaled.
+	 *
+	 * @param is  stream to read from (should be opened in binary mode)
+	 *
+	 * @throw sketch_format_error if the stream does not contain a valid
+	 *        sketch, if the sketch's unit, tag, or value type do not match
+	 *        those of Q, or if the stream ends prematurely
+	 */
+	static quantile_sketch read(std::istream& is) {
+		quantile_sketch_header header;
+		read(is, &header, sizeof(header));
+		check_header(header);
+		quantile_sketch sketch{header.compression};
+		if(header.centroid_count > 2 * sketch.centroid_capacity())
+			throw sketch_format_error("quantile sketch has too many centroids");
+		sketch.count_ = header.count;
+		read(is, &sketch.min_, sizeof(sketch.min_));
+		read(is, &sketch.max_, sizeof(sketch.max_));
+		sketch.centroids_.resize(static_cast<std::size_t>(header.centroid_count));
+		for(auto& centroid : sketch.centroids_)
+			read(is, &centroid.mean  , sizeof(centroid.mean  ));
+		for(auto& centroid : sketch.centroids_)
+			read(is, &centroid.weight, sizeof(centroid.weight));
+		sketch.check_centroids();
+		sketch.rescale(header.scale_num, header.scale_den);
+		return sketch;
+	}
+
+private:
+	using centroid_type = detail::sketch_centroid<value_type>;
+
+	double                                            compression_;
+	std::uint64_t                                     count_;
+	value_type                                        min_;
+	value_type                                        max_;
+	std::vector<centroid_type>                        centroids_;
+	std::vector<value_type>                           buffer_;
+	std::vector<centroid_type>                        scratch_;
+	std::vector<detail::radix_key_t<value_type>>      keys_;
+
+	/* merging leaves well below compression centroids (the vector grows if
+	 * it does not), and a buffer of 8 times that many values makes merging
+	 * cheap compared to sorting the buffer */
+	std::size_t             centroid_capacity()                     const {return static_cast<std::size_t>(std::ceil(compression_)) + 2;}
+	std::size_t             buffer_capacity()                       const {return 8 * centroid_capacity();}
+
+	void insert_values(const value_type* in, std::size_t n) {
+		while(n > 0) {
+			const std::size_t chunk = std::min(n, buffer_capacity() - buffer_.size());
+			buffer_.insert(buffer_.end(), in, in + chunk);
+			in += chunk;
+			n  -= chunk;
+			if(buffer_.size() == buffer_capacity())
+				compress();
+		}
+	}
+
+	/* merges the sorted centroids in scratch_ into as few centroids as the
+	 * scale function allows */
+	void merge_centroids() {
+		centroids_.clear();
+		const double total = static_cast<double>(count_);
+		std::uint64_t weight_so_far = 0;
+		double        weight_limit  = detail::sketch_weight_limit(0., total, compression_);
+		centroid_type current       = scratch_.front();
+		for(auto it = scratch_.begin() + 1; it != scratch_.end(); ++it) {
+			if(static_cast<double>(weight_so_far + current.weight + it->weight) <= weight_limit) {
+				current.weight += it->weight;
+				current.mean   += (it->mean - current.mean) * static_cast<value_type>(it->weight) / static_cast<value_type>(current.weight);
+			} else {
+				centroids_.push_back(current);
+				weight_so_far += current.weight;
+				weight_limit   = detail::sketch_weight_limit(static_cast<double>(weight_so_far), total, compression_);
+				current        = *it;
+			}
+		}
+		centroids_.push_back(current);
+	}
+
+	static void read(std::istream& is, void* buffer, std::size_t size) {
+		if(not is.read(static_cast<char*>(buffer), static_cast<std::streamsize>(size)))
+			throw sketch_format_error("unexpected end of quantile sketch");
+	}
+
+	static void check_header(const quantile_sketch_header& header) {
+		if(std::memcmp(header.magic, "UNLIBQSK", sizeof(header.magic)) != 0)
+			throw sketch_format_error("not a quantile sketch");
+		if(header.byte_order != quantile_sketch_header::byte_order_mark)
+			throw sketch_format_error("quantile sketch has a different byte order");
+		if(header.version != quantile_sketch_header::current_version)
+			throw sketch_format_error("unsupported quantile sketch version");
+		const quantity_column_descriptor expected = make_quantity_column_descriptor<quantity_type>();
+		if(header.exponents != expected.exponents or header.tag_id != expected.tag_id)
+			throw sketch_format_error("quantile sketch has a different unit");
+		if(header.value_kind != expected.value_kind or header.value_size != expected.value_size)
+			throw sketch_format_error("quantile sketch has a different value type");
+		if(header.scale_num <= 0 or header.scale_den <= 0)
+			throw sketch_format_error("quantile sketch has an invalid scale");
+		if(not (header.compression >= min_compression and header.compression <= max_compression))
+			throw sketch_format_error("quantile sketch has an invalid compression");
+	}
+
+	/* throws unless the centroids are sorted and their weights add up */
+	void check_centroids() const {
+		std::uint64_t total = 0;
+		for(std::size_t idx=0; idx<centroids_.size(); ++idx) {
+			if(centroids_[idx].weight == 0 or (idx > 0 and centroids_[idx].mean < centroids_[idx-1].mean))
+				throw sketch_format_error("quantile sketch has invalid centroids");
+			total += centroids_[idx].weight;
+		}
+		if(total != count_ or (count_ > 0 and not (min_ <= max_)))
+			throw sketch_format_error("quantile sketch has invalid centroids");
+	}
+
+	void rescale(std::int64_t num, std::int64_t den) {
+		using scale_type = typename quantity_type::scale_type;
+		if(num == scale_type::num and den == scale_type::den)
+			return;
+		const auto factor = static_cast<value_type>( static_cast<long double>(num) * scale_type::den
+		                                           / (static_cast<long double>(den) * scale_type::num) );
+		min_ *= factor;
+		max_ *= factor;
+		for(auto& centroid : centroids_)
+			centroid.mean *= factor;
+	}
+};
+
+template<typename Q>
+constexpr double quantile_sketch<Q>::min_compression;
+template<typename Q>
+constexpr double quantile_sketch<Q>::max_compression;
+
+}
+
+#endif //UNLIB_QUANTILE_SKETCH_HPP
@@ -11,44 +11,19 @@
  *
  */
 
+#include <cstddef>
 #include <cstdint>
-#include <istream>
 #include <limits>
-#include <ostream>
-#include <string>
+#include <stdexcept>
 #include <type_traits>
 
-#include <unlib/unit.hpp>
-#include <unlib/scaling.hpp>
-#include <unlib/tag.hpp>
+#include <unlib/quantity_fwd.hpp>
 
 
 namespace unlib {
 
 /* quantities ****************************************************************/
 
-/**
- * @brief Quantity type
- *
- * This is a container for a value of ValueType, of the physical unit Unit,
- * with the scale Scale, and the tag Tag. It is meant to be used mostly like
- * ValueType would be used. For that, it overrides the necessary operators of
- * the built-in numeric types.
- *
- * @tparam       Unit   the quantity's unit type
- * @tparam      Scale   the quantity's scale
- * @tparam  ValueType   the quantity's value type
- * @tparam        Tag   the quantity's tag
- */
-template< typename Unit
-        , typename Scale     = no_scaling
-        , typename ValueType = double
-        , typename Tag       = no_tag >
-class quantity;
-
-template<typename T>                                     struct is_quantity                    : std::false_type {};
-template<typename U, typename S, typename V, typename T> struct is_quantity<quantity<U,S,V,T>> : std::true_type {};
-
 namespace detail {
 
 template<typename TFloat>
@@ -65,26 +40,157 @@ template<typename T> constexpr bool is_quantity_v        = is_quantity<T>::value
 template<typename T> constexpr bool is_floating_point_v  = is_floating_point<T>::value;
 template<typename T> constexpr bool is_integral_v        = is_integral<T>::value;
 
+/* Floating point values are, by default, rescaled by multiplying them with
+ * the conversion factor num/den folded at compile-time. When den is not a
+ * power of two, that factor is rounded, and results might differ in the last
+ * bit from those of (v*num)/den. Defining UNLIB_EXACT_FLOATPT_RESCALING to 1
+ * makes these conversions compute (v*num)/den instead. Integer values are
+ * always rescaled by integer_rescaler. */
+#if !defined(UNLIB_EXACT_FLOATPT_RESCALING)
+#	define UNLIB_EXACT_FLOATPT_RESCALING 0
+#endif
+
+struct  fast_floatpt_rescaling {};
+struct exact_floatpt_rescaling {};
+
+#if UNLIB_EXACT_FLOATPT_RESCALING
+using default_floatpt_rescaling = exact_floatpt_rescaling;
+#else
+using default_floatpt_rescaling =  fast_floatpt_rescaling;
+#endif
+
+constexpr bool is_power_of_two(std::intmax_t n)                           {return n > 0 and (n & (n-1)) == 0;}
+
+/* Rescales integer values by Num/Den, yielding the same results as (v*Num)/Den.
+ * Where v*Num would overflow, this computes (v/Den)*Num + (v%Den)*Num/Den
+ * instead, which only overflows if the result does. (Divisions by constants
+ * are turned into multiplications and shifts by the compiler, so neither
+ * needs a hardware division nor 128 bit arithmetic.) try_rescale() reports
+ * whether the result can be represented in ValueType. */
+template<typename ValueType, std::intmax_t Num, std::intmax_t Den>
+struct integer_rescaler {
+	using    calc_type = std::common_type_t<ValueType, std::intmax_t>;
+	using  calc_limits = std::numeric_limits<calc_type>;
+	using value_limits = std::numeric_limits<ValueType>;
+
+	static_assert(Num > 0 and Den > 0, "integer rescaling needs positive scales");
+
+	static constexpr calc_type num = static_cast<calc_type>(Num);
+	static constexpr calc_type den = static_cast<calc_type>(Den);
+
+	/* whether v*Num cannot overflow for any v */
+	static constexpr bool is_product_safe = static_cast<calc_type>(value_limits::max   ()) <= calc_limits::max   () / num
+	                                    and static_cast<calc_type>(value_limits::lowest()) >= calc_limits::lowest() / num;
+	/* whether (v%Den)*Num cannot overflow for any v */
+	static constexpr bool is_split_safe   = den-1 <= calc_limits::max() / num;
+
+	using split = std::integral_constant<bool, Num != 1 and Den != 1 and not is_product_safe and is_split_safe>;
+
+	static constexpr ValueType rescale(ValueType v)                       {return static_cast<ValueType>(rescale_(static_cast<calc_type>(v), split{}));}
+
+	static constexpr bool try_rescale(ValueType v, ValueType& result) {
+		calc_type r{};
+		if( not try_rescale_(static_cast<calc_type>(v), r, split{})
+		 or r > static_cast<calc_type>(value_limits::max   ())
+		 or r < static_cast<calc_type>(value_limits::lowest()) )
+			return false;
+		result = static_cast<ValueType>(r);
+		return true;
+	}
+
+private:
+	static constexpr calc_type rescale_(calc_type v, std::false_type)    {return (v*num)/den;}
+	static constexpr calc_type rescale_(calc_type v, std:: true_type)    {return mul_overflows(v) ? (v/den)*num + ((v%den)*num)/den : (v*num)/den;}
+
+	static constexpr bool mul_overflows(calc_type v)                      {return v > calc_limits::max()/num or v < calc_limits::lowest()/num;}
+
+	static constexpr bool try_rescale_(calc_type v, calc_type& r, std::false_type) {
+		if(mul_overflows(v))
+			return false;
+		r = (v*num)/den;
+		return true;
+	}
+	static constexpr bool try_rescale_(calc_type v, calc_type& r, std:: true_type) {
+		if(not mul_overflows(v)) {
+			r = (v*num)/den;
+			return true;
+		}
+		const calc_type q = v/den;
+		if(mul_overflows(q))
+			return false;
+		const calc_type s = q*num;
+		const calc_type t = ((v%den)*num)/den;
+		if( (t > calc_type{} and s > calc_limits::max   () - t)
+		 or (t < calc_type{} and s < calc_limits::lowest() - t) )
+			return false;
+		r = s + t;
+		return true;
+	}
+};
+
 template<typename NewScale, typename OldScale>
 struct value_rescaler {
 	using conversion_scale = std::ratio_divide<OldScale, NewScale>;
 
+	/* whether multiplying with the folded factor is as exact as (v*num)/den */
+	static constexpr bool is_factor_exact = is_power_of_two(conversion_scale::den);
+
+	template<typename ValueType>
+	constexpr static ValueType factor() {
+		return static_cast<ValueType>( static_cast<long double>(conversion_scale::num)
+		                             / static_cast<long double>(conversion_scale::den) );
+	}
+
+	template<typename ValueType, typename Policy = default_floatpt_rescaling>
+	constexpr static ValueType rescale_value(ValueType v, Policy = Policy{}) {
+		using multiply = std::integral_constant< bool, std::is_floating_point<ValueType>::value
+		                                               and (is_factor_exact or std::is_same<Policy,fast_floatpt_rescaling>::value) >;
+		return rescale_value_(v, multiply{});
+	}
+
+private:
+	template<typename ValueType>
+	constexpr static ValueType rescale_value_(ValueType v, std::true_type) {return v * factor<ValueType>();}
+	template<typename ValueType>
+	constexpr static ValueType rescale_value_(ValueType v, std::false_type) {return rescale_other_(v, std::is_integral<ValueType>{});}
+
+	template<typename ValueType>
+	constexpr static ValueType rescale_other_(ValueType v, std:: true_type) {return integer_rescaler_t<ValueType>::rescale(v);}
 	template<typename ValueType>
-	constexpr static ValueType rescale_value(ValueType v) {
+	constexpr static ValueType rescale_other_(ValueType v, std::false_type) {
 		const auto num = conversion_scale::num;
 		const auto den = conversion_scale::den;
 		const auto result = static_cast<ValueType>((v*num)/den);
 		return result;
 	}
+
+	template<typename ValueType>
+	using integer_rescaler_t = integer_rescaler<ValueType, conversion_scale::num, conversion_scale::den>;
+
+public:
+	/* rescales integer v into result, returns false if it doesn't fit */
+	template<typename ValueType>
+	constexpr static bool try_rescale_value(ValueType v, ValueType& result)
+	                                                                      {return integer_rescaler_t<ValueType>::try_rescale(v, result);}
 };
 template<typename Scale>
 struct value_rescaler<Scale,Scale> {
+	template<typename ValueType, typename Policy = default_floatpt_rescaling>
+	static constexpr ValueType rescale_value(ValueType v, Policy = Policy{}) {return v;}
 	template<typename ValueType>
-	static constexpr ValueType rescale_value(ValueType v)                 {return v;}
+	static constexpr bool try_rescale_value(ValueType v, ValueType& result) {result = v; return true;}
 };
 
-template<typename NewScale, typename OldScale, typename ValueType>
-constexpr ValueType rescale_value(ValueType v)                            {return value_rescaler<NewScale,OldScale>::rescale_value(v);}
+template<typename NewScale, typename OldScale, typename ValueType, typename Policy = default_floatpt_rescaling>
+constexpr ValueType rescale_value(ValueType v, Policy p = Policy{})       {return value_rescaler<NewScale,OldScale>::rescale_value(v, p);}
+
+/* Rescales n values. This applies exactly the same conversion as
+ * rescale_value(), but in a loop over raw values the compiler can vectorize. */
+template<typename NewScale, typename OldScale, typename ValueType, typename Policy = default_floatpt_rescaling>
+void rescale_values(const ValueType* in, std::size_t n, ValueType* out, Policy p = Policy{}) {
+	for(std::size_t idx=0; idx<n; ++idx)
+		out[idx] = rescale_value<NewScale,OldScale>(in[idx], p);
+}
 
 }
 
@@ -135,35 +241,17 @@ public:
  * @tparam     TagNum   the quantity's tag exponents numerator
  * @tparam     TagDen   the quantity's tag exponents denominator
  */
-template< std::intmax_t            TimeNum, std::intmax_t            TimeDen
-        , std::intmax_t            MassNum, std::intmax_t            MassDen
-        , std::intmax_t          LengthNum, std::intmax_t          LengthDen
-        , std::intmax_t         CurrentNum, std::intmax_t         CurrentDen
-        , std::intmax_t      LuminosityNum, std::intmax_t      LuminosityDen
-        , std::intmax_t     TemperatureNum, std::intmax_t     TemperatureDen
-        , std::intmax_t SubstanceAmountNum, std::intmax_t SubstanceAmountDen
-        , std::intmax_t           ScaleNum, std::intmax_t           ScaleDen
-        , std::intmax_t             TagNum, std::intmax_t             TagDen
+template< std::uint64_t UnitExponents
+        , std::intmax_t ScaleNum, std::intmax_t ScaleDen
+        , std::intmax_t   TagNum, std::intmax_t   TagDen
         , typename ValueType
         , typename TagID >
-class quantity< unit< std::ratio<           TimeNum,           TimeDen>
-                    , std::ratio<           MassNum,           MassDen>
-                    , std::ratio<         LengthNum,         LengthDen>
-                    , std::ratio<        CurrentNum,        CurrentDen>
-                    , std::ratio<     LuminosityNum,     LuminosityDen>
-                    , std::ratio<    TemperatureNum,    TemperatureDen>
-                    , std::ratio<SubstanceAmountNum,SubstanceAmountDen> >
+class quantity< packed_unit<UnitExponents>
               , std::ratio<ScaleNum,ScaleDen>
               , ValueType
               , tag<TagID,std::ratio<TagNum,TagDen>> > {
 public:
-	using  unit_type = unit< std::ratio<           TimeNum,           TimeDen>
-	                       , std::ratio<           MassNum,           MassDen>
-	                       , std::ratio<         LengthNum,         LengthDen>
-	                       , std::ratio<        CurrentNum,        CurrentDen>
-	                       , std::ratio<     LuminosityNum,     LuminosityDen>
-	                       , std::ratio<    TemperatureNum,    TemperatureDen>
-	                       , std::ratio<SubstanceAmountNum,SubstanceAmountDen> >; /**< the quantity's unit type  */
+	using  unit_type = packed_unit<UnitExponents>;                                /**< the quantity's unit type  */
 	using scale_type = scale_t<ScaleNum,ScaleDen>;                                /**< the quantity's scale      */
 	using value_type = ValueType;                                                 /**< the quantity's value type */
 	using   tag_type = tag_t<TagID,TagNum,TagDen>;                                /**< the quantity's tag        */
@@ -401,64 +489,38 @@ private:
 	value_type                                        value;
 };
 
-/* free function alternatives for member functions ***************************/
-
-template<typename U, typename S, typename V, typename T>
-constexpr typename quantity<U,S,V,T>::value_type get(const quantity<U,S,V,T>& q)
-                                                                          {return q.get();}
-
-template<typename NewScale, typename U, typename S, typename V, typename T>
-constexpr typename quantity<U,S,V,T>::value_type get_scaled(const quantity<U,S,V,T>& q, NewScale = NewScale{})
-                                                                          {return q.template get_scaled<NewScale>();}
-
+/* layout guarantees *********************************************************/
 
 /**
- * @{
+ * @brief Check whether a quantity type has the same layout as its value type
  *
- * @brief Result type for multiplying/dividing value types
- */
-template<typename V1, typename V2> using mul_value_t = decltype(V1{}*V2{});
-template<typename V1, typename V2> using div_value_t = decltype(V1{}/V2{});
-template<typename V1, typename V2> using mod_value_t = decltype(V1{}%V2{});
-/** @} */
-
-
-/* quantity type manipulations ***********************************************/
-
-/**
- * @{
+ * Quantities are standard-layout types whose only data member is their
+ * value, so that sequences of quantities can be accessed as sequences of
+ * values and vice versa (@sa quantity_span, quantity_vector::values()).
  *
- * Calculate the types needed when multiplying/dividing quantities.
+ * @tparam Q  quantity type
  */
-template<typename Q1, typename Q2  > using  mul_quantity_t = quantity<  mul_unit_t <typename Q1:: unit_type, typename Q2:: unit_type>
-                                                                     ,  mul_scale_t<typename Q1::scale_type, typename Q2::scale_type>
-                                                                     ,  mul_value_t<typename Q1::value_type, typename Q2::value_type>
-                                                                     ,  mul_tag_t  <typename Q1::  tag_type, typename Q2::  tag_type> >;
-template<typename Q1, typename Q2  > using  div_quantity_t = quantity<  div_unit_t <typename Q1:: unit_type, typename Q2:: unit_type>
-                                                                     ,  div_scale_t<typename Q1::scale_type, typename Q2::scale_type>
-                                                                     ,  div_value_t<typename Q1::value_type, typename Q2::value_type>
-                                                                     ,  div_tag_t  <typename Q1::  tag_type, typename Q2::  tag_type> >;
-
-template<typename Q, typename Ratio> using  pow_quantity_t = quantity< pow_unit_t <typename Q:: unit_type, Ratio>
-                                                                     , pow_scale_t<typename Q::scale_type, Ratio>
-                                                                     ,             typename Q::value_type
-                                                                     , pow_tag_t  <typename Q::  tag_type, Ratio> >;
-template<typename Q                > using sqrt_quantity_t = pow_quantity_t<Q,std::ratio<1,2>>;
-template<typename Q                > using cbrt_quantity_t = pow_quantity_t<Q,std::ratio<1,3>>;
-/** @} */
+template<typename Q>
+struct has_value_layout : std::integral_constant< bool, std::is_standard_layout<Q>::value
+                                                        and sizeof (Q) == sizeof (typename Q::value_type)
+                                                        and alignof(Q) == alignof(typename Q::value_type) > {};
 
+static_assert(has_value_layout<quantity<dimensionless,no_scaling,signed char,no_tag>>::value, "quantities must have the layout of their values");
+static_assert(has_value_layout<quantity<dimensionless,no_scaling,int        ,no_tag>>::value, "quantities must have the layout of their values");
+static_assert(has_value_layout<quantity<dimensionless,no_scaling,long long  ,no_tag>>::value, "quantities must have the layout of their values");
+static_assert(has_value_layout<quantity<dimensionless,no_scaling,float      ,no_tag>>::value, "quantities must have the layout of their values");
+static_assert(has_value_layout<quantity<dimensionless,no_scaling,double     ,no_tag>>::value, "quantities must have the layout of their values");
+static_assert(has_value_layout<quantity<dimensionless,no_scaling,long double,no_tag>>::value, "quantities must have the layout of their values");
 
-/* quantity scaling **********************************************************/
+/* free function alternatives for member functions ***************************/
 
-namespace detail {
+template<typename U, typename S, typename V, typename T>
+constexpr typename quantity<U,S,V,T>::value_type get(const quantity<U,S,V,T>& q)
+                                                                          {return q.get();}
 
-/* This allows quantities to be scaled using milli<q> and to_milli<q> */
-template<typename NewScale, typename U, typename S, typename V, typename T>
-struct scale_by<NewScale, quantity<U,S,V,T>>                    {using type = typename quantity<U,S,V,T>::template rescale_by<NewScale>;};
 template<typename NewScale, typename U, typename S, typename V, typename T>
-struct scale_to<NewScale, quantity<U,S,V,T>>                    {using type = typename quantity<U,S,V,T>::template rescale_to<NewScale>;};
-
-}
+constexpr typename quantity<U,S,V,T>::value_type get_scaled(const quantity<U,S,V,T>& q, NewScale = NewScale{})
+                                                                          {return q.template get_scaled<NewScale>();}
 
 
 /* quantity operators ********************************************************/
@@ -651,6 +713,42 @@ template<typename NewScale, typename U, typename S, typename V, typename T>
 constexpr auto scale_cast(const quantity<U,S,V,T>& q)                     {return quantity<U,NewScale,V,T>{scale_cast(q)};}
 /** @} */
 
+/**
+ * @{
+ * @brief Overflow-aware casts between differently scaled integer quantities
+ *
+ * These perform the same conversion as scale_cast<NewScale>(), but detect
+ * results that cannot be represented in the quantity's value type. When that
+ * happens, checked_scale_cast() throws std::overflow_error, while
+ * saturating_scale_cast() returns the greatest or lowest representable value.
+ *
+ * @param         q  quantity to cast
+ * @tparam NewScale  scale to cast to, e.g. milli_scaling
+ * @return q with rescaled value and changed scale
+ *
+ * @code
+ * using i8_ms = milli<second<std::int8_t>>;
+ * i8_ms ms1 = checked_scale_cast   <milli_scaling>(second<std::int8_t>{1}); // throws
+ * i8_ms ms2 = saturating_scale_cast<milli_scaling>(second<std::int8_t>{1}); // 127ms
+ */
+template<typename NewScale, typename U, typename S, typename V, typename T>
+constexpr quantity<U,NewScale,V,T> checked_scale_cast(const quantity<U,S,V,T>& q) {
+	static_assert(detail::is_integral_v<V>, "overflow-aware scale casts need integral value types");
+	V result{};
+	if(not detail::value_rescaler<NewScale,S>::try_rescale_value(q.get(), result))
+		throw std::overflow_error("unlib::checked_scale_cast(): result out of range");
+	return quantity<U,NewScale,V,T>{result};
+}
+template<typename NewScale, typename U, typename S, typename V, typename T>
+constexpr quantity<U,NewScale,V,T> saturating_scale_cast(const quantity<U,S,V,T>& q) {
+	static_assert(detail::is_integral_v<V>, "overflow-aware scale casts need integral value types");
+	V result{};
+	if(not detail::value_rescaler<NewScale,S>::try_rescale_value(q.get(), result))
+		result = q.get() < V{} ? std::numeric_limits<V>::lowest() : std::numeric_limits<V>::max();
+	return quantity<U,NewScale,V,T>{result};
+}
+/** @} */
+
 
 /**
  * @{
@@ -709,233 +807,6 @@ template<typename NewQuantity, typename U, typename S, typename V, typename T>
 constexpr NewQuantity quantity_cast(const quantity<U,S,V,T>& q)           {return NewQuantity{quantity_cast(q)};}
 /** @} */
 
-/* I/O ***********************************************************************/
-
-namespace literals {
-
-/**
- * Specializations of this template define the prefixes applied to unit
- * strings for different scaling (e.g., "k" for kilo or "M" for mega).
- * Prefixes for all ISO scalings are pre-defined using the @sq
- * UNLIB_DEFINE_SCALE_LITERAL_TRAITS() macro.
- *
- * Except when inventing a proprietary scaling, users should have no need to
- * define their own specializations of this template. Usually it's better to
- * define a @sq quantity_traits specialization.
- *
- * @tparam S  Scaling to define a prefix string for
- */
-template<typename S>
-struct scaling_traits {
-	using is_specialized = std::false_type;
-};
-
-/** Find out whether scaling_traits is specialized for a specific scaling */
-template<typename S>
-using is_scaling_string_specialized = typename scaling_traits<S>::is_specialized;
-
-/**
- * Specializations of this template define the unit strings for different
- * units (like "m" for meter). Units who invent their own units can
- * specialize this to define unit strings for those.
- *
- * @note Specializations of this must have a static function `get_string()`.
- *       (The @sa UNLIB_DEFINE_UNIT_LITERAL_TRAITS() macro is a convenient way
- *       to create fully conforming specializations.)
- *
- * @tparam U  Unit to define string for
- * @tparam T  Tag to define string for
- */
-template<typename U, typename T>
-struct unit_traits {
-	using is_specialized = std::false_type;
-	static constexpr const auto& get_string() {return "";}
-};
-
-/** Find out whether unit_traits is specialized for a specific unit and tag */
-template<typename U, typename T>
-using is_unit_string_specialized = typename unit_traits<U,T>::is_specialized;
-
-
-namespace detail {
-
-/* a C++14 static string. */
-template<std::size_t StrLen>
-struct static_string {
-	char array[StrLen+1];
-};
-
-/* a C++14 constexpr string copy */
-template<std::size_t StrSize>
-inline constexpr auto copy_static_string(char* to, const char (&from)[StrSize]) {
-	for(std::size_t idx=0; idx<StrSize-1; ++idx)
-		to[idx] = from[idx];
-	return to + StrSize-1;
-}
-
-/* constexpr-creating the unit string for a quantity */
-template<std::size_t QuantityStrLen, std::size_t ScalingStrSize, std::size_t UnitStrSize>
-constexpr auto make_quantity_string( const char (&scaling_str)[ScalingStrSize]
-                                   , const char (&   unit_str)[   UnitStrSize] ) {
-	static_string<QuantityStrLen> quantity_str{};
-	char* it = quantity_str.array;
-	it = copy_static_string(it, scaling_str);
-	     copy_static_string(it,    unit_str);
-	return quantity_str;
-}
-
-template<typename U, typename S, typename T>
-struct quantity_string_traits {
-	using  unit_type = U;
-	using scale_type = S;
-	using   tag_type = T;
-
-	using scaling_tr = scaling_traits<scale_type>;
-	using    unit_tr =    unit_traits<unit_type, tag_type>;
-
-	static constexpr std::size_t scaling_strlen = sizeof(scaling_tr::get_string()) - 1;
-	static constexpr std::size_t    unit_strlen = sizeof(   unit_tr::get_string()) - 1;
-	static constexpr std::size_t         strlen = scaling_strlen + unit_strlen;
-
-	static constexpr static_string<strlen> string{ make_quantity_string<strlen>(scaling_tr::get_string()
-	                                                                           ,   unit_tr::get_string()) };
-};
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated"
-// in C++14, this is still necessary
-template<typename U, typename S, typename T>
-constexpr static_string<quantity_string_traits<U,S,T>::strlen> quantity_string_traits<U,S,T>::string;
-#pragma GCC diagnostic pop
-
-}
-
-/**
- * The generic version of this template obtains a compile-time string
- * representing the unit, scale, and tag of a quantity by referring to @sa
- * scale_traits and @sa unit_traits.
- *
- * Specializations of this define the strings for quantities (like "nm" for
- * nanometer and "kt" for kilotons). Usually, specializing @sa unit_traits
- * will be more convenient than specializing this, because it allows the
- * automatic combination with scaling prefixes. But sometimes units scale
- * irregularly (kilotons), and then this template can be specialized.
- *
- * @note Specializations of this must have a static_string member named
- *       `get_string()`. (The @sa UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS() and
- *       the @sa UNLIB_DEFINE_SCALED_QUANTITY_LITERAL_TRAITS() macros are
- *       convenient ways to create such specializations.)
- *
- * @tparam U  the quantity's unit type
- * @tparam S  the quantity's scale type
- * @tparam T  the quantity's tag type
- */
-template<typename U, typename S, typename T>
-struct quantity_traits {
-	using is_specialized = std::integral_constant<bool, is_scaling_string_specialized<S  >::value
-	                                                   and is_unit_string_specialized<U,T>::value>;
-	static constexpr const auto& get_string() {return detail::quantity_string_traits<U,S,T>::string.array;}
-};
-
-/** Find out whether quantity_traits is specialized for a specific unit, scaling, and tag */
-template<typename U, typename S, typename T>
-using is_quantity_string_specialized = typename quantity_traits<U,S,T>::is_specialized;
-
-
-/**
- * @{
- *
- * Get a reference to a char array or a C++ string containing the unit string
- * for a quantity.
- *
- * @tparam Q  the quantity
- * @tparam U  the quantity's unit type
- * @tparam S  the quantity's scale type
- * @tparam V  the quantity's value type
- * @tparam T  the quantity's tag type
- *
- * @param q  a quantity (its value is irrelevant)
- *
- * @return String for the unit, scale, and tag of the quantity
- */
-template<typename U, typename S, typename V, typename T>
-const auto& get_quantity_c_str(const quantity<U,S,V,T>&)                  {return literals::quantity_traits<U,S,T>::get_string();}
-template<typename Q>
-const auto& get_quantity_c_str()                                          {return get_quantity_c_str(Q{});}
-
-template<typename U, typename S, typename V, typename T>
-std::string get_quantity_string(const quantity<U,S,V,T>& q)               {return get_quantity_c_str(q);}
-template<typename Q>
-std::string get_quantity_string()                                         {return get_quantity_c_str<Q>();}
-/** @} */
-
-}
-
-namespace detail {
-
-template<typename U, typename S, typename V, typename T>
-std::ostream& stream(std::ostream& os, const quantity<U,S,V,T>& q, std::false_type)
-                                                                          {return os << q.get();}
-template<typename U, typename S, typename V, typename T>
-std::ostream& stream(std::ostream& os, const quantity<U,S,V,T>& q, std::true_type)
-	                                                                      {
-	                                                                          return stream(os, q, std::false_type{})
-	                                                                       << ' '
-	                                                                       << literals::get_quantity_string(q);
-	                                                                      }
-
-template<typename U, typename S, typename V, typename T>
-std::string to_string(const quantity<U,S,V,T>& q, std::false_type)        {using std::to_string; return to_string(q.get());}
-template<typename U, typename S, typename V, typename T>
-std::string to_string(const quantity<U,S,V,T>& q, std::true_type)         {
-	                                                                          return detail::to_string( q
-	                                                                                                  , std::false_type{})
-	                                                                        + ' '
-	                                                                        + literals::get_quantity_string(q);
-	                                                                      }
-
-}
-
-template<typename U, typename S, typename V, typename T>
-std::string to_string(const quantity<U,S,V,T>& q)                         {
-	                                                                          return detail::to_string( q
-	                                                                                                  , literals::is_quantity_string_specialized<U,S,T>{} );
-	                                                                      }
-
-
-/**
- * @brief Stream output operator
- *
- * Streams the stored value into os.
- *
- * @param os  the stream
- * @param  q  the quantity
- * @return os
- */
-template<typename U, typename S, typename V, typename T>
-std::ostream& operator<<(std::ostream& os, const quantity<U,S,V,T>& q)    {
-	                                                                          return detail::stream( os
-	                                                                                               , q
-	                                                                                               , literals::is_quantity_string_specialized<U,S,T>{} );
-	                                                                      }
-
-/**
- * @brief Stream input operator
- *
- * Reads from the stream into q.
- *
- * @param is  the stream
- * @param  q  the quantity
- *
- * @return is
- */
-template<typename U, typename S, typename V, typename T>
-std::istream& operator>>(std::istream& is, quantity<U,S,V,T>& q)          {
-	                                                                          V v;
-	                                                                          if (is >> v)
-		                                                                          q = quantity<U,S,V,T>{v};
-	                                                                          return is;
-                                                                          }
-
 }
 
 #endif /* UNLIB_QUANTITY_HPP */
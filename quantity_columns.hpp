@@ -0,0 +1,389 @@
+#ifndef UNLIB_QUANTITY_COLUMNS_HPP
+#define UNLIB_QUANTITY_COLUMNS_HPP
+
+/*
+ * quantity_columns.hpp
+ *
+ * Copyright sbi http://stackoverflow.com/users/140719
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *     http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <unlib/quantity.hpp>
+#include <unlib/quantity_io.hpp>
+#include <unlib/common_literal_traits.hpp>
+#include <unlib/quantity_span.hpp>
+#include <unlib/quantity_vector.hpp>
+#include <unlib/dynamic_quantity.hpp>
+
+namespace unlib {
+
+/*
+ * Quantity column files
+ *
+ * A column file stores sequences of quantities as columns of raw values. It
+ * consists of
+ *
+ * - a quantity_columns_header,
+ * - one quantity_column_descriptor per column, describing the unit, scale,
+ *   value type, and tag of the column's quantities, as well as where in the
+ *   file its values are stored,
+ * - the columns' values, each column starting at a multiple of
+ *   quantity_columns_alignment.
+ *
+ * All numbers are stored in the byte order of the machine writing the file.
+ * Reading a file written on a machine with a different byte order fails.
+ */
+
+/** alignment (in bytes) of the value blocks within a column file */
+constexpr std::size_t quantity_columns_alignment = 64;
+
+/**
+ * @brief Error thrown when reading column files that are malformed or do not
+ *        match the quantities requested
+ */
+class column_format_error : public std::runtime_error {
+public:
+	using std::runtime_error::runtime_error;
+};
+
+/** kinds of values stored in columns */
+enum class column_value_kind : std::uint8_t { signed_integer
+                                            , unsigned_integer
+                                            , floating_point };
+
+/** header at the beginning of a column file */
+struct quantity_columns_header {
+	char          magic[8];      /**< "UNLIBCOL" */
+	std::uint32_t byte_order;    /**< byte_order_mark, as written by the writer */
+	std::uint32_t version;       /**< format version */
+	std::uint64_t column_count;  /**< number of column descriptors following */
+	std::uint8_t  reserved[40];
+
+	static constexpr std::uint32_t byte_order_mark = 0x01020304u;
+	static constexpr std::uint32_t current_version = 1;
+};
+
+/** descriptor of a column within a column file */
+struct quantity_column_descriptor {
+	std::uint64_t exponents;     /**< unit and tag exponents, as in dynamic_unit::get_exponents_word() */
+	std::int64_t  scale_num;     /**< numerator of the quantities' scale */
+	std::int64_t  scale_den;     /**< denominator of the quantities' scale */
+	std::uint8_t  value_kind;    /**< a column_value_kind */
+	std::uint8_t  value_size;    /**< sizeof the value type */
+	std::uint8_t  tag_id;        /**< tag id (@sa dynamic_tag_id) */
+	std::uint8_t  reserved[5];
+	std::uint64_t offset;        /**< offset of the first value from the beginning of the file */
+	std::uint64_t count;         /**< number of values */
+	char          name[80];      /**< human-readable unit string, if one is defined (null-terminated) */
+};
+
+static_assert(sizeof(quantity_columns_header   ) ==  64, "column file header must not have padding");
+static_assert(sizeof(quantity_column_descriptor) == 128, "column descriptors must not have padding");
+
+namespace detail {
+
+template<typename V>
+constexpr column_value_kind get_column_value_kind() {
+	return std::is_floating_point<V>::value ? column_value_kind::floating_point
+	     : std::is_signed<V>::value         ? column_value_kind::signed_integer
+	     :                                    column_value_kind::unsigned_integer;
+}
+
+template<typename U, typename S, typename T>
+void copy_column_name(char (&name)[80], std::true_type) {
+	const auto& str = literals::quantity_traits<U,S,T>::get_string();
+	static_assert(sizeof(str) <= sizeof(name), "unit string too long for column descriptor");
+	std::memcpy(name, str, sizeof(str));
+}
+template<typename U, typename S, typename T>
+void copy_column_name(char (&)[80], std::false_type)                      {}
+
+constexpr std::uint64_t align_column_offset(std::uint64_t offset)         {return (offset + quantity_columns_alignment - 1) / quantity_columns_alignment * quantity_columns_alignment;}
+
+template<typename Q>
+void write_column_values(std::ostream& os, std::uint64_t& pos, quantity_span<Q> column) {
+	static const char padding[quantity_columns_alignment] = {};
+	const std::uint64_t offset = align_column_offset(pos);
+	os.write(padding, static_cast<std::streamsize>(offset - pos));
+	os.write(reinterpret_cast<const char*>(column.values()), static_cast<std::streamsize>(column.size() * sizeof(*column.values())));
+	pos = offset + column.size() * sizeof(*column.values());
+}
+
+}
+
+/**
+ * @{
+ *
+ * @brief Create the descriptor for a column of quantities
+ *
+ * The offset and count of the descriptor are zero.
+ *
+ * @tparam Q  quantity type
+ */
+template<typename U, typename S, typename V, typename T>
+quantity_column_descriptor make_quantity_column_descriptor() {
+	static_assert(std::is_arithmetic<V>::value, "only quantities with arithmetic value types can be stored in columns");
+	quantity_column_descriptor descriptor{};
+	descriptor.exponents  = detail::pack_exponents<U,T>();
+	descriptor.scale_num  = S::num;
+	descriptor.scale_den  = S::den;
+	descriptor.value_kind = static_cast<std::uint8_t>(detail::get_column_value_kind<V>());
+	descriptor.value_size = sizeof(V);
+	descriptor.tag_id     = detail::dynamic_tag_traits<T>::id;
+	detail::copy_column_name<U,S,T>(descriptor.name, literals::is_quantity_string_specialized<U,S,T>{});
+	return descriptor;
+}
+template<typename Q>
+quantity_column_descriptor make_quantity_column_descriptor()              {return make_quantity_column_descriptor< typename Q::unit_type, typename Q::scale_type
+                                                                                                                 , typename Q::value_type, typename Q::tag_type>();}
+/** @} */
+
+namespace detail {
+
+/* available is the number of bytes following the header (if known) */
+inline void check_columns_header(const quantity_columns_header& header, std::uint64_t available = std::numeric_limits<std::uint64_t>::max()) {
+	if(std::memcmp(header.magic, "UNLIBCOL", sizeof(header.magic)) != 0)
+		throw column_format_error("not a quantity column file");
+	if(header.byte_order != quantity_columns_header::byte_order_mark)
+		throw column_format_error("quantity column file has a different byte order");
+	if(header.version != quantity_columns_header::current_version)
+		throw column_format_error("unsupported quantity column file version");
+	if(header.column_count > available / sizeof(quantity_column_descriptor))
+		throw column_format_error("unexpected end of quantity column file");
+}
+
+/* throws if a column's values are not within a file of file_size bytes,
+ * or if its scale is invalid */
+inline void check_column_descriptor(const quantity_column_descriptor& descriptor, std::uint64_t file_size) {
+	if( descriptor.offset % quantity_columns_alignment != 0
+	 or descriptor.offset > file_size
+	 or (file_size - descriptor.offset) / (descriptor.value_size ? descriptor.value_size : 1) < descriptor.count )
+		throw column_format_error("quantity column exceeds quantity column file");
+	if(descriptor.scale_num <= 0 or descriptor.scale_den <= 0)
+		throw column_format_error("quantity column has an invalid scale");
+}
+
+inline std::string get_column_name(const quantity_column_descriptor& descriptor) {
+	const auto end = static_cast<const char*>(std::memchr(descriptor.name, '\0', sizeof(descriptor.name)));
+	return std::string(descriptor.name, end ? end : descriptor.name + sizeof(descriptor.name));
+}
+
+/* throws if a column doesn't match Q */
+template<typename Q>
+void check_column(const quantity_column_descriptor& actual, bool is_rescalable) {
+	const quantity_column_descriptor expected = make_quantity_column_descriptor<Q>();
+	if(actual.exponents != expected.exponents or actual.tag_id != expected.tag_id)
+		throw column_format_error("quantity column has a different unit: " + get_column_name(actual));
+	if(actual.value_kind != expected.value_kind or actual.value_size != expected.value_size)
+		throw column_format_error("quantity column has a different value type");
+	if((actual.scale_num != expected.scale_num or actual.scale_den != expected.scale_den) and not is_rescalable)
+		throw column_format_error("quantity column has a different scale: " + get_column_name(actual));
+}
+
+}
+
+/**
+ * @brief Write columns of quantities to a stream
+ *
+ * This writes a column file containing one column per span passed. The
+ * values are written as they are stored in memory.
+ *
+ * @note Errors are reported through the stream's state.
+ *
+ * @param      os  stream to write to (should be opened in binary mode)
+ * @param columns  spans referring to the quantities of each column
+ *
+ * @code
+ * std::ofstream ofs("meter.col", std::ios_base::binary);
+ * write_quantity_columns(ofs, make_quantity_span(energy), make_quantity_span(power));
+ */
+template<typename... Qs>
+void write_quantity_columns(std::ostream& os, quantity_span<Qs>... columns) {
+	quantity_columns_header header{};
+	std::memcpy(header.magic, "UNLIBCOL", sizeof(header.magic));
+	header.byte_order   = quantity_columns_header::byte_order_mark;
+	header.version      = quantity_columns_header::current_version;
+	header.column_count = sizeof...(Qs);
+
+	quantity_column_descriptor descriptors[] = {make_quantity_column_descriptor<std::remove_const_t<Qs>>()..., quantity_column_descriptor{}};
+	const std::size_t counts[] = {columns.size()..., 0};
+	const std::size_t value_sizes[] = {sizeof(typename quantity_span<Qs>::value_type)..., 0};
+
+	std::uint64_t pos = sizeof(header) + sizeof...(Qs) * sizeof(quantity_column_descriptor);
+	for(std::size_t idx=0; idx<sizeof...(Qs); ++idx) {
+		descriptors[idx].offset = detail::align_column_offset(pos);
+		descriptors[idx].count  = counts[idx];
+		pos = descriptors[idx].offset + counts[idx] * value_sizes[idx];
+	}
+
+	os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	os.write(reinterpret_cast<const char*>(descriptors), static_cast<std::streamsize>(sizeof...(Qs) * sizeof(quantity_column_descriptor)));
+
+	pos = sizeof(header) + sizeof...(Qs) * sizeof(quantity_column_descriptor);
+	using expander = int[];
+	(void)expander{0, (detail::write_column_values(os, pos, columns), 0)...};
+}
+
+/**
+ * @brief Reader for column files
+ *
+ * Constructing a reader reads and validates the file header and the column
+ * descriptors. Columns can then be checked against and read into quantity
+ * types. Columns are read into memory with a single read operation. If the
+ * scale of a floating point column differs from the requested one, the
+ * values are rescaled afterwards.
+ *
+ * @code
+ * std::ifstream ifs("meter.col", std::ios_base::binary);
+ * quantity_column_reader reader(ifs);
+ * const auto energy = reader.read_column<kilo<watt_hour<double>>>(0);
+ */
+class quantity_column_reader {
+public:
+	/**
+	 * @brief Read the header and column descriptors of a column file
+	 *
+	 * @param is  stream to read from (should be opened in binary mode)
+	 *
+	 * @throw column_format_error if the stream does not start with a valid
+	 *        column file header, or if column descriptors are invalid
+	 */
+	explicit quantity_column_reader(std::istream& is)                     : is_{is}, descriptors_{}, file_size_{unknown_size} {
+		quantity_columns_header header;
+		read(&header, sizeof(header));
+		const std::uint64_t available = get_remaining_size();
+		if(available != unknown_size)
+			file_size_ = sizeof(header) + available;
+		detail::check_columns_header(header, available);
+		// the count cannot be checked against the size of unseekable
+		// streams, so descriptors are read one by one
+		for(std::uint64_t idx=0; idx<header.column_count; ++idx) {
+			quantity_column_descriptor descriptor;
+			read(&descriptor, sizeof(descriptor));
+			detail::check_column_descriptor(descriptor, file_size_);
+			descriptors_.push_back(descriptor);
+		}
+	}
+
+	std::size_t                       get_column_count()            const {return descriptors_.size();}
+	const quantity_column_descriptor& get_descriptor(std::size_t idx) const
+	                                                                      {return descriptors_.at(idx);}
+
+	/**
+	 * @brief Check whether a column can be read into a quantity type
+	 *
+	 * @tparam Q  quantity type
+	 *
+	 * @param idx  column index
+	 *
+	 * @throw column_format_error if the column's unit, tag, or value type do
+	 *        not match those of Q, or if Q is of an integral value type and
+	 *        the scales do not match
+	 */
+	template<typename Q>
+	void check_column(std::size_t idx) const                              {detail::check_column<Q>(get_descriptor(idx), std::is_floating_point<typename Q::value_type>::value);}
+
+	/**
+	 * @brief Read a column into a span of quantities
+	 *
+	 * @param idx  column index
+	 * @param out  span to read into; must have the size of the column
+	 *
+	 * @throw column_format_error if the column does not match the quantity
+	 *        type or the span size, or if the stream ends prematurely
+	 */
+	template<typename Q>
+	void read_column(std::size_t idx, quantity_span<Q> out) {
+		static_assert(not std::is_const<Q>::value, "cannot read into a span of const quantities");
+		check_column<Q>(idx);
+		const quantity_column_descriptor& descriptor = get_descriptor(idx);
+		if(descriptor.count != out.size())
+			throw column_format_error("span size does not match quantity column size");
+		is_.clear();
+		is_.seekg(static_cast<std::streamoff>(descriptor.offset));
+		read(out.values(), out.size() * sizeof(*out.values()));
+		rescale(descriptor, out, std::is_floating_point<typename Q::value_type>{});
+	}
+
+	/**
+	 * @brief Read a column into a quantity_vector
+	 *
+	 * @param idx  column index
+	 *
+	 * @throw column_format_error if the column does not match the quantity
+	 *        type, if the stream ends prematurely, or if it cannot tell its
+	 *        size (which is needed to check the column's size before
+	 *        allocating memory for it)
+	 */
+	template<typename Q>
+	quantity_vector< typename Q::unit_type, typename Q::scale_type
+	               , typename Q::value_type, typename Q::tag_type > read_column(std::size_t idx) {
+		check_column<Q>(idx);
+		if(file_size_ == unknown_size)
+			throw column_format_error("quantity columns can only be read from seekable streams");
+		quantity_vector< typename Q::unit_type, typename Q::scale_type
+		               , typename Q::value_type, typename Q::tag_type > result(static_cast<std::size_t>(get_descriptor(idx).count));
+		read_column(idx, make_quantity_span(result));
+		return result;
+	}
+
+private:
+	static constexpr std::uint64_t unknown_size = std::numeric_limits<std::uint64_t>::max();
+
+	std::istream&                                   is_;
+	std::vector<quantity_column_descriptor>         descriptors_;
+	std::uint64_t                                   file_size_;
+
+	void read(void* buffer, std::size_t size) {
+		if(not is_.read(static_cast<char*>(buffer), static_cast<std::streamsize>(size)))
+			throw column_format_error("unexpected end of quantity column file");
+	}
+
+	/* the number of bytes following the current position, if the stream
+	 * can tell, and the maximum value otherwise */
+	std::uint64_t get_remaining_size() {
+		const std::istream::pos_type pos = is_.tellg();
+		if(pos == std::istream::pos_type(-1))
+			return unknown_size;
+		is_.seekg(0, std::ios_base::end);
+		const std::istream::pos_type end = is_.tellg();
+		is_.clear();
+		is_.seekg(pos);
+		if(end == std::istream::pos_type(-1) or end < pos)
+			return unknown_size;
+		return static_cast<std::uint64_t>(end - pos);
+	}
+
+	template<typename Q>
+	static void rescale(const quantity_column_descriptor& descriptor, quantity_span<Q> out, std::true_type) {
+		using value_type = typename Q::value_type;
+		using scale_type = typename Q::scale_type;
+		if(descriptor.scale_num == scale_type::num and descriptor.scale_den == scale_type::den)
+			return;
+		const auto factor = static_cast<value_type>( static_cast<long double>(descriptor.scale_num) * scale_type::den
+		                                           / (static_cast<long double>(descriptor.scale_den) * scale_type::num) );
+		value_type* values = out.values();
+		for(std::size_t idx=0; idx<out.size(); ++idx)
+			values[idx] *= factor;
+	}
+	template<typename Q>
+	static void rescale(const quantity_column_descriptor&, quantity_span<Q>, std::false_type) {}
+};
+
+}
+
+#endif //UNLIB_QUANTITY_COLUMNS_HPP
@@ -0,0 +1,134 @@
+#ifndef UNLIB_QUANTITY_FWD_HPP
+#define UNLIB_QUANTITY_FWD_HPP
+
+/*
+ * quantity_fwd.hpp
+ *
+ * Copyright sbi http://stackoverflow.com/users/140719
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *     http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <cstdint>
+#include <ratio>
+#include <type_traits>
+
+#include <unlib/unit.hpp>
+#include <unlib/scaling.hpp>
+#include <unlib/tag.hpp>
+
+/*
+ * This declares the quantity template and the meta functions creating
+ * quantity types, without defining quantities. Including this is enough to
+ * name quantity types (e.g., in function declarations), which is a lot
+ * cheaper than including quantity.hpp.
+ */
+
+namespace unlib {
+
+/**
+ * @brief Quantity type
+ *
+ * This is a container for a value of ValueType, of the physical unit Unit,
+ * with the scale Scale, and the tag Tag. It is meant to be used mostly like
+ * ValueType would be used. For that, it overrides the necessary operators of
+ * the built-in numeric types.
+ *
+ * @tparam       Unit   the quantity's unit type
+ * @tparam      Scale   the quantity's scale
+ * @tparam  ValueType   the quantity's value type
+ * @tparam        Tag   the quantity's tag
+ */
+template< typename Unit
+        , typename Scale     = no_scaling
+        , typename ValueType = double
+        , typename Tag       = no_tag >
+class quantity;
+
+template<typename T>                                     struct is_quantity                    : std::false_type {};
+template<typename U, typename S, typename V, typename T> struct is_quantity<quantity<U,S,V,T>> : std::true_type {};
+
+namespace detail {
+
+/* the nested types of a quantity, which can be obtained without defining it */
+template<typename Q>
+struct quantity_types {
+	using  unit_type = typename Q:: unit_type;
+	using scale_type = typename Q::scale_type;
+	using value_type = typename Q::value_type;
+	using   tag_type = typename Q::  tag_type;
+};
+template< std::uint64_t UnitExponents
+        , std::intmax_t ScaleNum, std::intmax_t ScaleDen
+        , typename ValueType
+        , typename TagID, std::intmax_t TagNum, std::intmax_t TagDen >
+struct quantity_types<quantity< packed_unit<UnitExponents>
+                              , std::ratio<ScaleNum,ScaleDen>
+                              , ValueType
+                              , tag<TagID,std::ratio<TagNum,TagDen>> >> {
+	using  unit_type = packed_unit<UnitExponents>;
+	using scale_type = scale_t<ScaleNum,ScaleDen>;
+	using value_type = ValueType;
+	using   tag_type = tag_t<TagID,TagNum,TagDen>;
+};
+
+template<typename Q> using  unit_type_t = typename quantity_types<Q>:: unit_type;
+template<typename Q> using scale_type_t = typename quantity_types<Q>::scale_type;
+template<typename Q> using value_type_t = typename quantity_types<Q>::value_type;
+template<typename Q> using   tag_type_t = typename quantity_types<Q>::  tag_type;
+
+}
+
+/**
+ * @{
+ *
+ * @brief Result type for multiplying/dividing value types
+ */
+template<typename V1, typename V2> using mul_value_t = decltype(V1{}*V2{});
+template<typename V1, typename V2> using div_value_t = decltype(V1{}/V2{});
+template<typename V1, typename V2> using mod_value_t = decltype(V1{}%V2{});
+/** @} */
+
+
+/* quantity type manipulations ***********************************************/
+
+/**
+ * @{
+ *
+ * Calculate the types needed when multiplying/dividing quantities.
+ */
+template<typename Q1, typename Q2  > using  mul_quantity_t = quantity<  mul_unit_t <detail:: unit_type_t<Q1>, detail:: unit_type_t<Q2>>
+                                                                     ,  mul_scale_t<detail::scale_type_t<Q1>, detail::scale_type_t<Q2>>
+                                                                     ,  mul_value_t<detail::value_type_t<Q1>, detail::value_type_t<Q2>>
+                                                                     ,  mul_tag_t  <detail::  tag_type_t<Q1>, detail::  tag_type_t<Q2>> >;
+template<typename Q1, typename Q2  > using  div_quantity_t = quantity<  div_unit_t <detail:: unit_type_t<Q1>, detail:: unit_type_t<Q2>>
+                                                                     ,  div_scale_t<detail::scale_type_t<Q1>, detail::scale_type_t<Q2>>
+                                                                     ,  div_value_t<detail::value_type_t<Q1>, detail::value_type_t<Q2>>
+                                                                     ,  div_tag_t  <detail::  tag_type_t<Q1>, detail::  tag_type_t<Q2>> >;
+
+template<typename Q, typename Ratio> using  pow_quantity_t = quantity< pow_unit_t <detail:: unit_type_t<Q>, Ratio>
+                                                                     , pow_scale_t<detail::scale_type_t<Q>, Ratio>
+                                                                     ,             detail::value_type_t<Q>
+                                                                     , pow_tag_t  <detail::  tag_type_t<Q>, Ratio> >;
+template<typename Q                > using sqrt_quantity_t = pow_quantity_t<Q,std::ratio<1,2>>;
+template<typename Q                > using cbrt_quantity_t = pow_quantity_t<Q,std::ratio<1,3>>;
+/** @} */
+
+
+/* quantity scaling **********************************************************/
+
+namespace detail {
+
+/* This allows quantities to be scaled using milli<q> and to_milli<q> */
+template<typename NewScale, typename U, typename S, typename V, typename T>
+struct scale_by<NewScale, quantity<U,S,V,T>>                    {using type = quantity<unit_type_t<quantity<U,S,V,T>>, std::ratio_multiply<NewScale,scale_type_t<quantity<U,S,V,T>>>, V, tag_type_t<quantity<U,S,V,T>>>;};
+template<typename NewScale, typename U, typename S, typename V, typename T>
+struct scale_to<NewScale, quantity<U,S,V,T>>                    {using type = quantity<unit_type_t<quantity<U,S,V,T>>, NewScale                                              , V, tag_type_t<quantity<U,S,V,T>>>;};
+
+}
+
+}
+
+#endif /* UNLIB_QUANTITY_FWD_HPP */
@@ -0,0 +1,608 @@
+#ifndef UNLIB_QUANTITY_IO_HPP
+#define UNLIB_QUANTITY_IO_HPP
+
+/*
+ * quantity_io.hpp
+ *
+ * Copyright sbi http://stackoverflow.com/users/140719
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *     http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <cerrno>
+#include <clocale>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#if defined(__has_include)
+#	if __has_include(<charconv>) and (__cplusplus >= 201703L or (defined(_MSVC_LANG) and _MSVC_LANG >= 201703L))
+#		include <charconv>
+#	endif
+#endif
+
+/* Floating point values are formatted by to_chars() using std::to_chars()
+ * where the standard library provides it. Otherwise, a fallback is used that
+ * finds the shortest round-tripping representation using std::snprintf(). */
+#if !defined(UNLIB_USE_STD_TO_CHARS)
+#	if defined(__cpp_lib_to_chars)
+#		define UNLIB_USE_STD_TO_CHARS 1
+#	else
+#		define UNLIB_USE_STD_TO_CHARS 0
+#	endif
+#endif
+
+/* Likewise, floating point values are parsed by from_chars() using
+ * std::from_chars() where available, and std::strtod() and friends otherwise. */
+#if !defined(UNLIB_USE_STD_FROM_CHARS)
+#	if defined(__cpp_lib_to_chars)
+#		define UNLIB_USE_STD_FROM_CHARS 1
+#	else
+#		define UNLIB_USE_STD_FROM_CHARS 0
+#	endif
+#endif
+
+#include <unlib/quantity.hpp>
+
+/*
+ * This provides the strings for quantities' units, and converting quantities
+ * from and to strings. Stream operators are in quantity_stream.hpp.
+ */
+
+namespace unlib {
+
+/* I/O ***********************************************************************/
+
+namespace literals {
+
+/**
+ * Specializations of this template define the prefixes applied to unit
+ * strings for different scaling (e.g., "k" for kilo or "M" for mega).
+ * Prefixes for all ISO scalings are pre-defined using the @sq
+ * UNLIB_DEFINE_SCALE_LITERAL_TRAITS() macro.
+ *
+ * Except when inventing a proprietary scaling, users should have no need to
+ * define their own specializations of this template. Usually it's better to
+ * define a @sq quantity_traits specialization.
+ *
+ * @tparam S  Scaling to define a prefix string for
+ */
+template<typename S>
+struct scaling_traits {
+	using is_specialized = std::false_type;
+};
+
+/** Find out whether scaling_traits is specialized for a specific scaling */
+template<typename S>
+using is_scaling_string_specialized = typename scaling_traits<S>::is_specialized;
+
+/**
+ * Specializations of this template define the unit strings for different
+ * units (like "m" for meter). Units who invent their own units can
+ * specialize this to define unit strings for those.
+ *
+ * @note Specializations of this must have a static function `get_string()`.
+ *       (The @sa UNLIB_DEFINE_UNIT_LITERAL_TRAITS() macro is a convenient way
+ *       to create fully conforming specializations.)
+ *
+ * @tparam U  Unit to define string for
+ * @tparam T  Tag to define string for
+ */
+template<typename U, typename T>
+struct unit_traits {
+	using is_specialized = std::false_type;
+	static constexpr const auto& get_string() {return "";}
+};
+
+/** Find out whether unit_traits is specialized for a specific unit and tag */
+template<typename U, typename T>
+using is_unit_string_specialized = typename unit_traits<U,T>::is_specialized;
+
+
+namespace detail {
+
+/* a C++14 static string. */
+template<std::size_t StrLen>
+struct static_string {
+	char array[StrLen+1];
+};
+
+/* a C++14 constexpr string copy */
+template<std::size_t StrSize>
+inline constexpr auto copy_static_string(char* to, const char (&from)[StrSize]) {
+	for(std::size_t idx=0; idx<StrSize-1; ++idx)
+		to[idx] = from[idx];
+	return to + StrSize-1;
+}
+
+/* constexpr-creating the unit string for a quantity */
+template<std::size_t QuantityStrLen, std::size_t ScalingStrSize, std::size_t UnitStrSize>
+constexpr auto make_quantity_string( const char (&scaling_str)[ScalingStrSize]
+                                   , const char (&   unit_str)[   UnitStrSize] ) {
+	static_string<QuantityStrLen> quantity_str{};
+	char* it = quantity_str.array;
+	it = copy_static_string(it, scaling_str);
+	     copy_static_string(it,    unit_str);
+	return quantity_str;
+}
+
+template<typename U, typename S, typename T>
+struct quantity_string_traits {
+	using  unit_type = U;
+	using scale_type = S;
+	using   tag_type = T;
+
+	using scaling_tr = scaling_traits<scale_type>;
+	using    unit_tr =    unit_traits<unit_type, tag_type>;
+
+	static constexpr std::size_t scaling_strlen = sizeof(scaling_tr::get_string()) - 1;
+	static constexpr std::size_t    unit_strlen = sizeof(   unit_tr::get_string()) - 1;
+	static constexpr std::size_t         strlen = scaling_strlen + unit_strlen;
+
+	static constexpr static_string<strlen> string{ make_quantity_string<strlen>(scaling_tr::get_string()
+	                                                                           ,   unit_tr::get_string()) };
+};
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated"
+// in C++14, this is still necessary
+template<typename U, typename S, typename T>
+constexpr static_string<quantity_string_traits<U,S,T>::strlen> quantity_string_traits<U,S,T>::string;
+#pragma GCC diagnostic pop
+
+}
+
+/**
+ * The generic version of this template obtains a compile-time string
+ * representing the unit, scale, and tag of a quantity by referring to @sa
+ * scale_traits and @sa unit_traits.
+ *
+ * Specializations of this define the strings for quantities (like "nm" for
+ * nanometer and "kt" for kilotons). Usually, specializing @sa unit_traits
+ * will be more convenient than specializing this, because it allows the
+ * automatic combination with scaling prefixes. But sometimes units scale
+ * irregularly (kilotons), and then this template can be specialized.
+ *
+ * @note Specializations of this must have a static_string member named
+ *       `get_string()`. (The @sa UNLIB_DEFINE_QUANTITY_LITERAL_TRAITS() and
+ *       the @sa UNLIB_DEFINE_SCALED_QUANTITY_LITERAL_TRAITS() macros are
+ *       convenient ways to create such specializations.)
+ *
+ * @tparam U  the quantity's unit type
+ * @tparam S  the quantity's scale type
+ * @tparam T  the quantity's tag type
+ */
+template<typename U, typename S, typename T>
+struct quantity_traits {
+	using is_specialized = std::integral_constant<bool, is_scaling_string_specialized<S  >::value
+	                                                   and is_unit_string_specialized<U,T>::value>;
+	static constexpr const auto& get_string() {return detail::quantity_string_traits<U,S,T>::string.array;}
+};
+
+/** Find out whether quantity_traits is specialized for a specific unit, scaling, and tag */
+template<typename U, typename S, typename T>
+using is_quantity_string_specialized = typename quantity_traits<U,S,T>::is_specialized;
+
+
+/**
+ * @{
+ *
+ * Get a reference to a char array or a C++ string containing the unit string
+ * for a quantity.
+ *
+ * @tparam Q  the quantity
+ * @tparam U  the quantity's unit type
+ * @tparam S  the quantity's scale type
+ * @tparam V  the quantity's value type
+ * @tparam T  the quantity's tag type
+ *
+ * @param q  a quantity (its value is irrelevant)
+ *
+ * @return String for the unit, scale, and tag of the quantity
+ */
+template<typename U, typename S, typename V, typename T>
+const auto& get_quantity_c_str(const quantity<U,S,V,T>&)                  {return literals::quantity_traits<U,S,T>::get_string();}
+template<typename Q>
+const auto& get_quantity_c_str()                                          {return get_quantity_c_str(Q{});}
+
+template<typename U, typename S, typename V, typename T>
+std::string get_quantity_string(const quantity<U,S,V,T>& q)               {return get_quantity_c_str(q);}
+template<typename Q>
+std::string get_quantity_string()                                         {return get_quantity_c_str<Q>();}
+/** @} */
+
+}
+
+namespace detail {
+
+template<typename U, typename S, typename V, typename T>
+std::string to_string(const quantity<U,S,V,T>& q, std::false_type)        {using std::to_string; return to_string(q.get());}
+template<typename U, typename S, typename V, typename T>
+std::string to_string(const quantity<U,S,V,T>& q, std::true_type)         {
+	                                                                          return detail::to_string( q
+	                                                                                                  , std::false_type{})
+	                                                                        + ' '
+	                                                                        + literals::get_quantity_string(q);
+	                                                                      }
+
+}
+
+template<typename U, typename S, typename V, typename T>
+std::string to_string(const quantity<U,S,V,T>& q)                         {
+	                                                                          return detail::to_string( q
+	                                                                                                  , literals::is_quantity_string_specialized<U,S,T>{} );
+	                                                                      }
+
+
+/** Result of to_chars(). Like std::to_chars_result, which is C++17. */
+struct to_chars_result {
+	char*     ptr;
+	std::errc ec;
+};
+
+namespace detail {
+
+inline to_chars_result copy_chars(char* first, char* last, const char* str, std::size_t len) {
+	if(static_cast<std::size_t>(last-first) < len)
+		return {last, std::errc::value_too_large};
+	std::memcpy(first, str, len);
+	return {first+len, std::errc{}};
+}
+
+template<typename V>
+to_chars_result value_to_chars(char* first, char* last, V v, std::true_type /*is_integral*/) {
+	using unsigned_type = std::make_unsigned_t<V>;
+	char buffer[std::numeric_limits<V>::digits10 + 2];
+	char* const end = buffer + sizeof(buffer);
+	char* it = end;
+	unsigned_type u = v < V{} ? static_cast<unsigned_type>(unsigned_type{} - static_cast<unsigned_type>(v))
+	                          : static_cast<unsigned_type>(v);
+	static constexpr char digit_pairs[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+	                                      "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+	                                      "8081828384858687888990919293949596979899";
+	while(u >= 100) {
+		const auto pair = static_cast<std::size_t>(u % 100) * 2;
+		u = static_cast<unsigned_type>(u / 100);
+		*--it = digit_pairs[pair+1];
+		*--it = digit_pairs[pair  ];
+	}
+	if(u >= 10) {
+		const auto pair = static_cast<std::size_t>(u) * 2;
+		*--it = digit_pairs[pair+1];
+		*--it = digit_pairs[pair  ];
+	} else {
+		*--it = static_cast<char>('0' + u);
+	}
+	if(v < V{})
+		*--it = '-';
+	return copy_chars(first, last, it, static_cast<std::size_t>(end-it));
+}
+
+#if UNLIB_USE_STD_TO_CHARS
+template<typename V>
+to_chars_result value_to_chars(char* first, char* last, V v, std::false_type /*is_integral*/) {
+	const auto result = std::to_chars(first, last, v);
+	return {result.ptr, result.ec};
+}
+#else
+inline int  format_floatpt(char* buf, std::size_t size, int precision, double      v) {return std::snprintf(buf, size, "%.*g" , precision, v);}
+inline int  format_floatpt(char* buf, std::size_t size, int precision, long double v) {return std::snprintf(buf, size, "%.*Lg", precision, v);}
+inline void  parse_floatpt(const char* buf, float&       v)           {v = std::strtof (buf, nullptr);}
+inline void  parse_floatpt(const char* buf, double&      v)           {v = std::strtod (buf, nullptr);}
+inline void  parse_floatpt(const char* buf, long double& v)           {v = std::strtold(buf, nullptr);}
+
+template<typename V>
+to_chars_result value_to_chars(char* first, char* last, V v, std::false_type /*is_integral*/) {
+	using format_type = std::conditional_t<std::is_same<V,long double>::value, long double, double>;
+	char buffer[64];
+	int len = 0;
+	for(int precision = std::numeric_limits<V>::digits10; ; ++precision) {
+		len = format_floatpt(buffer, sizeof(buffer), precision, static_cast<format_type>(v));
+		V parsed{};
+		parse_floatpt(buffer, parsed);
+		if(parsed == v or precision >= std::numeric_limits<V>::max_digits10)
+			break;
+	}
+	// snprintf() uses the current locale's decimal separator
+	for(int idx=0; idx<len; ++idx)
+		if(buffer[idx] == ',')
+			buffer[idx] = '.';
+	return copy_chars(first, last, buffer, static_cast<std::size_t>(len));
+}
+#endif
+
+template<typename U, typename S, typename V, typename T>
+to_chars_result to_chars(char* first, char* last, const quantity<U,S,V,T>& q, std::false_type)
+                                                                          {return value_to_chars(first, last, q.get(), std::is_integral<V>{});}
+template<typename U, typename S, typename V, typename T>
+to_chars_result to_chars(char* first, char* last, const quantity<U,S,V,T>& q, std::true_type) {
+	const auto& str = literals::quantity_traits<U,S,T>::get_string();
+	const std::size_t len = sizeof(str) - 1;
+	auto result = detail::to_chars(first, last, q, std::false_type{});
+	if(result.ec != std::errc{})
+		return result;
+	if(static_cast<std::size_t>(last-result.ptr) < len+1)
+		return {last, std::errc::value_too_large};
+	*result.ptr++ = ' ';
+	return copy_chars(result.ptr, last, str, len);
+}
+
+}
+
+/**
+ * @brief Format a quantity into a character buffer
+ *
+ * This writes the value, and, if one is defined for the quantity, a space
+ * and the quantity's unit string into [first,last), without allocating
+ * memory. Integer values are written exactly, floating point values in the
+ * shortest representation that reads back as the same value, independent
+ * of the current locale. (This differs from the text to_string() creates,
+ * which has a fixed number of decimals.)
+ *
+ * @param first  start of the buffer
+ * @param  last  end of the buffer
+ * @param     q  the quantity
+ *
+ * @return On success, a result with ptr pointing past the last character
+ *         written and a value-initialized ec. If the buffer is too small,
+ *         a result with ptr==last and ec==std::errc::value_too_large (the
+ *         buffer's content is unspecified then).
+ *
+ * @note Like std::to_chars(), this does not null-terminate the output.
+ */
+template<typename U, typename S, typename V, typename T>
+to_chars_result to_chars(char* first, char* last, const quantity<U,S,V,T>& q) {
+	                                                                          return detail::to_chars( first, last, q
+	                                                                                                 , literals::is_quantity_string_specialized<U,S,T>{} );
+	                                                                      }
+
+
+/** Error codes reported by from_chars() */
+enum class from_chars_errc {
+	ok                 /**< success */
+,	invalid_value      /**< the input does not start with a number */
+,	value_out_of_range /**< the value cannot be represented by the quantity */
+,	unit_mismatch      /**< the unit string does not denote the quantity's unit */
+};
+
+/** Result of from_chars(). Like std::from_chars_result, which is C++17. */
+struct from_chars_result {
+	const char*     ptr;
+	from_chars_errc ec;
+};
+
+namespace detail {
+
+template<typename V>
+from_chars_result value_from_chars(const char* first, const char* last, V& v, std::true_type /*is_integral*/) {
+	using unsigned_type = std::make_unsigned_t<V>;
+	const char* it = first;
+	const bool negative = std::is_signed<V>::value and it != last and *it == '-';
+	if(negative)
+		++it;
+	const unsigned_type limit = negative ? static_cast<unsigned_type>(static_cast<unsigned_type>(-(std::numeric_limits<V>::lowest()+1)) + 1u)
+	                                     : static_cast<unsigned_type>(std::numeric_limits<V>::max());
+	const auto cutoff = static_cast<unsigned_type>(limit / 10);
+	const auto cutlim = static_cast<unsigned_type>(limit % 10);
+	const char* const digits = it;
+	unsigned_type u{};
+	bool overflow = false;
+	for(; it != last and *it >= '0' and *it <= '9'; ++it) {
+		const auto digit = static_cast<unsigned_type>(*it - '0');
+		if(u > cutoff or (u == cutoff and digit > cutlim))
+			overflow = true;
+		else
+			u = static_cast<unsigned_type>(u * 10 + digit);
+	}
+	if(it == digits)
+		return {first, from_chars_errc::invalid_value};
+	if(overflow)
+		return {it, from_chars_errc::value_out_of_range};
+	v = negative ? static_cast<V>(-static_cast<V>(u-1u) - 1) : static_cast<V>(u);
+	return {it, from_chars_errc::ok};
+}
+
+#if UNLIB_USE_STD_FROM_CHARS
+template<typename V>
+from_chars_result value_from_chars(const char* first, const char* last, V& v, std::false_type /*is_integral*/) {
+	const auto result = std::from_chars(first, last, v);
+	if(result.ec == std::errc{})
+		return {result.ptr, from_chars_errc::ok                };
+	else if(result.ec == std::errc::result_out_of_range)
+		return {result.ptr, from_chars_errc::value_out_of_range};
+	else
+		return {first     , from_chars_errc::invalid_value     };
+}
+#else
+inline void parse_floatpt(const char* buf, char** end, float&       v) {v = std::strtof (buf, end);}
+inline void parse_floatpt(const char* buf, char** end, double&      v) {v = std::strtod (buf, end);}
+inline void parse_floatpt(const char* buf, char** end, long double& v) {v = std::strtold(buf, end);}
+
+template<typename V>
+from_chars_result value_from_chars(const char* first, const char* last, V& v, std::false_type /*is_integral*/) {
+	// strtod() and friends need a null-terminated string using the current
+	// locale's decimal separator, and they accept leading blanks and '+'
+	if(first == last or *first == '+' or *first == ' ')
+		return {first, from_chars_errc::invalid_value};
+	char buffer[64];
+	std::size_t len = 0;
+	const char decimal_point = *std::localeconv()->decimal_point;
+	for(const char* it=first; it != last and len < sizeof(buffer)-1 and std::strchr("0123456789+-.eEinfatyINFATY", *it) and *it; ++it)
+		buffer[len++] = *it == '.' ? decimal_point : *it;
+	buffer[len] = '\0';
+	char* end = buffer;
+	V parsed{};
+	errno = 0;
+	parse_floatpt(buffer, &end, parsed);
+	if(end == buffer)
+		return {first, from_chars_errc::invalid_value};
+	if(errno == ERANGE)
+		return {first + (end-buffer), from_chars_errc::value_out_of_range};
+	v = parsed;
+	return {first + (end-buffer), from_chars_errc::ok};
+}
+#endif
+
+template<typename... Scales>
+struct scale_list {};
+
+template<typename... Lists> struct concat_scale_lists;
+template<typename... S1>
+struct concat_scale_lists<scale_list<S1...>>                              {using type = scale_list<S1...>;};
+template<typename... S1, typename... S2, typename... Lists>
+struct concat_scale_lists<scale_list<S1...>, scale_list<S2...>, Lists...> : concat_scale_lists<scale_list<S1..., S2...>, Lists...> {};
+
+template<typename Base>
+using prefixed_scales = scale_list< std::ratio_multiply< atto_scaling,Base>, std::ratio_multiply<femto_scaling,Base>
+                                  , std::ratio_multiply< pico_scaling,Base>, std::ratio_multiply< nano_scaling,Base>
+                                  , std::ratio_multiply<micro_scaling,Base>, std::ratio_multiply<milli_scaling,Base>
+                                  , std::ratio_multiply<centi_scaling,Base>, std::ratio_multiply< deci_scaling,Base>
+                                  , Base
+                                  , std::ratio_multiply< deca_scaling,Base>, std::ratio_multiply<hecto_scaling,Base>
+                                  , std::ratio_multiply< kilo_scaling,Base>, std::ratio_multiply< mega_scaling,Base>
+                                  , std::ratio_multiply< giga_scaling,Base>, std::ratio_multiply< tera_scaling,Base> >;
+
+/* the scales from_chars() looks for unit strings for */
+using parsable_scales = typename concat_scale_lists< prefixed_scales<    no_scaling>
+                                                   , prefixed_scales<minute_scaling>
+                                                   , prefixed_scales<  hour_scaling>
+                                                   , prefixed_scales<   day_scaling>
+                                                   , prefixed_scales<  week_scaling> >::type;
+
+constexpr std::intmax_t gcd(std::intmax_t a, std::intmax_t b)            {return b == 0 ? a : gcd(b, a % b);}
+constexpr bool          product_fits(std::intmax_t a, std::intmax_t b)   {return a <= std::numeric_limits<std::intmax_t>::max() / b;}
+
+/* whether values can be rescaled from From to To without std::ratio overflowing */
+template<typename From, typename To>
+constexpr bool is_rescalable() {
+	return product_fits(From::num / gcd(From::num,To::num), To  ::den / gcd(From::den,To::den))
+	   and product_fits(From::den / gcd(From::den,To::den), To  ::num / gcd(From::num,To::num));
+}
+
+template<std::size_t StrSize>
+inline bool equals(const char* str, std::size_t len, const char (&s)[StrSize])
+                                                                          {return len == StrSize-1 and std::memcmp(str, s, StrSize-1) == 0;}
+
+template<typename U, typename S, typename V, typename T>
+struct quantity_parser {
+	template<typename Scale>
+	static from_chars_errc rescale_from(V& v, std::true_type /*is_integral*/) {
+		return value_rescaler<S,Scale>::try_rescale_value(v, v) ? from_chars_errc::ok
+		                                                        : from_chars_errc::value_out_of_range;
+	}
+	template<typename Scale>
+	static from_chars_errc rescale_from(V& v, std::false_type /*is_integral*/) {
+		v = rescale_value<S,Scale>(v);
+		return from_chars_errc::ok;
+	}
+
+	template<typename Scale>
+	using is_candidate = std::integral_constant<bool, literals::is_quantity_string_specialized<U,Scale,T>::value
+	                                                  and is_rescalable<Scale,S>()>;
+
+	static from_chars_errc match(const char*, std::size_t, V&, scale_list<>)
+	                                                                      {return from_chars_errc::unit_mismatch;}
+	template<typename Scale, typename... Scales>
+	static from_chars_errc match(const char* str, std::size_t len, V& v, scale_list<Scale,Scales...>)
+	                                                                      {return match<Scale>(str, len, v, is_candidate<Scale>{}, scale_list<Scales...>{});}
+
+	template<typename Scale, typename Scales>
+	static from_chars_errc match(const char* str, std::size_t len, V& v, std::false_type, Scales)
+	                                                                      {return match(str, len, v, Scales{});}
+	template<typename Scale, typename Scales>
+	static from_chars_errc match(const char* str, std::size_t len, V& v, std::true_type, Scales) {
+		if(equals(str, len, literals::quantity_traits<U,Scale,T>::get_string()))
+			return rescale_from<Scale>(v, std::is_integral<V>{});
+		return match(str, len, v, Scales{});
+	}
+};
+
+inline bool is_unit_char(char c) {
+	return (c >= 'a' and c <= 'z') or (c >= 'A' and c <= 'Z') or (c >= '0' and c <= '9') or c == '%' or c == '/';
+}
+
+template<typename U, typename S, typename V, typename T>
+from_chars_result from_chars(const char* first, const char* last, quantity<U,S,V,T>& q, std::false_type) {
+	V v{};
+	const auto result = value_from_chars(first, last, v, std::is_integral<V>{});
+	if(result.ec == from_chars_errc::ok)
+		q = quantity<U,S,V,T>{v};
+	return result;
+}
+template<typename U, typename S, typename V, typename T>
+from_chars_result from_chars(const char* first, const char* last, quantity<U,S,V,T>& q, std::true_type) {
+	V v{};
+	const auto result = value_from_chars(first, last, v, std::is_integral<V>{});
+	if(result.ec != from_chars_errc::ok)
+		return result;
+
+	const char* unit = result.ptr;
+	while(unit != last and *unit == ' ')
+		++unit;
+	const char* unit_end = unit;
+	while(unit_end != last and is_unit_char(*unit_end))
+		++unit_end;
+	const auto len = static_cast<std::size_t>(unit_end-unit);
+
+	using parser = quantity_parser<U,S,V,T>;
+	const auto ec = equals(unit, len, literals::quantity_traits<U,S,T>::get_string())
+	              ? from_chars_errc::ok
+	              : parser::match(unit, len, v, parsable_scales{});
+	if(ec == from_chars_errc::unit_mismatch)
+		return {unit, ec};
+	if(ec == from_chars_errc::ok)
+		q = quantity<U,S,V,T>{v};
+	return {unit_end, ec};
+}
+
+}
+
+/**
+ * @brief Parse a quantity from a character buffer
+ *
+ * This parses a value from [first,last), followed by optional spaces and
+ * the value's unit string, which must be one for the quantity's unit and
+ * tag. If the unit string has a different scale than the quantity (e.g.,
+ * "1500 Wh" parsed into a kilo<watt_hour>), the value is rescaled. Unit
+ * strings are recognized for all quantity strings defined for the quantity's
+ * unit and tag with the scales from atto to tera, optionally multiplied with
+ * one of the time scales (minute to week). If no unit string is defined for
+ * the quantity at all, only the value is parsed.
+ *
+ * Like std::from_chars(), this neither skips leading whitespace nor accepts
+ * a leading '+', and it does not depend on the current locale.
+ *
+ * @param first  start of the input
+ * @param  last  end of the input
+ * @param     q  quantity to parse into; only modified if parsing succeeds
+ *
+ * @return A result with ptr pointing past the parsed characters and
+ *         ec == from_chars_errc::ok on success. On failure, ec is
+ *         - from_chars_errc::invalid_value (ptr == first) if the input does
+ *           not start with a number,
+ *         - from_chars_errc::value_out_of_range if the value does not fit
+ *           the quantity's value type (possibly after rescaling),
+ *         - from_chars_errc::unit_mismatch (ptr pointing to where the unit
+ *           was expected) if the unit string is missing or does not denote
+ *           the quantity's unit and tag.
+ *
+ * @code
+ * kilo<watt_hour<double>> energy;
+ * const auto result = from_chars(str, str+len, energy); // "1500 Wh" => 1.5kWh, "1.5 kW" => unit_mismatch
+ */
+template<typename U, typename S, typename V, typename T>
+from_chars_result from_chars(const char* first, const char* last, quantity<U,S,V,T>& q) {
+	                                                                          return detail::from_chars( first, last, q
+	                                                                                                   , literals::is_quantity_string_specialized<U,S,T>{} );
+	                                                                      }
+
+}
+
+#endif /* UNLIB_QUANTITY_IO_HPP */
@@ -0,0 +1,507 @@
+#ifndef UNLIB_QUANTITY_SPAN_HPP
+#define UNLIB_QUANTITY_SPAN_HPP
+
+/*
+ * quantity_span.hpp
+ *
+ * Copyright sbi http://stackoverflow.com/users/140719
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *     http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include <unlib/quantity.hpp>
+
+namespace unlib {
+
+template<typename Q>
+class quantity_span;
+template<typename Q>
+class strided_quantity_span;
+template<typename View, typename Caster>
+class quantity_cast_view;
+
+template<typename T>                                 struct is_quantity_span                   : std::false_type {};
+template<typename Q>                                 struct is_quantity_span<quantity_span<Q>> : std::true_type {};
+
+/**
+ * Find out whether a type is a view of quantities (quantity_span,
+ * strided_quantity_span, or quantity_cast_view)
+ */
+template<typename T>                                 struct is_quantity_view                                       : std::false_type {};
+template<typename Q>                                 struct is_quantity_view<quantity_span<Q>>                     : std::true_type {};
+template<typename Q>                                 struct is_quantity_view<strided_quantity_span<Q>>             : std::true_type {};
+template<typename View, typename Caster>             struct is_quantity_view<quantity_cast_view<View,Caster>>      : std::true_type {};
+
+namespace detail {
+
+template<typename Container, typename Q>
+using if_container_of_t = std::enable_if_t<std::is_convertible< decltype(std::declval<Container&>().data()), Q* >::value
+                                          and not is_quantity_span<std::remove_const_t<Container>>::value>;
+
+}
+
+/**
+ * @brief Non-owning view of a contiguous sequence of quantities
+ *
+ * This refers to a contiguous sequence of quantities owned by someone else
+ * (e.g., a quantity_vector or a std::vector of quantities). It is meant to be
+ * passed by value to algorithms operating on sequences of quantities.
+ *
+ * @tparam Q  the quantity type (which can be const-qualified)
+ */
+template<typename Q>
+class quantity_span {
+public:
+	using  element_type = Q;                                              /**< the element type (possibly const)  */
+	using quantity_type = std::remove_const_t<Q>;                         /**< the viewed quantities' type        */
+	using     unit_type = typename quantity_type:: unit_type;             /**< the quantities' unit type          */
+	using    scale_type = typename quantity_type::scale_type;             /**< the quantities' scale              */
+	using    value_type = typename quantity_type::value_type;             /**< the quantities' value type         */
+	using      tag_type = typename quantity_type::  tag_type;             /**< the quantities' tag                */
+
+	using       pointer = element_type*;
+	using     reference = element_type&;
+	using      iterator = element_type*;
+	using     size_type = std::size_t;
+
+	static_assert(is_quantity<quantity_type>::value, "quantity_span must refer to quantities");
+	static_assert(has_value_layout<quantity_type>::value, "quantities must have the layout of their value type");
+
+	/** pointer to the quantities' values; const if the quantities are const */
+	using value_pointer = std::conditional_t<std::is_const<Q>::value, const value_type*, value_type*>;
+
+	constexpr quantity_span() noexcept                                    : data_{nullptr}, size_{0} {}
+
+	/**
+	 * @{
+	 *
+	 * @brief Constructors
+	 *
+	 * @param      ptr  pointer to the first quantity
+	 * @param    count  number of quantities
+	 * @param    first  pointer to the first quantity
+	 * @param     last  pointer past the last quantity
+	 * @param      arr  array of quantities
+	 * @param     cont  container of quantities providing data() and size()
+	 * @param    other  span to convert from
+	 */
+	constexpr quantity_span(pointer ptr, size_type count) noexcept        : data_{ptr}, size_{count} {}
+	constexpr quantity_span(pointer first, pointer last) noexcept         : data_{first}, size_{static_cast<size_type>(last-first)} {}
+	template<std::size_t N>
+	constexpr quantity_span(element_type (&arr)[N]) noexcept              : data_{arr}, size_{N} {}
+	template<typename Container, typename = detail::if_container_of_t<Container,Q>>
+	constexpr quantity_span(Container& cont) noexcept                     : data_{cont.data()}, size_{cont.size()} {}
+	template<typename OtherQ, typename = std::enable_if_t<std::is_convertible<OtherQ*,Q*>::value>>
+	constexpr quantity_span(const quantity_span<OtherQ>& other) noexcept  : data_{other.data()}, size_{other.size()} {}
+	/** @} */
+
+	/** @{ element access */
+	constexpr reference operator[](size_type idx) const                   {return data_[idx];}
+	constexpr reference front     ()              const                   {return data_[0];}
+	constexpr reference back      ()              const                   {return data_[size_-1];}
+	/** @} */
+
+	/**
+	 * @{
+	 *
+	 * @brief access to the viewed memory
+	 *
+	 * data() returns a pointer to the first quantity, values() one to the
+	 * first quantity's value.
+	 */
+	constexpr pointer       data  ()                                const {return data_;}
+	          value_pointer values()                                const {return reinterpret_cast<value_pointer>(data_);}
+	/** @} */
+
+	/** @{ iterators */
+	constexpr iterator begin()                                      const {return data_;}
+	constexpr iterator end  ()                                      const {return data_ + size_;}
+	/** @} */
+
+	/** @{ size */
+	constexpr size_type size ()                                     const {return size_;}
+	constexpr bool      empty()                                     const {return size_ == 0;}
+	/** @} */
+
+	/** @{ sub-views */
+	constexpr quantity_span first  (size_type count)                const {return {data_             , count};}
+	constexpr quantity_span last   (size_type count)                const {return {data_+size_-count , count};}
+	constexpr quantity_span subspan(size_type offset, size_type count) const
+	                                                                      {return {data_+offset      , count};}
+	/** @} */
+
+private:
+	pointer                                           data_;
+	size_type                                         size_;
+};
+
+/**
+ * @{
+ *
+ * @brief Create a span from a container or an array of quantities
+ *
+ * @param cont  container (or array) to create a span for
+ *
+ * @return span referring to the quantities in @p cont
+ */
+template<typename Container>
+constexpr auto make_quantity_span(Container& cont)                        {return quantity_span<std::remove_pointer_t<decltype(cont.data())>>{cont};}
+template<typename Q, std::size_t N>
+constexpr auto make_quantity_span(Q (&arr)[N])                            {return quantity_span<Q>{arr};}
+/** @} */
+
+/**
+ * @brief Create a span viewing a buffer of values as quantities
+ *
+ * This allows to attach a unit, scale, and tag to values coming from code
+ * that knows nothing about quantities without copying them. It relies on
+ * quantities having the layout of their values (@sa has_value_layout).
+ *
+ * @tparam Q  the quantity type (const-qualified for const values)
+ *
+ * @param values  pointer to the first value
+ * @param  count  number of values
+ *
+ * @code
+ * const double* readings = sensor.data(); // in kWh
+ * const auto energy = make_quantity_span<const kilo<watt_hour<double>>>(readings, sensor.size());
+ */
+template<typename Q>
+quantity_span<Q> make_quantity_span(typename quantity_span<Q>::value_pointer values, std::size_t count)
+                                                                          {return {reinterpret_cast<Q*>(values), count};}
+
+namespace detail {
+
+/* random access iterator over every stride-th quantity; it stores the
+ * first quantity and an index, so that iterators past the last quantity
+ * never form pointers beyond the viewed sequence */
+template<typename Q>
+class strided_quantity_iterator {
+public:
+	using iterator_category = std::random_access_iterator_tag;
+	using        value_type = std::remove_const_t<Q>;
+	using   difference_type = std::ptrdiff_t;
+	using           pointer = Q*;
+	using         reference = Q&;
+
+	constexpr strided_quantity_iterator() noexcept                        : base_{nullptr}, idx_{0}, stride_{1} {}
+	constexpr strided_quantity_iterator(pointer base, difference_type idx, difference_type stride) noexcept
+	                                                                      : base_{base}, idx_{idx}, stride_{stride} {}
+
+	constexpr reference operator* ()                                const {return base_[idx_*stride_];}
+	constexpr pointer   operator->()                                const {return base_ + idx_*stride_;}
+	constexpr reference operator[](difference_type n)               const {return base_[(idx_+n)*stride_];}
+
+	strided_quantity_iterator& operator++()                               {++idx_; return *this;}
+	strided_quantity_iterator& operator--()                               {--idx_; return *this;}
+	strided_quantity_iterator  operator++(int)                            {auto tmp = *this; ++*this; return tmp;}
+	strided_quantity_iterator  operator--(int)                            {auto tmp = *this; --*this; return tmp;}
+	strided_quantity_iterator& operator+=(difference_type n)              {idx_ += n; return *this;}
+	strided_quantity_iterator& operator-=(difference_type n)              {idx_ -= n; return *this;}
+
+	friend strided_quantity_iterator operator+(strided_quantity_iterator it, difference_type n)
+	                                                                      {return it += n;}
+	friend strided_quantity_iterator operator+(difference_type n, strided_quantity_iterator it)
+	                                                                      {return it += n;}
+	friend strided_quantity_iterator operator-(strided_quantity_iterator it, difference_type n)
+	                                                                      {return it -= n;}
+	friend difference_type           operator-(const strided_quantity_iterator& lhs, const strided_quantity_iterator& rhs)
+	                                                                      {return lhs.idx_ - rhs.idx_;}
+
+	friend bool operator==(const strided_quantity_iterator& lhs, const strided_quantity_iterator& rhs)
+	                                                                      {return lhs.idx_ == rhs.idx_;}
+	friend bool operator!=(const strided_quantity_iterator& lhs, const strided_quantity_iterator& rhs)
+	                                                                      {return lhs.idx_ != rhs.idx_;}
+	friend bool operator< (const strided_quantity_iterator& lhs, const strided_quantity_iterator& rhs)
+	                                                                      {return lhs.idx_ <  rhs.idx_;}
+	friend bool operator> (const strided_quantity_iterator& lhs, const strided_quantity_iterator& rhs)
+	                                                                      {return lhs.idx_ >  rhs.idx_;}
+	friend bool operator<=(const strided_quantity_iterator& lhs, const strided_quantity_iterator& rhs)
+	                                                                      {return lhs.idx_ <= rhs.idx_;}
+	friend bool operator>=(const strided_quantity_iterator& lhs, const strided_quantity_iterator& rhs)
+	                                                                      {return lhs.idx_ >= rhs.idx_;}
+
+private:
+	pointer                                           base_;
+	difference_type                                   idx_;
+	difference_type                                   stride_;
+};
+
+}
+
+/**
+ * @brief Non-owning view of every n-th quantity in a sequence
+ *
+ * This is like a quantity_span, except that consecutive elements are
+ * stride quantities apart. This allows to view one channel of interleaved
+ * data (e.g., the currents in a buffer of alternating voltages and currents)
+ * as a sequence of quantities.
+ *
+ * @tparam Q  the quantity type (which can be const-qualified)
+ */
+template<typename Q>
+class strided_quantity_span {
+public:
+	using  element_type = Q;                                              /**< the element type (possibly const)  */
+	using quantity_type = std::remove_const_t<Q>;                         /**< the viewed quantities' type        */
+	using     unit_type = typename quantity_type:: unit_type;             /**< the quantities' unit type          */
+	using    scale_type = typename quantity_type::scale_type;             /**< the quantities' scale              */
+	using    value_type = typename quantity_type::value_type;             /**< the quantities' value type         */
+	using      tag_type = typename quantity_type::  tag_type;             /**< the quantities' tag                */
+
+	using       pointer = element_type*;
+	using     reference = element_type&;
+	using      iterator = detail::strided_quantity_iterator<element_type>;
+	using     size_type = std::size_t;
+
+	static_assert(is_quantity<quantity_type>::value, "strided_quantity_span must refer to quantities");
+	static_assert(has_value_layout<quantity_type>::value, "quantities must have the layout of their value type");
+
+	/** pointer to the quantities' values; const if the quantities are const */
+	using value_pointer = std::conditional_t<std::is_const<Q>::value, const value_type*, value_type*>;
+
+	constexpr strided_quantity_span() noexcept                            : data_{nullptr}, size_{0}, stride_{1} {}
+
+	/**
+	 * @{
+	 *
+	 * @brief Constructors
+	 *
+	 * @param    ptr  pointer to the first quantity
+	 * @param  count  number of quantities viewed
+	 * @param stride  distance between consecutive quantities viewed (in
+	 *                quantities; must not be zero)
+	 * @param  other  span to convert from
+	 */
+	constexpr strided_quantity_span(pointer ptr, size_type count, size_type stride = 1) noexcept
+	                                                                      : data_{ptr}, size_{count}, stride_{stride} {}
+	template<typename OtherQ, typename = std::enable_if_t<std::is_convertible<OtherQ*,Q*>::value>>
+	constexpr strided_quantity_span(const quantity_span<OtherQ>& other) noexcept
+	                                                                      : data_{other.data()}, size_{other.size()}, stride_{1} {}
+	template<typename OtherQ, typename = std::enable_if_t<std::is_convertible<OtherQ*,Q*>::value>>
+	constexpr strided_quantity_span(const strided_quantity_span<OtherQ>& other) noexcept
+	                                                                      : data_{other.data()}, size_{other.size()}, stride_{other.stride()} {}
+	/** @} */
+
+	/** @{ element access */
+	constexpr reference operator[](size_type idx) const                   {return data_[idx*stride_];}
+	constexpr reference front     ()              const                   {return data_[0];}
+	constexpr reference back      ()              const                   {return data_[(size_-1)*stride_];}
+	/** @} */
+
+	/** pointer to the first quantity */
+	constexpr pointer   data  ()                                    const {return data_;}
+	/** distance between consecutive quantities (in quantities) */
+	constexpr size_type stride()                                    const {return stride_;}
+
+	/** @{ iterators */
+	constexpr iterator begin()                                      const {return {data_, 0                                , static_cast<std::ptrdiff_t>(stride_)};}
+	constexpr iterator end  ()                                      const {return {data_, static_cast<std::ptrdiff_t>(size_), static_cast<std::ptrdiff_t>(stride_)};}
+	/** @} */
+
+	/** @{ size */
+	constexpr size_type size ()                                     const {return size_;}
+	constexpr bool      empty()                                     const {return size_ == 0;}
+	/** @} */
+
+	/**
+	 * @{
+	 *
+	 * @brief Sub-views
+	 *
+	 * Empty sub-views refer to the first quantity, so that no pointers
+	 * beyond the viewed sequence are formed.
+	 */
+	constexpr strided_quantity_span first  (size_type count)        const {return {data_                                           , count, stride_};}
+	constexpr strided_quantity_span last   (size_type count)        const {return {count == 0 ? data_ : data_+(size_-count)*stride_, count, stride_};}
+	constexpr strided_quantity_span subspan(size_type offset, size_type count) const
+	                                                                      {return {count == 0 ? data_ : data_+offset*stride_        , count, stride_};}
+	/** @} */
+
+private:
+	pointer                                           data_;
+	size_type                                         size_;
+	size_type                                         stride_;
+};
+
+/**
+ * @brief Create a strided span viewing every n-th value in a buffer as quantities
+ *
+ * @tparam Q  the quantity type (const-qualified for const values)
+ *
+ * @param values  pointer to the first value
+ * @param  count  number of quantities viewed
+ * @param stride  distance between consecutive values viewed (in values)
+ *
+ * @code
+ * // buffer holds alternating voltages and currents
+ * const auto currents = make_strided_quantity_span<const ampere<float>>(buffer+1, buffer_size/2, 2);
+ */
+template<typename Q>
+strided_quantity_span<Q> make_strided_quantity_span(typename strided_quantity_span<Q>::value_pointer values, std::size_t count, std::size_t stride)
+                                                                          {return {reinterpret_cast<Q*>(values), count, stride};}
+
+namespace detail {
+
+/* iterator over the results of a quantity_cast_view; it stores a copy of
+ * the (cheap) underlying view, so it stays valid after the cast view it was
+ * taken from is gone */
+template<typename View, typename Caster>
+class quantity_cast_view_iterator {
+public:
+	using iterator_category = std::input_iterator_tag;
+	using        value_type = decltype(std::declval<Caster>()(std::declval<const typename View::quantity_type&>()));
+	using   difference_type = std::ptrdiff_t;
+	using           pointer = void;
+	using         reference = value_type;
+
+	constexpr quantity_cast_view_iterator()                               : view_{}, caster_{}, idx_{0} {}
+	constexpr quantity_cast_view_iterator(const View& view, const Caster& caster, std::size_t idx)
+	                                                                      : view_{view}, caster_{caster}, idx_{idx} {}
+
+	constexpr value_type operator*()                                const {return caster_(view_[idx_]);}
+
+	quantity_cast_view_iterator& operator++()                             {++idx_; return *this;}
+	quantity_cast_view_iterator  operator++(int)                          {auto tmp = *this; ++idx_; return tmp;}
+
+	friend bool operator==(const quantity_cast_view_iterator& lhs, const quantity_cast_view_iterator& rhs)
+	                                                                      {return lhs.idx_ == rhs.idx_;}
+	friend bool operator!=(const quantity_cast_view_iterator& lhs, const quantity_cast_view_iterator& rhs)
+	                                                                      {return lhs.idx_ != rhs.idx_;}
+
+private:
+	View                                              view_;
+	Caster                                            caster_;
+	std::size_t                                       idx_;
+};
+
+template<typename NewValueType>
+struct value_caster {
+	template<typename Q>
+	constexpr auto operator()(const Q& q)                           const {return value_cast<NewValueType>(q);}
+};
+template<typename NewScale>
+struct scale_caster {
+	template<typename Q>
+	constexpr auto operator()(const Q& q)                           const {return scale_cast<NewScale>(q);}
+};
+template<typename NewTag>
+struct tag_caster {
+	template<typename Q>
+	constexpr auto operator()(const Q& q)                           const {return tag_cast<NewTag>(q);}
+};
+
+}
+
+/**
+ * @brief Lazy view of casted quantities
+ *
+ * This is returned by value_cast(), scale_cast(), and tag_cast() when they
+ * are invoked for views of quantities. It does not store any converted
+ * quantities, but converts them when they are accessed, so no intermediate
+ * buffer is needed. Since elements are returned by value, they cannot be
+ * modified through a cast view.
+ *
+ * @tparam   View  the underlying view of quantities
+ * @tparam Caster  function object converting the underlying quantities
+ */
+template<typename View, typename Caster>
+class quantity_cast_view {
+public:
+	using      view_type = View;
+	using  quantity_type = decltype(std::declval<Caster>()(std::declval<const typename View::quantity_type&>()));
+	using      unit_type = typename quantity_type:: unit_type;
+	using     scale_type = typename quantity_type::scale_type;
+	using     value_type = typename quantity_type::value_type;
+	using       tag_type = typename quantity_type::  tag_type;
+
+	using       iterator = detail::quantity_cast_view_iterator<View,Caster>;
+	using      size_type = std::size_t;
+
+	constexpr explicit quantity_cast_view(const view_type& view)          : view_{view} {}
+
+	constexpr quantity_type operator[](size_type idx)               const {return Caster{}(view_[idx]);}
+	constexpr quantity_type front     ()                            const {return Caster{}(view_.front());}
+	constexpr quantity_type back      ()                            const {return Caster{}(view_.back ());}
+
+	/** the underlying view */
+	constexpr const view_type& base()                               const {return view_;}
+
+	/** @{ iterators */
+	constexpr iterator begin()                                      const {return {view_, Caster{}, 0           };}
+	constexpr iterator end  ()                                      const {return {view_, Caster{}, view_.size()};}
+	/** @} */
+
+	/** @{ size */
+	constexpr size_type size ()                                     const {return view_.size();}
+	constexpr bool      empty()                                     const {return view_.empty();}
+	/** @} */
+
+private:
+	view_type                                         view_;
+};
+
+/**
+ * @{
+ *
+ * @brief Lazily cast views of quantities
+ *
+ * These return views of the quantities referred to by @p view, converted
+ * by value_cast<NewValueType>(), scale_cast<NewScale>(), or
+ * tag_cast<NewTag>() when they are accessed.
+ *
+ * @param view  quantity_span, strided_quantity_span, or quantity_cast_view
+ *
+ * @code
+ * const auto energy = make_quantity_span<const watt_hour<double>>(readings, count);
+ * for(const auto e : value_cast<float>(scale_cast<kilo<watt_hour<double>>::scale_type>(energy)))
+ *     process(e); // e is a kilo<watt_hour<float>>
+ */
+template<typename NewValueType, typename View, typename = std::enable_if_t<is_quantity_view<View>::value>>
+constexpr auto value_cast(const View& view)                               {return quantity_cast_view<View,detail::value_caster<NewValueType>>{view};}
+template<typename NewScale, typename View, typename = std::enable_if_t<is_quantity_view<View>::value>>
+constexpr auto scale_cast(const View& view)                               {return quantity_cast_view<View,detail::scale_caster<NewScale>>{view};}
+template<typename NewTag, typename View, typename = std::enable_if_t<is_quantity_view<View>::value>>
+constexpr auto tag_cast(const View& view)                                 {return quantity_cast_view<View,detail::tag_caster<NewTag>>{view};}
+/** @} */
+
+/**
+ * @{
+ *
+ * @brief Rescale a sequence of quantities
+ *
+ * This rescales all quantities in @p in to the scale of the quantities in
+ * @p out. The results are identical to those the quantity conversion
+ * constructor produces for each value, but the conversion is done in one
+ * loop over contiguous memory, which the compiler can vectorize.
+ *
+ * @param  in  quantities to rescale
+ * @param out  quantities to write the results to
+ *
+ * @note Both spans must have the same size. They must either not overlap, or
+ *       refer to exactly the same memory.
+ */
+template<typename U1, typename S1, typename V1, typename T1, typename U2, typename S2, typename V2, typename T2>
+void rescale_span(quantity_span<const quantity<U1,S1,V1,T1>> in, quantity_span<quantity<U2,S2,V2,T2>> out) {
+	static_assert(are_units_compatible_v<U1, U2>, "fundamentally incompatible units"      );
+	static_assert(detail::is_same_v     <V1, V2>, "different value types (use value_cast)");
+	static_assert(detail::is_same_v     <T1, T2>, "different unit tags (use tag_cast)"    );
+	assert(in.size() == out.size());
+	detail::rescale_values<S2,S1>(in.values(), in.size(), out.values());
+}
+template<typename U1, typename S1, typename V1, typename T1, typename U2, typename S2, typename V2, typename T2>
+void rescale_span(quantity_span<      quantity<U1,S1,V1,T1>> in, quantity_span<quantity<U2,S2,V2,T2>> out)
+                                                                          {rescale_span(quantity_span<const quantity<U1,S1,V1,T1>>{in}, out);}
+/** @} */
+
+}
+
+#endif //UNLIB_QUANTITY_SPAN_HPP
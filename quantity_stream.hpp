@@ -0,0 +1,73 @@
+#ifndef UNLIB_QUANTITY_STREAM_HPP
+#define UNLIB_QUANTITY_STREAM_HPP
+
+/*
+ * quantity_stream.hpp
+ *
+ * Copyright sbi http://stackoverflow.com/users/140719
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *     http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <istream>
+#include <ostream>
+
+#include <unlib/quantity.hpp>
+#include <unlib/quantity_io.hpp>
+
+namespace unlib {
+
+namespace detail {
+
+template<typename U, typename S, typename V, typename T>
+std::ostream& stream(std::ostream& os, const quantity<U,S,V,T>& q, std::false_type)
+                                                                          {return os << q.get();}
+template<typename U, typename S, typename V, typename T>
+std::ostream& stream(std::ostream& os, const quantity<U,S,V,T>& q, std::true_type)
+	                                                                      {
+	                                                                          return stream(os, q, std::false_type{})
+	                                                                       << ' '
+	                                                                       << literals::get_quantity_string(q);
+	                                                                      }
+
+}
+
+/**
+ * @brief Stream output operator
+ *
+ * Streams the stored value into os.
+ *
+ * @param os  the stream
+ * @param  q  the quantity
+ * @return os
+ */
+template<typename U, typename S, typename V, typename T>
+std::ostream& operator<<(std::ostream& os, const quantity<U,S,V,T>& q)    {
+	                                                                          return detail::stream( os
+	                                                                                               , q
+	                                                                                               , literals::is_quantity_string_specialized<U,S,T>{} );
+	                                                                      }
+
+/**
+ * @brief Stream input operator
+ *
+ * Reads from the stream into q.
+ *
+ * @param is  the stream
+ * @param  q  the quantity
+ *
+ * @return is
+ */
+template<typename U, typename S, typename V, typename T>
+std::istream& operator>>(std::istream& is, quantity<U,S,V,T>& q)          {
+	                                                                          V v;
+	                                                                          if (is >> v)
+		                                                                          q = quantity<U,S,V,T>{v};
+	                                                                          return is;
+                                                                          }
+
+}
+
+#endif /* UNLIB_QUANTITY_STREAM_HPP */
@@ -0,0 +1,395 @@
+#ifndef UNLIB_QUANTITY_VECTOR_HPP
+#define UNLIB_QUANTITY_VECTOR_HPP
+
+/*
+ * quantity_vector.hpp
+ *
+ * Copyright sbi http://stackoverflow.com/users/140719
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *     http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <unlib/quantity.hpp>
+
+namespace unlib {
+
+template< typename Unit
+        , typename Scale     = no_scaling
+        , typename ValueType = double
+        , typename Tag       = no_tag >
+class quantity_vector;
+
+template<typename T>                                     struct is_quantity_vector                           : std::false_type {};
+template<typename U, typename S, typename V, typename T> struct is_quantity_vector<quantity_vector<U,S,V,T>> : std::true_type {};
+
+namespace detail {
+
+/* alignment of quantity_vector storage; wide enough for AVX-512 registers */
+constexpr std::size_t quantity_vector_alignment = 64;
+
+/*
+ * An allocator handing out memory aligned to Alignment bytes. (C++14 has no
+ * aligned operator new, so this over-allocates and stores the pointer
+ * obtained from operator new right in front of the aligned block.)
+ */
+template<typename T, std::size_t Alignment>
+struct aligned_allocator {
+	static_assert((Alignment & (Alignment-1)) == 0      , "alignment must be a power of two");
+	static_assert(Alignment >= alignof(void*)           , "alignment too small"             );
+
+	using value_type = T;
+	template<typename U> struct rebind {using other = aligned_allocator<U,Alignment>;};
+
+	constexpr aligned_allocator() noexcept                              = default;
+	template<typename U>
+	constexpr aligned_allocator(const aligned_allocator<U,Alignment>&) noexcept {}
+
+	T* allocate(std::size_t n) {
+		if( n > (std::numeric_limits<std::size_t>::max() - Alignment - sizeof(void*)) / sizeof(T) )
+			throw std::bad_array_new_length{};
+		void* const raw = ::operator new(n*sizeof(T) + Alignment + sizeof(void*));
+		const auto  adr = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+		void* const blk = reinterpret_cast<void*>((adr + Alignment - 1) & ~(std::uintptr_t{Alignment} - 1));
+		static_cast<void**>(blk)[-1] = raw;
+		return static_cast<T*>(blk);
+	}
+	void deallocate(T* p, std::size_t) noexcept                           {::operator delete(static_cast<void**>(static_cast<void*>(p))[-1]);}
+
+	template<typename U>
+	friend constexpr bool operator==(const aligned_allocator&, const aligned_allocator<U,Alignment>&) noexcept {return true;}
+	template<typename U>
+	friend constexpr bool operator!=(const aligned_allocator&, const aligned_allocator<U,Alignment>&) noexcept {return false;}
+};
+
+template<typename Q> struct quantity_vector_of;
+template<typename U, typename S, typename V, typename T>
+struct quantity_vector_of<quantity<U,S,V,T>>                              {using type = quantity_vector<U,S,V,T>;};
+template<typename Q>
+using quantity_vector_of_t = typename quantity_vector_of<Q>::type;
+
+/* access an operand of an elementwise operation; non-vectors are broadcast */
+template<typename U, typename S, typename V, typename T>
+constexpr const quantity<U,S,V,T>& element_at(const quantity_vector<U,S,V,T>& qv, std::size_t idx)
+                                                                          {return qv[idx];}
+template<typename X>
+constexpr const X& element_at(const X& x, std::size_t)                    {return x;}
+
+template<typename U, typename S, typename V, typename T>
+constexpr std::size_t element_count(const quantity_vector<U,S,V,T>& qv)   {return qv.size();}
+template<typename X>
+constexpr std::size_t element_count(const X&)                             {return 0;}
+
+template<typename Lhs, typename Rhs, typename BinaryOp>
+auto apply_elementwise(const Lhs& lhs, const Rhs& rhs, BinaryOp op) {
+	using result_quantity_t = std::decay_t<decltype(op(element_at(lhs,0), element_at(rhs,0)))>;
+	using   result_vector_t = quantity_vector_of_t<result_quantity_t>;
+
+	assert( not is_quantity_vector<Lhs>::value
+	     or not is_quantity_vector<Rhs>::value
+	     or element_count(lhs) == element_count(rhs) );
+
+	const std::size_t size = is_quantity_vector<Lhs>::value ? element_count(lhs) : element_count(rhs);
+	result_vector_t result(size);
+	result_quantity_t* const out = result.data();
+	for(std::size_t idx=0; idx<size; ++idx)
+		out[idx] = op(element_at(lhs,idx), element_at(rhs,idx));
+	return result;
+}
+
+}
+
+/**
+ * @brief Contiguous container of quantities
+ *
+ * This stores a sequence of quantities of the same unit, scale, value type,
+ * and tag, which are thus only given once, as part of the container's type.
+ * Since a quantity is nothing but a value type object, the quantities are
+ * stored as one contiguous, SIMD-aligned, block of values, that can be
+ * handed to functions expecting value type arrays by using values().
+ *
+ * Elementwise arithmetic operators are provided for whole containers. They
+ * perform the same dimension checking and rescaling the corresponding
+ * operators for single quantities perform, but do so in simple loops over
+ * contiguous memory the compiler can vectorize.
+ *
+ * @tparam       Unit   the quantities' unit type
+ * @tparam      Scale   the quantities' scale
+ * @tparam  ValueType   the quantities' value type
+ * @tparam        Tag   the quantities' tag
+ *
+ * @note Elementwise operations on two containers require both to be of the
+ *       same size. This is a precondition that is checked by assert() only.
+ */
+template< typename Unit
+        , typename Scale
+        , typename ValueType
+        , typename Tag >
+class quantity_vector {
+public:
+	using quantity_type = quantity<Unit,Scale,ValueType,Tag>;             /**< the stored quantities' type */
+	using     unit_type = typename quantity_type:: unit_type;             /**< the quantities' unit type   */
+	using    scale_type = typename quantity_type::scale_type;             /**< the quantities' scale       */
+	using    value_type = typename quantity_type::value_type;             /**< the quantities' value type  */
+	using      tag_type = typename quantity_type::  tag_type;             /**< the quantities' tag         */
+
+private:
+	static_assert(has_value_layout<quantity_type>::value, "quantities must have the layout of their value type");
+
+	using allocator_type = detail::aligned_allocator<quantity_type,detail::quantity_vector_alignment>;
+	using   storage_type = std::vector<quantity_type,allocator_type>;
+
+public:
+	using              size_type = typename storage_type::size_type;
+	using              reference = typename storage_type::reference;
+	using        const_reference = typename storage_type::const_reference;
+	using               iterator = typename storage_type::iterator;
+	using         const_iterator = typename storage_type::const_iterator;
+
+	/** alignment (in bytes) of the container's first element */
+	static constexpr std::size_t alignment = detail::quantity_vector_alignment;
+
+	/** @{ create a quantity_vector type with a different tag, value type, or scale */
+	template<typename NewTag>       using      retag = quantity_vector< unit_type, scale_type, value_type  , NewTag   >;
+	template<typename NewValueType> using    revalue = quantity_vector< unit_type, scale_type, NewValueType, tag_type >;
+	template<typename NewScale>     using rescale_to = quantity_vector< unit_type, NewScale  , value_type  , tag_type >;
+	/** @} */
+
+	quantity_vector()                                                     = default;
+
+	/**
+	 * @{
+	 *
+	 * @brief Constructors
+	 *
+	 * @param count  number of quantities to create
+	 * @param     q  value to initialize quantities with
+	 * @param  init  quantities to initialize the container with
+	 * @param first  begin of a range of quantities to copy
+	 * @param  last  end   of a range of quantities to copy
+	 */
+	explicit quantity_vector(size_type count)                             : quantities_(count) {}
+	quantity_vector(size_type count, const quantity_type& q)              : quantities_(count, q) {}
+	quantity_vector(std::initializer_list<quantity_type> init)            : quantities_(init) {}
+	template<typename InputIt>
+	quantity_vector(InputIt first, InputIt last)                          : quantities_(first, last) {}
+	/** @} */
+
+	/**
+	 * @brief Conversion constructor
+	 *
+	 * Just like for quantities, the only conversion allowed implicitly is
+	 * re-scaling.
+	 *
+	 * @param rhs  quantities to convert from
+	 */
+	template<typename U, typename S, typename V, typename T>
+	quantity_vector(const quantity_vector<U,S,V,T>& rhs)                  : quantities_(rhs.size()) {
+		static_assert(are_units_compatible_v<unit_type , U>, "fundamentally incompatible units"      );
+		static_assert(detail::is_same_v     <value_type, V>, "different value types (use value_cast)");
+		static_assert(detail::is_same_v     <tag_type  , T>, "different unit tags (use tag_cast)"    );
+		detail::rescale_values<scale_type,S>(rhs.values(), rhs.size(), values());
+	}
+
+	/**
+	 * @{
+	 *
+	 * @brief element access
+	 *
+	 * @note at() throws std::out_of_range if @p idx is out of range.
+	 */
+	reference       operator[](size_type idx)                             {return quantities_[idx];}
+	const_reference operator[](size_type idx) const                       {return quantities_[idx];}
+	reference       at        (size_type idx)                             {return quantities_.at(idx);}
+	const_reference at        (size_type idx) const                       {return quantities_.at(idx);}
+	reference       front     ()                                          {return quantities_.front();}
+	const_reference front     ()                                    const {return quantities_.front();}
+	reference       back      ()                                          {return quantities_.back();}
+	const_reference back      ()                                    const {return quantities_.back();}
+	/** @} */
+
+	/**
+	 * @{
+	 *
+	 * @brief access to the underlying storage
+	 *
+	 * data() returns a pointer to the first quantity, values() one to the
+	 * first quantity's value. The latter can be passed to code working on
+	 * arrays of the value type.
+	 */
+	quantity_type*       data  ()                                         {return quantities_.data();}
+	const quantity_type* data  ()                                   const {return quantities_.data();}
+	value_type*          values()                                         {return reinterpret_cast<value_type*>(data());}
+	const value_type*    values()                                   const {return reinterpret_cast<const value_type*>(data());}
+	/** @} */
+
+	/** @{ iterators */
+	iterator       begin ()                                               {return quantities_.begin ();}
+	const_iterator begin ()                                         const {return quantities_.begin ();}
+	const_iterator cbegin()                                         const {return quantities_.cbegin();}
+	iterator       end   ()                                               {return quantities_.end   ();}
+	const_iterator end   ()                                         const {return quantities_.end   ();}
+	const_iterator cend  ()                                         const {return quantities_.cend  ();}
+	/** @} */
+
+	/** @{ capacity */
+	bool      empty   ()                                            const {return quantities_.empty();}
+	size_type size    ()                                            const {return quantities_.size();}
+	size_type capacity()                                            const {return quantities_.capacity();}
+	void      reserve (size_type new_cap)                                 {quantities_.reserve(new_cap);}
+	/** @} */
+
+	/** @{ modifiers */
+	void clear    ()                                                      {quantities_.clear();}
+	void push_back(const quantity_type& q)                                {quantities_.push_back(q);}
+	void pop_back ()                                                      {quantities_.pop_back();}
+	void resize   (size_type count)                                       {quantities_.resize(count);}
+	void resize   (size_type count, const quantity_type& q)               {quantities_.resize(count, q);}
+	void swap     (quantity_vector& other) noexcept                       {quantities_.swap(other.quantities_);}
+	/** @} */
+
+	/**
+	 * @{
+	 * @brief Compound mathematical operators
+	 *
+	 * These apply the corresponding quantity operator to all elements. Where
+	 * a single quantity or value is passed, it is applied to all elements.
+	 *
+	 * @param rhs  quantities, quantity, or value to combine with
+	 *
+	 * @return self
+	 */
+	template<typename U, typename S, typename V, typename T>
+	quantity_vector& operator+=(const quantity_vector<U,S,V,T>& rhs)      {
+		                                                                      assert(size() == rhs.size());
+		                                                                      quantity_type*                   out = data();
+		                                                                      const quantity<U,S,V,T>* const   in  = rhs.data();
+		                                                                      for(size_type idx=0; idx<size(); ++idx)
+			                                                                      out[idx] += in[idx];
+		                                                                      return *this;
+	                                                                      }
+	template<typename U, typename S, typename V, typename T>
+	quantity_vector& operator-=(const quantity_vector<U,S,V,T>& rhs)      {
+		                                                                      assert(size() == rhs.size());
+		                                                                      quantity_type*                   out = data();
+		                                                                      const quantity<U,S,V,T>* const   in  = rhs.data();
+		                                                                      for(size_type idx=0; idx<size(); ++idx)
+			                                                                      out[idx] -= in[idx];
+		                                                                      return *this;
+	                                                                      }
+	template<typename U, typename S, typename V, typename T>
+	quantity_vector& operator+=(const quantity<U,S,V,T>& rhs)             {
+		                                                                      const quantity_type q{rhs};
+		                                                                      quantity_type* const out = data();
+		                                                                      for(size_type idx=0; idx<size(); ++idx)
+			                                                                      out[idx] += q;
+		                                                                      return *this;
+	                                                                      }
+	template<typename U, typename S, typename V, typename T>
+	quantity_vector& operator-=(const quantity<U,S,V,T>& rhs)             {
+		                                                                      const quantity_type q{rhs};
+		                                                                      quantity_type* const out = data();
+		                                                                      for(size_type idx=0; idx<size(); ++idx)
+			                                                                      out[idx] -= q;
+		                                                                      return *this;
+	                                                                      }
+	template<typename V>
+	quantity_vector& operator*=(const V& rhs)                             {
+		                                                                      quantity_type* const out = data();
+		                                                                      for(size_type idx=0; idx<size(); ++idx)
+			                                                                      out[idx] *= rhs;
+		                                                                      return *this;
+	                                                                      }
+	template<typename V>
+	quantity_vector& operator/=(const V& rhs)                             {
+		                                                                      quantity_type* const out = data();
+		                                                                      for(size_type idx=0; idx<size(); ++idx)
+			                                                                      out[idx] /= rhs;
+		                                                                      return *this;
+	                                                                      }
+	/** @} */
+
+private:
+	storage_type                                      quantities_;
+};
+
+template<typename U, typename S, typename V, typename T>
+void swap(quantity_vector<U,S,V,T>& lhs, quantity_vector<U,S,V,T>& rhs) noexcept
+                                                                          {lhs.swap(rhs);}
+
+/**
+ * @{
+ * @brief Elementwise binary arithmetic operators
+ *
+ * These combine two containers elementwise, or each element of a container
+ * with a single quantity or value, using the corresponding operators for
+ * quantities. The result is a container of the quantity type the single
+ * quantity operator would produce.
+ *
+ * @param lhs  quantities, quantity, or dimensionless value
+ * @param rhs  quantities, quantity, or dimensionless value
+ * @return container with the combined results
+ */
+template<typename U1, typename S1, typename V1, typename T1, typename U2, typename S2, typename V2, typename T2>
+auto operator+(const quantity_vector<U1,S1,V1,T1>& lhs, const quantity_vector<U2,S2,V2,T2>& rhs)
+                                                                          {return detail::apply_elementwise(lhs, rhs, [](const auto& l, const auto& r){return l + r;});}
+template<typename U1, typename S1, typename V1, typename T1, typename U2, typename S2, typename V2, typename T2>
+auto operator+(const quantity_vector<U1,S1,V1,T1>& lhs, const quantity       <U2,S2,V2,T2>& rhs)
+                                                                          {return detail::apply_elementwise(lhs, rhs, [](const auto& l, const auto& r){return l + r;});}
+template<typename U1, typename S1, typename V1, typename T1, typename U2, typename S2, typename V2, typename T2>
+auto operator+(const quantity       <U1,S1,V1,T1>& lhs, const quantity_vector<U2,S2,V2,T2>& rhs)
+                                                                          {return detail::apply_elementwise(lhs, rhs, [](const auto& l, const auto& r){return l + r;});}
+
+template<typename U1, typename S1, typename V1, typename T1, typename U2, typename S2, typename V2, typename T2>
+auto operator-(const quantity_vector<U1,S1,V1,T1>& lhs, const quantity_vector<U2,S2,V2,T2>& rhs)
+                                                                          {return detail::apply_elementwise(lhs, rhs, [](const auto& l, const auto& r){return l - r;});}
+template<typename U1, typename S1, typename V1, typename T1, typename U2, typename S2, typename V2, typename T2>
+auto operator-(const quantity_vector<U1,S1,V1,T1>& lhs, const quantity       <U2,S2,V2,T2>& rhs)
+                                                                          {return detail::apply_elementwise(lhs, rhs, [](const auto& l, const auto& r){return l - r;});}
+template<typename U1, typename S1, typename V1, typename T1, typename U2, typename S2, typename V2, typename T2>
+auto operator-(const quantity       <U1,S1,V1,T1>& lhs, const quantity_vector<U2,S2,V2,T2>& rhs)
+                                                                          {return detail::apply_elementwise(lhs, rhs, [](const auto& l, const auto& r){return l - r;});}
+
+template<typename U1, typename S1, typename V1, typename T1, typename U2, typename S2, typename V2, typename T2>
+auto operator*(const quantity_vector<U1,S1,V1,T1>& lhs, const quantity_vector<U2,S2,V2,T2>& rhs)
+                                                                          {return detail::apply_elementwise(lhs, rhs, [](const auto& l, const auto& r){return l * r;});}
+template<typename U1, typename S1, typename V1, typename T1, typename U2, typename S2, typename V2, typename T2>
+auto operator*(const quantity_vector<U1,S1,V1,T1>& lhs, const quantity       <U2,S2,V2,T2>& rhs)
+                                                                          {return detail::apply_elementwise(lhs, rhs, [](const auto& l, const auto& r){return l * r;});}
+template<typename U1, typename S1, typename V1, typename T1, typename U2, typename S2, typename V2, typename T2>
+auto operator*(const quantity       <U1,S1,V1,T1>& lhs, const quantity_vector<U2,S2,V2,T2>& rhs)
+                                                                          {return detail::apply_elementwise(lhs, rhs, [](const auto& l, const auto& r){return l * r;});}
+template<typename U1, typename S1, typename V1, typename T1, typename V2>
+auto operator*(const quantity_vector<U1,S1,V1,T1>& lhs, const V2& rhs)    {return detail::apply_elementwise(lhs, rhs, [](const auto& l, const auto& r){return l * r;});}
+template<typename V1, typename U2, typename S2, typename V2, typename T2>
+auto operator*(const V1& lhs, const quantity_vector<U2,S2,V2,T2>& rhs)    {return detail::apply_elementwise(lhs, rhs, [](const auto& l, const auto& r){return l * r;});}
+
+template<typename U1, typename S1, typename V1, typename T1, typename U2, typename S2, typename V2, typename T2>
+auto operator/(const quantity_vector<U1,S1,V1,T1>& lhs, const quantity_vector<U2,S2,V2,T2>& rhs)
+                                                                          {return detail::apply_elementwise(lhs, rhs, [](const auto& l, const auto& r){return l / r;});}
+template<typename U1, typename S1, typename V1, typename T1, typename U2, typename S2, typename V2, typename T2>
+auto operator/(const quantity_vector<U1,S1,V1,T1>& lhs, const quantity       <U2,S2,V2,T2>& rhs)
+                                                                          {return detail::apply_elementwise(lhs, rhs, [](const auto& l, const auto& r){return l / r;});}
+template<typename U1, typename S1, typename V1, typename T1, typename U2, typename S2, typename V2, typename T2>
+auto operator/(const quantity       <U1,S1,V1,T1>& lhs, const quantity_vector<U2,S2,V2,T2>& rhs)
+                                                                          {return detail::apply_elementwise(lhs, rhs, [](const auto& l, const auto& r){return l / r;});}
+template<typename U1, typename S1, typename V1, typename T1, typename V2>
+auto operator/(const quantity_vector<U1,S1,V1,T1>& lhs, const V2& rhs)    {return detail::apply_elementwise(lhs, rhs, [](const auto& l, const auto& r){return l / r;});}
+template<typename V1, typename U2, typename S2, typename V2, typename T2>
+auto operator/(const V1& lhs, const quantity_vector<U2,S2,V2,T2>& rhs)    {return detail::apply_elementwise(lhs, rhs, [](const auto& l, const auto& r){return l / r;});}
+/** @} */
+
+}
+
+#endif //UNLIB_QUANTITY_VECTOR_HPP
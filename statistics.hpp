@@ -0,0 +1,184 @@
+#ifndef UNLIB_STATISTICS_HPP
+#define UNLIB_STATISTICS_HPP
+
+/*
+ * statistics.hpp
+ *
+ * Copyright sbi http://stackoverflow.com/users/140719
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *     http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+
+#include <unlib/quantity.hpp>
+#include <unlib/quantity_span.hpp>
+#include <unlib/numeric.hpp>
+
+namespace unlib {
+
+namespace detail {
+
+/* Sums the squared deviations of n values from mean pairwise (@sa
+ * pairwise_sum()). Together with the mean computed beforehand, this is the
+ * two-pass algorithm, which is more accurate than Welford's updates, and
+ * vectorizes. */
+template<typename V>
+V sum_squared_deviations_block(const V* in, std::size_t n, V mean) {
+	V lanes[sum_lanes] = {};
+	std::size_t idx = 0;
+	for(; idx+sum_lanes<=n; idx+=sum_lanes)
+		for(std::size_t lane=0; lane<sum_lanes; ++lane)
+			lanes[lane] += (in[idx+lane] - mean) * (in[idx+lane] - mean);
+	V result = sum_lanes_total(lanes);
+	for(; idx<n; ++idx)
+		result += (in[idx] - mean) * (in[idx] - mean);
+	return result;
+}
+
+template<typename V>
+V sum_squared_deviations(const V* in, std::size_t n, V mean) {
+	return pairwise_sum_blocks<V>(0, n, [in,mean](std::size_t first, std::size_t count){return sum_squared_deviations_block(in+first, count, mean);});
+}
+
+}
+
+/**
+ * @brief Accumulator for the mean, variance, minimum, and maximum of quantities
+ *
+ * This keeps track of the number of quantities pushed, their mean, the sum
+ * of their squared deviations from the mean, and their minimum and maximum,
+ * from which it derives the statistics. The mean, minimum, and maximum are
+ * of the pushed quantities' type, the variance is of the type of their
+ * squares (e.g., square volts for volts), the standard deviation again of
+ * the pushed quantities' type.
+ *
+ * Single quantities are pushed using Welford's algorithm. Sequences of
+ * quantities are pushed by computing their statistics in vectorized loops,
+ * and then merging these, which is faster and more accurate. Statistics
+ * computed separately (e.g., by different threads) can be combined using
+ * merge(), which yields the same statistics (up to rounding) as pushing all
+ * quantities into one accumulator.
+ *
+ * @tparam Q  the quantity type (value type must be floating point)
+ *
+ * @code
+ * running_stats<volt<double>> stats;
+ * for(const auto& chunk : voltage_chunks)
+ *     stats.push(make_quantity_span(chunk));
+ * report(stats.mean(), stats.standard_deviation(), stats.min(), stats.max());
+ */
+template<typename Q>
+class running_stats {
+public:
+	using quantity_type = Q;                                              /**< the quantity type                  */
+	using variance_type = pow_quantity_t<Q,std::ratio<2>>;                /**< the quantities' squares' type      */
+	using    value_type = typename quantity_type::value_type;             /**< the quantities' value type         */
+
+	static_assert(is_quantity<quantity_type>::value, "running_stats must accumulate quantities");
+	static_assert(std::is_floating_point<value_type>::value, "statistics need floating point values");
+
+	constexpr running_stats()                                             : count_{0}, mean_{}, m2_{}
+	                                                                      , min_{ std::numeric_limits<value_type>::infinity()}
+	                                                                      , max_{-std::numeric_limits<value_type>::infinity()} {}
+
+	/**
+	 * @{
+	 *
+	 * @brief Add quantities to the statistics
+	 *
+	 * @param q   quantity to add
+	 * @param in  quantities to add
+	 */
+	void push(const quantity_type& q) {
+		const value_type v = q.get();
+		++count_;
+		const value_type delta = v - mean_;
+		mean_ += delta / static_cast<value_type>(count_);
+		m2_   += delta * (v - mean_);
+		min_   = v < min_ ? v : min_;
+		max_   = max_ < v ? v : max_;
+	}
+	void push(quantity_span<const quantity_type> in) {
+		if(in.empty())
+			return;
+		running_stats other;
+		other.count_ = in.size();
+		other.mean_  = detail::pairwise_sum(in.values(), in.size()) / static_cast<value_type>(in.size());
+		other.m2_    = detail::sum_squared_deviations(in.values(), in.size(), other.mean_);
+		other.min_   = detail::extreme_value(in.values(), in.size(), detail::less_than   {});
+		other.max_   = detail::extreme_value(in.values(), in.size(), detail::greater_than{});
+		merge(other);
+	}
+	/** @} */
+
+	/**
+	 * @brief Combine statistics
+	 *
+	 * After this, the statistics are those of all quantities added to this
+	 * object and to @p other.
+	 *
+	 * @param other  statistics to merge into these
+	 */
+	running_stats& merge(const running_stats& other) {
+		if(other.count_ == 0)
+			return *this;
+		if(count_ == 0)
+			return *this = other;
+		const std::size_t count = count_ + other.count_;
+		const value_type  delta = other.mean_ - mean_;
+		const value_type  other_weight = static_cast<value_type>(other.count_) / static_cast<value_type>(count);
+		mean_  += delta * other_weight;
+		m2_    += other.m2_ + delta * delta * static_cast<value_type>(count_) * other_weight;
+		count_  = count;
+		min_    = other.min_ < min_ ? other.min_ : min_;
+		max_    = max_ < other.max_ ? other.max_ : max_;
+		return *this;
+	}
+
+	/** number of quantities added */
+	constexpr std::size_t   count()                                 const {return count_;}
+	constexpr bool          empty()                                 const {return count_ == 0;}
+
+	/**
+	 * @{
+	 *
+	 * @brief Statistics of the quantities added
+	 *
+	 * variance() is the population variance (dividing by the number of
+	 * quantities), sample_variance() the unbiased estimate of the variance
+	 * of the population sampled (dividing by the number of quantities minus
+	 * one). The standard deviations are their square roots.
+	 *
+	 * @note These must not be called if no quantities were added (for the
+	 *       sample variance and its standard deviation, at least two).
+	 */
+	constexpr quantity_type mean()                                  const {return quantity_type{mean_};}
+	constexpr quantity_type min ()                                  const {return quantity_type{min_ };}
+	constexpr quantity_type max ()                                  const {return quantity_type{max_ };}
+
+	          variance_type variance()                              const {assert(count_ > 0); return variance_type{m2_ / static_cast<value_type>(count_  )};}
+	          variance_type sample_variance()                       const {assert(count_ > 1); return variance_type{m2_ / static_cast<value_type>(count_-1)};}
+
+	          quantity_type standard_deviation()                    const {return quantity_type{std::sqrt(variance       ().get())};}
+	          quantity_type sample_standard_deviation()             const {return quantity_type{std::sqrt(sample_variance().get())};}
+	/** @} */
+
+private:
+	std::size_t                                       count_;
+	value_type                                        mean_;
+	value_type                                        m2_;
+	value_type                                        min_;
+	value_type                                        max_;
+};
+
+}
+
+#endif //UNLIB_STATISTICS_HPP
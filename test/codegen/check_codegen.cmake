@@ -0,0 +1,58 @@
+# Compares the instruction counts of the unlib_<name> and raw_<name> kernels
+# in an object file and fails if any unlib kernel needs more instructions.
+#
+# usage: cmake -DOBJDUMP=<objdump> -DOBJECTS=<object files> -P check_codegen.cmake
+
+if(NOT OBJDUMP OR NOT OBJECTS)
+  message(FATAL_ERROR "OBJDUMP and OBJECTS must be defined")
+endif()
+
+execute_process(COMMAND ${OBJDUMP} -d --no-show-raw-insn ${OBJECTS}
+                OUTPUT_VARIABLE disassembly
+                RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "${OBJDUMP} failed: ${result}")
+endif()
+
+# count the instructions of each function, ignoring padding
+string(REPLACE ";" "\;" disassembly "${disassembly}")
+string(REPLACE "\n" ";" lines "${disassembly}")
+set(function "")
+set(functions "")
+foreach(line IN LISTS lines)
+  if(line MATCHES "^[0-9a-f]+ <([A-Za-z_][A-Za-z0-9_]*)>:$")
+    set(function "${CMAKE_MATCH_1}")
+    list(APPEND functions "${function}")
+    set(count_${function} 0)
+  elseif(function AND line MATCHES "^ +[0-9a-f]+:\t(.*)$")
+    set(instruction "${CMAKE_MATCH_1}")
+    if(NOT instruction MATCHES "^(nop|xchg +%ax,%ax|data16|cs nop|int3)")
+      math(EXPR count_${function} "${count_${function}} + 1")
+    endif()
+  endif()
+endforeach()
+
+set(failures 0)
+set(kernels 0)
+foreach(function IN LISTS functions)
+  if(function MATCHES "^unlib_(.+)$")
+    set(name "${CMAKE_MATCH_1}")
+    if(NOT DEFINED count_raw_${name})
+      message(SEND_ERROR "no raw_${name} kernel for unlib_${name}")
+      math(EXPR failures "${failures} + 1")
+    elseif(count_unlib_${name} GREATER count_raw_${name})
+      message(SEND_ERROR "unlib_${name}: ${count_unlib_${name}} instructions, raw_${name}: ${count_raw_${name}}")
+      math(EXPR failures "${failures} + 1")
+    else()
+      message(STATUS "unlib_${name}: ${count_unlib_${name}} instructions, raw_${name}: ${count_raw_${name}}")
+    endif()
+    math(EXPR kernels "${kernels} + 1")
+  endif()
+endforeach()
+
+if(kernels EQUAL 0)
+  message(FATAL_ERROR "no kernels found in ${OBJECTS}")
+endif()
+if(failures GREATER 0)
+  message(FATAL_ERROR "${failures} of ${kernels} kernels need more instructions than their raw equivalents")
+endif()
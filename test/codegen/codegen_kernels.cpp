@@ -0,0 +1,95 @@
+/*
+ * Kernels for the codegen regression test
+ *
+ * Each unlib_<name> kernel performs an operation on quantities, and the
+ * corresponding raw_<name> kernel performs the same operation on raw values,
+ * the way one would write it by hand. check_codegen.cmake disassembles this
+ * file's object and fails if any unlib_<name> kernel has more instructions
+ * than raw_<name>.
+ *
+ * Kernels take and return raw values and have C linkage, so that their
+ * symbols are easy to find and their calling conventions are identical.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <unlib/common.hpp>
+#include <unlib/math.hpp>
+#include <unlib/quantity_span.hpp>
+
+namespace {
+
+using  W  =      unlib::watt<double>;
+using kW  = unlib::kilo<unlib::watt<double>>;
+using  h  =      unlib::hour<double>;
+using  Wh =      unlib::watt_hour<double>;
+using kWh = unlib::kilo<unlib::watt_hour<double>>;
+using  m2 = unlib::square_meter<double>;
+
+}
+
+extern "C" {
+
+/* arithmetic */
+
+double unlib_mul_kW_h(double p, double t)                                 {return (kW{p} * h{t}).get();}
+double   raw_mul_kW_h(double p, double t)                                 {return p * t;}
+
+double unlib_div_kWh_h(double e, double t)                                {return (kWh{e} / h{t}).get();}
+double   raw_div_kWh_h(double e, double t)                                {return e / t;}
+
+double unlib_add_kW(double a, double b)                                   {return (kW{a} + kW{b}).get();}
+double   raw_add_kW(double a, double b)                                   {return a + b;}
+
+double unlib_scalar_mul_kW(double a, double f)                            {return (kW{a} * f).get();}
+double   raw_scalar_mul_kW(double a, double f)                            {return a * f;}
+
+/* same-scale conversions must vanish */
+
+double unlib_assign_kW_h_to_kWh(double p, double t)                       {const kWh e = kW{p} * h{t}; return e.get();}
+double   raw_assign_kW_h_to_kWh(double p, double t)                       {return p * t;}
+
+double unlib_same_scale_cast(double v)                                    {return unlib::scale_cast<kWh::scale_type>(kWh{v}).get();}
+double   raw_same_scale_cast(double v)                                    {return v;}
+
+double unlib_same_value_cast(double v)                                    {return unlib::value_cast<double>(kWh{v}).get();}
+double   raw_same_value_cast(double v)                                    {return v;}
+
+/* conversions */
+
+double unlib_rescale_Wh_to_kWh(double v)                                  {return kWh{Wh{v}}.get();}
+double   raw_rescale_Wh_to_kWh(double v)                                  {return v * (1./1000.);}
+
+std::int64_t unlib_rescale_int_Wh_to_kWh(std::int64_t v)                 {return unlib::kilo<unlib::watt_hour<std::int64_t>>{unlib::watt_hour<std::int64_t>{v}}.get();}
+std::int64_t   raw_rescale_int_Wh_to_kWh(std::int64_t v)                 {return v / 1000;}
+
+float unlib_value_cast_to_float(double v)                                 {return unlib::value_cast<float>(kW{v}).get();}
+float   raw_value_cast_to_float(double v)                                 {return static_cast<float>(v);}
+
+/* comparisons */
+
+bool unlib_less_W_kW(double a, double b)                                  {return W{a} < kW{b};}
+bool   raw_less_W_kW(double a, double b)                                  {return a < b * 1000.;}
+
+/* math */
+
+double unlib_sqrt_m2(double v)                                            {return unlib::sqrt(m2{v}).get();}
+double   raw_sqrt_m2(double v)                                            {return std::sqrt(v);}
+
+/* loops */
+
+void unlib_add_arrays(const double* a, const double* b, double* r, std::size_t n) {
+	const auto qa = unlib::make_quantity_span<const kW>(a, n);
+	const auto qb = unlib::make_quantity_span<const kW>(b, n);
+	const auto qr = unlib::make_quantity_span<      kW>(r, n);
+	for(std::size_t idx=0; idx<n; ++idx)
+		qr[idx] = qa[idx] + qb[idx];
+}
+void   raw_add_arrays(const double* a, const double* b, double* r, std::size_t n) {
+	for(std::size_t idx=0; idx<n; ++idx)
+		r[idx] = a[idx] + b[idx];
+}
+
+}
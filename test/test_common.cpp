@@ -1,7 +1,15 @@
 #include <unlib/common.hpp>
+#include <unlib/common_extern.hpp>
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <sstream>
 #include <string>
+#include <system_error>
+#include <utility>
 
 #include <doctest/doctest.h>
 
@@ -58,6 +66,98 @@ TEST_CASE("common quantities") {
 			CHECK(std::string(unlib::literals::quantity_traits<nanometer::unit_type, nanometer::scale_type, nanometer::tag_type>::get_string()) =="nm");
 			CHECK(std::string(unlib::literals::quantity_traits<kilometer::unit_type, kilometer::scale_type, kilometer::tag_type>::get_string()) =="km");
 		}
+		SUBCASE("to_chars") {
+			char buffer[64];
+			const auto format = [&buffer](const auto& q) {
+				const auto result = unlib::to_chars(buffer, buffer+sizeof(buffer), q);
+				REQUIRE(result.ec == std::errc{});
+				return std::string(buffer, result.ptr);
+			};
+
+			CHECK(format(kilometer{1.5})                                 == "1.5 km");
+			CHECK(format(nanometer{-0.1})                                == "-0.1 nm");
+			CHECK(format(unlib::kilo<unlib::watt_hour<double>>{1e-7})    == "1e-07 kWh");
+			CHECK(format(unlib::kilo<unlib::ton<VT>>{42})                == "42 kt");
+			CHECK(format(unlib::second<VT>{std::numeric_limits<VT>::min()}) == std::to_string(std::numeric_limits<VT>::min()) + " s");
+			CHECK(format(unlib::second<unsigned>{0})                     == "0 s");
+
+			const double values[] = {0.1, 1./3., 2.5e300, 123456789.123, -4.9e-300};
+			for(double v : values) {
+				const std::string str = format(unlib::meter<double>{v});
+				CHECK(std::strtod(str.c_str(), nullptr) == v);
+			}
+
+			const unlib::kilo<unlib::watt_hour<double>> q{123.25};
+			CHECK(unlib::to_chars(buffer, buffer+10, q).ec == std::errc{});
+			CHECK(unlib::to_chars(buffer, buffer+ 9, q).ec == std::errc::value_too_large);
+			CHECK(unlib::to_chars(buffer, buffer+ 5, q).ec == std::errc::value_too_large);
+			CHECK(unlib::to_chars(buffer, buffer+ 5, unlib::second<VT>{123456}).ec == std::errc::value_too_large);
+		}
+		SUBCASE("from_chars") {
+			using kWh = unlib::kilo<unlib::watt_hour<double>>;
+			using errc = unlib::from_chars_errc;
+			const auto parse = [](const std::string& str, auto& q) {
+				const auto result = unlib::from_chars(str.data(), str.data()+str.size(), q);
+				return std::make_pair(result.ec, result.ptr - str.data());
+			};
+
+			kWh energy;
+			CHECK(parse("1.5 kWh", energy) == std::make_pair(errc::ok, std::ptrdiff_t{7}));
+			CHECK(energy.get() == 1.5);
+			CHECK(parse("-2kWh,3", energy) == std::make_pair(errc::ok, std::ptrdiff_t{5}));
+			CHECK(energy.get() == -2.);
+			CHECK(parse("1500 Wh", energy).first == errc::ok);
+			CHECK(energy.get() == doctest::Approx(1.5));
+			CHECK(parse("3.6 MWs", energy).first == errc::ok);
+			CHECK(energy.get() == doctest::Approx(1.));
+			CHECK(parse("2 GWh", energy).first == errc::ok);
+			CHECK(energy.get() == doctest::Approx(2000000.));
+
+			energy = kWh{42.};
+			CHECK(parse("1.5 kW"  , energy) == std::make_pair(errc::unit_mismatch, std::ptrdiff_t{4}));
+			CHECK(parse("1.5 kVArh", energy).first == errc::unit_mismatch);
+			CHECK(parse("1.5 kWhx", energy).first == errc::unit_mismatch);
+			CHECK(parse("1.5"     , energy).first == errc::unit_mismatch);
+			CHECK(parse("kWh"     , energy) == std::make_pair(errc::invalid_value, std::ptrdiff_t{0}));
+			CHECK(parse(" 1 kWh"  , energy).first == errc::invalid_value);
+			CHECK(parse("+1 kWh"  , energy).first == errc::invalid_value);
+			CHECK(energy.get() == 42.);
+
+			unlib::milli<unlib::second<std::int16_t>> ms;
+			CHECK(parse("32 s", ms).first == errc::ok);
+			CHECK(ms.get() == 32000);
+			CHECK(parse("-32768 ms", ms).first == errc::ok);
+			CHECK(ms.get() == -32768);
+			CHECK(parse("33 s", ms).first == errc::value_out_of_range);
+			CHECK(parse("32768 ms", ms).first == errc::value_out_of_range);
+			CHECK(ms.get() == -32768);
+
+			unlib::second<VT> s;
+			CHECK(parse("2 h", s).first == errc::ok);
+			CHECK(s.get() == 7200);
+			CHECK(parse("3 min", s).first == errc::ok);
+			CHECK(s.get() == 180);
+			CHECK(parse("5 us", s).first == errc::ok);
+			CHECK(s.get() == 0);
+			CHECK(parse("5 m", s).first == errc::unit_mismatch);
+
+			unlib::kilo<unlib::ton<VT>> kt;
+			CHECK(parse("3000 t", kt).first == errc::ok);
+			CHECK(kt.get() == 3);
+
+			unlib::kilo<unlib::var<double>> kvar;
+			CHECK(parse("1 kW", kvar).first == errc::unit_mismatch);
+			CHECK(parse("1 kVAr", kvar).first == errc::ok);
+
+			char buffer[64];
+			for(double v : {0.1, 1./3., -4.9e-300, 2.5e300}) {
+				const kWh written{v};
+				const auto end = unlib::to_chars(buffer, buffer+sizeof(buffer), written).ptr;
+				kWh read;
+				REQUIRE(unlib::from_chars(buffer, end, read).ec == errc::ok);
+				CHECK(read == written);
+			}
+		}
 	}
 
 	SUBCASE("time") {
@@ -768,3 +868,29 @@ TEST_CASE("common quantities") {
 		CHECK(power * percent == 490._kW);
 	}
 }
+
+namespace {
+
+template<typename Q>
+bool io_round_trips(const Q& q) {
+	char buffer[64];
+	const auto to_result = unlib::to_chars(buffer, buffer+sizeof(buffer), q);
+	Q parsed{};
+	const auto from_result = unlib::from_chars(buffer, to_result.ptr, parsed);
+	std::ostringstream oss;
+	oss << q;
+	std::istringstream iss{oss.str()};
+	Q streamed{};
+	iss >> streamed;
+	return from_result.ec == unlib::from_chars_errc::ok and parsed == q and streamed == q
+	   and not unlib::to_string(q).empty();
+}
+
+}
+
+TEST_CASE("common quantities' I/O instantiations") {
+	// links against unlib_common's instantiations when UNLIB_EXTERN_COMMON_QUANTITIES is 1
+#define UNLIB_CHECK_IO_ROUND_TRIPS(Arg_, Q_) CHECK( io_round_trips(Q_{Arg_}) );
+	UNLIB_FOR_EACH_COMMON_QUANTITY_TYPE(UNLIB_CHECK_IO_ROUND_TRIPS, 42)
+#undef UNLIB_CHECK_IO_ROUND_TRIPS
+}
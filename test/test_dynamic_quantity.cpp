@@ -0,0 +1,136 @@
+#include <unlib/dynamic_quantity.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+#include <doctest/doctest.h>
+
+#include <unlib/common.hpp>
+#include <unlib/test/unlib_test.hpp>
+
+namespace {
+
+using high_id_tag = unlib::tag_t<struct high_id_tag_id>;
+
+}
+
+namespace unlib {
+
+UNLIB_DEFINE_DYNAMIC_TAG_ID(high_id_tag, 200)
+
+}
+
+TEST_CASE("dynamic quantities") {
+	using namespace unlib;
+
+	using kWh = kilo<watt_hour<double>>;
+	using  Wh =      watt_hour<double>;
+	using  kW = kilo<watt<double>>;
+
+	SUBCASE("dynamic units are compact") {
+		CHECK( sizeof(dynamic_unit) <= 16 );
+		CHECK( std::is_trivially_copyable<dynamic_unit>::value );
+		CHECK( sizeof(dynamic_quantity<>) <= 24 );
+	}
+
+	SUBCASE("dynamic units are created from quantity types") {
+		constexpr dynamic_unit du = make_dynamic_unit<kWh>();
+		const int d = dynamic_unit::exponent_denominator;
+		CHECK( du.get_exponent(0) == -2*d );
+		CHECK( du.get_exponent(1) ==  1*d );
+		CHECK( du.get_exponent(2) ==  2*d );
+		CHECK( du.get_exponent(3) ==  0   );
+		CHECK( du.get_tag_exponent() == 0 );
+		CHECK( du.get_tag_id() == 0 );
+		CHECK( du.get_scale_factor() == doctest::Approx(3600000.) );
+
+		CHECK( make_dynamic_unit<milli<meter<double>>>().get_scale_factor() == doctest::Approx(0.001) );
+		CHECK( make_dynamic_unit<     minute<double>  >().get_scale_factor() == 60. );
+		CHECK( make_dynamic_unit<degree_celsius<double>>().get_tag_id() == dynamic_tag_id<celsius_tag::id>::value );
+		CHECK( make_dynamic_unit<degree_celsius<double>>().get_tag_exponent() == d );
+
+		const dynamic_unit raw{du.get_exponents_word(), du.get_scale_word()};
+		CHECK( raw == du );
+		CHECK( raw != make_dynamic_unit<Wh>() );
+		CHECK( raw.is_compatible(make_dynamic_unit<Wh>()) );
+		CHECK( not raw.is_compatible(make_dynamic_unit<kW>()) );
+	}
+
+	SUBCASE("dynamic units multiply and divide like static units") {
+		CHECK( make_dynamic_unit<kW>() * make_dynamic_unit<hour<double>>() == make_dynamic_unit<kWh>() );
+		CHECK( make_dynamic_unit<kWh>() / make_dynamic_unit<hour<double>>() == make_dynamic_unit<kW>() );
+		CHECK( make_dynamic_unit<meter<double>>() / make_dynamic_unit<second<double>>() == make_dynamic_unit<meter_per_second<double>>() );
+		CHECK( make_dynamic_unit<kWh>() / make_dynamic_unit<kWh>() == dynamic_unit{} );
+
+		const dynamic_unit dvar = make_dynamic_unit<var<double>>();
+		CHECK( (dvar / dvar).get_tag_id() == 0 );
+		CHECK( (dvar * make_dynamic_unit<hour<double>>()).get_tag_id() == dvar.get_tag_id() );
+		CHECK_THROWS_AS( dvar / make_dynamic_unit<voltampere<double>>(), dimension_error );
+
+		using high_id_energy = quantity<energy, no_scaling, double, high_id_tag>;
+		const dynamic_unit dhigh = make_dynamic_unit<high_id_energy>();
+		CHECK( dhigh.get_tag_id() == 200 );
+		CHECK( (dhigh / make_dynamic_unit<second<double>>()).get_tag_id() == 200 );
+		CHECK( (dhigh / make_dynamic_unit<second<double>>()) * make_dynamic_unit<second<double>>() == dhigh );
+		CHECK( (make_dynamic_unit<kilo<second<double>>>() * dhigh).get_scale_factor() == doctest::Approx(1000.) );
+
+		const dynamic_unit big{detail::lane(127,0), 0};
+		CHECK_THROWS_AS( big * big, dimension_error );
+		CHECK_THROWS_AS( dynamic_unit{} / big / big, dimension_error );
+	}
+
+	SUBCASE("dynamic quantities are created from static ones") {
+		const dynamic_quantity<> dq = kWh{1.5};
+		CHECK( dq.get() == 1.5 );
+		CHECK( dq.get_unit() == make_dynamic_unit<kWh>() );
+
+		const dynamic_quantity<float> fq = watt_hour<int>{3};
+		CHECK( fq.get() == 3.f );
+	}
+
+	SUBCASE("dynamic quantities can be cast to static ones") {
+		const dynamic_quantity<> dq = kWh{1.5};
+		CHECK( quantity_cast<kWh>(dq).get() == 1.5 );
+		CHECK( quantity_cast<Wh >(dq).get() == doctest::Approx(1500.) );
+		CHECK( quantity_cast<kilo<watt_second<double>>>(dynamic_quantity<>{mega<watt_second<double>>{1.}}).get() == doctest::Approx(1000.) );
+		CHECK_THROWS_AS( quantity_cast<kW>(dq), dimension_error );
+		CHECK_THROWS_AS( quantity_cast<kilo<joule<double>>>(dq), dimension_error );
+	}
+
+	SUBCASE("dynamic quantities support arithmetic") {
+		const dynamic_quantity<> e1 = kWh{1.};
+		const dynamic_quantity<> e2 =  Wh{500.};
+
+		CHECK( (e1 + e2).get() == doctest::Approx(1.5) );
+		CHECK( (e1 + e2).get_unit() == e1.get_unit() );
+		CHECK( (e2 - e1).get() == doctest::Approx(-500.) );
+		CHECK( (-e1).get() == -1. );
+		CHECK( (e1 * 2.).get() == 2. );
+		CHECK( (2. * e1).get() == 2. );
+		CHECK( (e1 / 2.).get() == .5 );
+
+		const dynamic_quantity<> p = e1 / dynamic_quantity<>{hour<double>{2.}};
+		CHECK( p.get() == .5 );
+		CHECK( quantity_cast<kW>(p).get() == doctest::Approx(.5) );
+		CHECK( quantity_cast<watt<double>>(e1 / dynamic_quantity<>{second<double>{3600.}}).get() == doctest::Approx(1000.) );
+
+		const dynamic_quantity<> f = 1. / dynamic_quantity<>{second<double>{4.}};
+		CHECK( quantity_cast<hertz<double>>(f).get() == .25 );
+
+		CHECK_THROWS_AS( e1 + dynamic_quantity<>{kW{1.}}, dimension_error );
+		CHECK_THROWS_AS( e1 - dynamic_quantity<>{kilo<joule<double>>{1.}}, dimension_error );
+	}
+
+	SUBCASE("dynamic quantities can be compared") {
+		const dynamic_quantity<> e1 = kWh{1.};
+		const dynamic_quantity<> e2 =  Wh{1000.};
+		const dynamic_quantity<> e3 =  Wh{1001.};
+		CHECK( e1 == e2 );
+		CHECK( e1 != e3 );
+		CHECK( e1 <  e3 );
+		CHECK( e3 >  e1 );
+		CHECK( e1 <= e2 );
+		CHECK( e1 >= e2 );
+		CHECK_THROWS_AS( (void)(e1 < dynamic_quantity<>{kW{1.}}), dimension_error );
+	}
+}
@@ -0,0 +1,111 @@
+#include <unlib/mapped_quantity_span.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <doctest/doctest.h>
+
+#include <unlib/common.hpp>
+#include <unlib/test/unlib_test.hpp>
+
+namespace {
+
+class temporary_file {
+public:
+	temporary_file() {
+		char name[] = "/tmp/unlib_test_XXXXXX";
+		const int fd = ::mkstemp(name);
+		REQUIRE( fd >= 0 );
+		::close(fd);
+		path_ = name;
+	}
+	~temporary_file()                                                     {std::remove(path_.c_str());}
+
+	const std::string& get_path() const                                   {return path_;}
+
+private:
+	std::string path_;
+};
+
+}
+
+TEST_CASE("memory-mapped quantity spans") {
+	using namespace unlib;
+
+	using  Wh =      watt_hour<double>;
+	using kWh = kilo<watt_hour<double>>;
+	using  kW = kilo<watt<double>>;
+	using var_int = var<std::int32_t>;
+
+	std::vector<kWh    > energy(1000);
+	for(std::size_t idx=0; idx<energy.size(); ++idx)
+		energy[idx] = kWh{static_cast<double>(idx)};
+	std::vector<var_int> reactive{var_int{1}, var_int{2}, var_int{3}};
+
+	const temporary_file file;
+	{
+		std::ofstream ofs(file.get_path(), std::ios_base::binary);
+		write_quantity_columns(ofs, make_quantity_span(energy), make_quantity_span(reactive));
+		REQUIRE( ofs.good() );
+	}
+
+	SUBCASE("columns are accessed without copying") {
+		const mapped_column_file mapped(file.get_path());
+		REQUIRE( mapped.get_column_count() == 2 );
+		CHECK( mapped.get_descriptor(0).count == energy.size() );
+		CHECK_THROWS_AS( mapped.get_descriptor(2), std::out_of_range );
+
+		const mapped_quantity_span<kWh> m0 = mapped.get_column<kWh>(0);
+		REQUIRE( m0.size() == energy.size() );
+		CHECK( reinterpret_cast<std::uintptr_t>(m0.data()) % quantity_columns_alignment == 0 );
+		for(std::size_t idx=0; idx<energy.size(); ++idx)
+			CHECK( m0[idx] == energy[idx] );
+		CHECK( std::accumulate(m0.begin(), m0.end(), kWh{}).get() == 999.*1000/2 );
+
+		const quantity_span<const var_int> s1 = mapped.get_column<var_int>(1);
+		REQUIRE( s1.size() == reactive.size() );
+		CHECK( s1[2].get() == 3 );
+	}
+
+	SUBCASE("spans keep the mapping alive") {
+		const mapped_quantity_span<var_int> m1(file.get_path(), 1, mapping_advice::random);
+		const mapped_quantity_span<var_int> copy = m1;
+		CHECK( copy.values()[0] == 1 );
+		CHECK( copy.get_span().back().get() == 3 );
+
+		const mapped_quantity_span<kWh> huge(file.get_path(), 0, mapping_advice::sequential, true);
+		CHECK( huge.size() == energy.size() );
+		CHECK( huge[999] == energy[999] );
+	}
+
+	SUBCASE("columns are checked against the requested quantity") {
+		const mapped_column_file mapped(file.get_path(), mapping_advice::normal, true);
+		CHECK_THROWS_AS( mapped.get_column<Wh>(0), column_format_error );
+		CHECK_THROWS_AS( mapped.get_column<kW>(0), column_format_error );
+		CHECK_THROWS_AS( mapped.get_column<kilo<watt_hour<float>>>(0), column_format_error );
+		CHECK_THROWS_AS( mapped.get_column<kWh>(1), column_format_error );
+	}
+
+	SUBCASE("malformed files are rejected") {
+		CHECK_THROWS_AS( mapped_column_file{file.get_path() + ".does_not_exist"}, std::system_error );
+
+		const temporary_file truncated;
+		{
+			std::ifstream ifs(file.get_path(), std::ios_base::binary);
+			std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+			std::ofstream ofs(truncated.get_path(), std::ios_base::binary);
+			ofs.write(content.data(), static_cast<std::streamsize>(content.size()-1));
+		}
+		CHECK_THROWS_AS( mapped_column_file{truncated.get_path()}, column_format_error );
+
+		const temporary_file empty;
+		CHECK_THROWS_AS( mapped_column_file{empty.get_path()}, column_format_error );
+	}
+}
@@ -1,5 +1,9 @@
 #include <unlib/math.hpp>
 
+#include <cstddef>
+#include <limits>
+#include <vector>
+
 #include <doctest/doctest.h>
 
 #include <unlib/common.hpp>
@@ -515,6 +519,32 @@ TEST_CASE("math") {
 			CHECK(typeid(unlib::pow< 0>(a)) == typeid(quantity0));
 			CHECK(typeid(unlib::pow<-1>(a)) == typeid(quantity_1));
 			CHECK(typeid(unlib::pow<-2>(a)) == typeid(quantity_2));
+
+			CHECK(unlib::pow< 3>(a).get() == 8.);
+			CHECK(unlib::pow< 2>(a).get() == 4.);
+			CHECK(unlib::pow< 1>(a).get() == 2.);
+			CHECK(unlib::pow< 0>(a).get() == 1.);
+			CHECK(unlib::pow<-1>(a).get() == 0.5);
+			CHECK(unlib::pow<-2>(a).get() == 0.25);
+			CHECK(unlib::pow< 7>(unlib::meter<double>{2}).get() == 128.);
+			CHECK(unlib::pow<-7>(unlib::meter<double>{2}).get() == 1./128.);
+		}
+		SUBCASE("integer exponents of integer values") {
+			using meter = unlib::meter<int>;
+			CHECK(typeid(unlib::pow< 2>(meter{3})) == typeid(unlib::square_meter<int>));
+			CHECK(typeid(unlib::pow< 3>(meter{3})) == typeid(unlib:: cubic_meter<int>));
+			CHECK(unlib::pow< 2>(meter{ 3}).get() ==  9);
+			CHECK(unlib::pow< 3>(meter{-3}).get() == -27);
+			CHECK(unlib::pow< 5>(meter{ 3}).get() == 243);
+			CHECK(unlib::pow<-1>(meter{ 1}).get() ==   1);
+			CHECK(unlib::pow<-1>(meter{ 3}).get() ==   0);
+		}
+		SUBCASE("integer exponents at compile time") {
+			constexpr auto area   = unlib::pow<2>(unlib::meter<long  >{12});
+			constexpr auto volume = unlib::pow<3>(unlib::meter<double>{0.5});
+			static_assert(area  .get() == 144  , "pow<2> must be constexpr");
+			static_assert(volume.get() == 0.125, "pow<3> must be constexpr");
+			CHECK(area.get() == 144);
 		}
 		SUBCASE("ratio exponents") {
 			using quantity_r1  = quantity1;
@@ -639,6 +669,175 @@ TEST_CASE("math") {
 
 }
 
+TEST_CASE("math on spans") {
+	using namespace unlib;
+
+	// 21 is no multiple of any block or SIMD register size, so the remainders are tested, too
+	const std::size_t size = 21;
+	std::vector<square_meter<double>> areas;
+	std::vector<watt        <double>> watts;
+	std::vector<kilo<watt  <double>>> kilowatts;
+	for(std::size_t idx=0; idx<size; ++idx) {
+		areas    .push_back(square_meter<double>{idx*idx*1.5});
+		watts    .push_back(watt        <double>{(idx%2 ? -1. : 1.) * idx * 100.});
+		kilowatts.push_back(kilo<watt  <double>>{(idx%3 ? -1. : 1.) * idx * 0.1});
+	}
+	const auto areas_span = make_quantity_span(areas);
+	const quantity_span<const watt<double>> watts_span{watts};
+
+	SUBCASE("abs") {
+		std::vector<watt<double>> result(size);
+		abs_span(watts_span, make_quantity_span(result));
+		for(std::size_t idx=0; idx<size; ++idx)
+			CHECK(result[idx] == unlib::abs(watts[idx]));
+
+		abs_span(make_quantity_span(watts), make_quantity_span(watts));
+		CHECK(watts == result);
+	}
+
+	SUBCASE("sqrt") {
+		std::vector<meter<double>> result(size);
+		sqrt_span(areas_span, make_quantity_span(result));
+		for(std::size_t idx=0; idx<size; ++idx)
+			CHECK(result[idx] == unlib::sqrt(areas[idx]));
+
+		std::vector<meter<double>> pow_result(size);
+		pow_span<ratio_t<1,2>>(areas_span, make_quantity_span(pow_result));
+		CHECK(pow_result == result);
+
+		std::vector<square_meter<float>> float_areas;
+		for(auto area : areas)
+			float_areas.push_back(value_cast<float>(area));
+		std::vector<meter<float>> float_result(size);
+		sqrt_span(make_quantity_span(float_areas), make_quantity_span(float_result));
+		for(std::size_t idx=0; idx<size; ++idx)
+			CHECK(float_result[idx] == unlib::sqrt(float_areas[idx]));
+	}
+
+	SUBCASE("cbrt") {
+		std::vector<cubic_meter<double>> volumes;
+		for(std::size_t idx=0; idx<size; ++idx)
+			volumes.push_back(cubic_meter<double>{idx*idx*idx*2.});
+		std::vector<meter<double>> result(size);
+		cbrt_span(make_quantity_span(volumes), make_quantity_span(result));
+		for(std::size_t idx=0; idx<size; ++idx)
+			CHECK(result[idx] == unlib::cbrt(volumes[idx]));
+	}
+
+	SUBCASE("pow") {
+		std::vector<square_meter<double>> result(size);
+		std::vector<meter<double>> lengths(size);
+		sqrt_span(areas_span, make_quantity_span(lengths));
+		pow_span<2>(make_quantity_span(lengths), make_quantity_span(result));
+		for(std::size_t idx=0; idx<size; ++idx)
+			CHECK(result[idx] == unlib::pow<2>(lengths[idx]));
+
+		std::vector<cubic_meter<double>> cubes(size);
+		pow_span<ratio_t<3,2>>(areas_span, make_quantity_span(cubes));
+		for(std::size_t idx=0; idx<size; ++idx)
+			CHECK(cubes[idx] == unlib::pow<ratio_t<3,2>>(areas[idx]));
+	}
+
+	SUBCASE("min, max") {
+		std::vector<watt<double>> mins(size), maxs(size);
+		min_span(watts_span, make_quantity_span(kilowatts), make_quantity_span(mins));
+		max_span(watts_span, make_quantity_span(kilowatts), make_quantity_span(maxs));
+		for(std::size_t idx=0; idx<size; ++idx) {
+			CHECK(mins[idx] == unlib::min(watts[idx], kilowatts[idx]));
+			CHECK(maxs[idx] == unlib::max(watts[idx], kilowatts[idx]));
+		}
+
+		std::vector<watt<double>> same(size);
+		min_span(watts_span, watts_span, make_quantity_span(same));
+		CHECK(same == watts);
+	}
+}
+
+TEST_CASE("is_near on spans") {
+	using namespace unlib;
+	using  W = watt<double>;
+	using kW = kilo<watt<double>>;
+
+	// 21 is no multiple of the block size, so the remainder is tested, too
+	const std::size_t size = 21;
+	std::vector<kW> golden, actual;
+	std::vector<W>  actual_W;
+	for(std::size_t idx=0; idx<size; ++idx) {
+		golden.push_back(kW{idx * 1.5});
+		actual.push_back(golden.back());
+	}
+	actual[ 3] += kW{0.002};  // mismatch
+	actual[ 9] -= kW{0.0005}; // near
+	actual[17] -= kW{0.005};  // worst mismatch
+	actual[20] += kW{0.003};  // mismatch in the remainder
+	for(auto a : actual)
+		actual_W.push_back(W{a});
+	const quantity_span<const kW> golden_span{golden};
+	const auto tol = tolerance_value(W{1.});
+
+	SUBCASE("results are those of is_near()") {
+		const auto result = is_near_span(make_quantity_span(actual), golden_span, tol);
+		std::size_t mismatches = 0;
+		for(std::size_t idx=0; idx<size; ++idx)
+			mismatches += not is_near(actual[idx], golden[idx], tol);
+		CHECK(result.mismatches == mismatches);
+		CHECK(result.mismatches == 3);
+		CHECK(not result.all_near());
+		CHECK(result.first_mismatch == 3);
+		CHECK(result.worst == 17);
+		CHECK(typeid(result.worst_deviation) == typeid(kW));
+		CHECK(result.worst_deviation.get() == doctest::Approx(0.005));
+
+		CHECK(find_not_near(make_quantity_span(actual), golden_span, tol) == 3);
+	}
+
+	SUBCASE("different scales") {
+		const auto result = is_near_span(make_quantity_span(actual_W), golden_span, tol);
+		CHECK(result.mismatches == 3);
+		CHECK(result.first_mismatch == 3);
+		CHECK(result.worst == 17);
+		CHECK(typeid(result.worst_deviation) == typeid(W));
+		CHECK(result.worst_deviation.get() == doctest::Approx(5.));
+		CHECK(find_not_near(make_quantity_span(actual_W), golden_span, tolerance_value(kW{0.001})) == 3);
+	}
+
+	SUBCASE("nominal and fraction") {
+		const auto result = is_near_span( make_quantity_span(actual), golden_span
+		                                , tolerance_nominal(kW{10.}), tolerance_fraction<kW>(percent<double>{0.01}) );
+		CHECK(result.mismatches == 3);
+		CHECK(find_not_near(make_quantity_span(actual), golden_span, tolerance_nominal(kW{10.}), tolerance_fraction<kW>(percent<double>{0.01})) == 3);
+	}
+
+	SUBCASE("mismatch mask") {
+		unsigned char mask[(size+7)/8] = {0xff, 0xff, 0xff};
+		const auto result = is_near_span(make_quantity_span(actual), golden_span, mask, tol);
+		CHECK(result.mismatches == 3);
+		CHECK(mask[0] == 1u<<3);
+		CHECK(mask[1] == 0u);
+		CHECK(mask[2] == ((1u<<(17-16)) | (1u<<(20-16))));
+	}
+
+	SUBCASE("all near") {
+		const auto result = is_near_span(golden_span, golden_span, tol);
+		CHECK(result.all_near());
+		CHECK(result.first_mismatch == size);
+		CHECK(result.worst_deviation == kW{0.});
+		CHECK(find_not_near(golden_span, golden_span, tol) == size);
+
+		const auto empty = is_near_span(golden_span.first(0), golden_span.first(0), tol);
+		CHECK(empty.all_near());
+		CHECK(empty.worst == 0);
+	}
+
+	SUBCASE("NaN") {
+		actual[0] = kW{std::numeric_limits<double>::quiet_NaN()};
+		const auto result = is_near_span(make_quantity_span(actual), golden_span, tol);
+		CHECK(result.mismatches == 4);
+		CHECK(result.first_mismatch == 0);
+		CHECK(result.worst == 17);
+	}
+}
+
 TEST_CASE_TEMPLATE("is_near, is_smaller, is_greater", Float, float, double, long double) {
 
 	const auto f_tiny        = Float{  0.0000001f};
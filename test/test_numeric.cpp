@@ -0,0 +1,249 @@
+#include <unlib/numeric.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <unlib/common.hpp>
+#include <unlib/test/unlib_test.hpp>
+
+TEST_CASE("summing quantities") {
+	using namespace unlib;
+
+	using  Ws = watt_second<double>;
+	using kWh = kilo<watt_hour<double>>;
+
+	SUBCASE("sum of integer quantities is exact") {
+		std::vector<meter<long>> v;
+		long expected = 0;
+		for(long i=0; i<1001; ++i) {
+			v.push_back(meter<long>{i*i - 300*i});
+			expected += i*i - 300*i;
+		}
+		const auto result = sum(make_quantity_span(v));
+		CHECK( typeid(result) == typeid(meter<long>) );
+		CHECK( result.get() == expected );
+
+		CHECK( sum(quantity_span<const meter<long>>{}).get() == 0 );
+		CHECK( sum(make_quantity_span(v).first(3)).get() == 0 - 299 - 596 );
+	}
+
+	SUBCASE("pairwise sum is more accurate than adding one by one") {
+		const std::vector<Ws> v(1000000, Ws{0.1});
+		double naive = 0.;
+		for(const auto& q : v)
+			naive += q.get();
+
+		const auto result = sum(make_quantity_span(v));
+		CHECK( typeid(result) == typeid(Ws) );
+		CHECK( std::abs(result.get() - 1e5) < 1e-9 );
+		CHECK( std::abs(result.get() - 1e5) < std::abs(naive - 1e5) );
+	}
+
+	SUBCASE("compensated sum is exact to the value type's precision") {
+		const std::vector<Ws> v(1000000, Ws{0.1});
+		CHECK( compensated_sum(make_quantity_span(v)).get() == 1e5 );
+
+		// naive (and Kahan's original) summation yields 0. here
+		const Ws cancelling[] = {Ws{1.}, Ws{1e100}, Ws{1.}, Ws{-1e100}};
+		CHECK( compensated_sum(make_quantity_span(cancelling)).get() == 2. );
+
+		kahan_accumulator<Ws> acc;
+		for(const auto& q : cancelling)
+			acc += q;
+		CHECK( acc.sum().get() == 2. );
+		acc -= Ws{1e100};
+		acc -= Ws{-1e100};
+		CHECK( acc.sum().get() == 2. );
+	}
+
+	SUBCASE("accumulating quantities of another scale rescales their sums") {
+		std::vector<Ws> v(36000, Ws{100.});
+		kahan_accumulator<kWh> acc{kWh{1.}};
+		acc.add(make_quantity_span(v));
+		CHECK( typeid(acc.sum()) == typeid(kWh) );
+		CHECK( acc.sum().get() == doctest::Approx(2.) );
+
+		acc += Ws{3.6e6};
+		CHECK( acc.sum().get() == doctest::Approx(3.) );
+	}
+
+	SUBCASE("merged partial sums equal the sum of all quantities") {
+		std::vector<Ws> v;
+		for(int i=0; i<1003; ++i)
+			v.push_back(Ws{std::sin(i) * std::pow(10., i%17)});
+		const auto all = make_quantity_span(v);
+
+		kahan_accumulator<Ws> total;
+		total.add(all);
+
+		kahan_accumulator<Ws> part1, part2, part3;
+		part1.add(all.first(100));
+		part2.add(all.subspan(100, 500));
+		for(std::size_t idx=600; idx<all.size(); ++idx)
+			part3 += all[idx];
+		part1.merge(part2).merge(part3);
+
+		CHECK( part1.sum().get() == total.sum().get() );
+	}
+}
+
+TEST_CASE("reducing quantities") {
+	using namespace unlib;
+
+	using kW = kilo<watt<double>>;
+
+	SUBCASE("mean, minimum, and maximum of quantities") {
+		const meter<double> m[] = {meter<double>{3.}, meter<double>{-1.}, meter<double>{4.}, meter<double>{-1.}, meter<double>{5.}};
+		const auto s = make_quantity_span(m);
+		CHECK( mean  (s).get() == 2. );
+		CHECK( min   (s).get() == -1. );
+		CHECK( max   (s).get() ==  5. );
+		CHECK( argmin(s) == 1 );
+		CHECK( argmax(s) == 4 );
+		CHECK( typeid(min(s)) == typeid(meter<double>) );
+
+		std::vector<kW> v;
+		for(int i=0; i<1003; ++i)
+			v.push_back(kW{std::cos(i * 0.1) * i});
+		const auto vs = make_quantity_span(v);
+		std::size_t expected_min = 0, expected_max = 0;
+		for(std::size_t idx=1; idx<v.size(); ++idx) {
+			if(v[idx] < v[expected_min]) expected_min = idx;
+			if(v[idx] > v[expected_max]) expected_max = idx;
+		}
+		CHECK( argmin(vs) == expected_min );
+		CHECK( argmax(vs) == expected_max );
+		CHECK( min(vs).get() == v[expected_min].get() );
+		CHECK( max(vs).get() == v[expected_max].get() );
+		CHECK( mean(vs).get() == doctest::Approx(sum(vs).get() / 1003.) );
+		CHECK( mean(make_quantity_span(v).first(1)).get() == 0. );
+
+		const meter<long> l[] = {meter<long>{1}, meter<long>{2}};
+		CHECK( mean(make_quantity_span(l)).get() == 1 );
+	}
+}
+
+TEST_CASE("integrating quantities") {
+	using namespace unlib;
+
+	using   W  = watt<double>;
+	using   s  = second<double>;
+	using kWh  = kilo<watt_hour<double>>;
+
+	SUBCASE("timestamped samples are integrated using the trapezoidal rule") {
+		const W power[] = {W{100.}, W{200.}, W{200.}, W{0.}};
+		const s times[] = {s{0.}, s{10.}, s{30.}, s{40.}};
+		const auto energy = integrate(make_quantity_span(power), make_quantity_span(times));
+		CHECK( typeid(energy) == typeid(mul_quantity_t<W,s>) );
+		CHECK( energy.get() == 1500. + 4000. + 1000. );
+
+		const auto kwh = integrate<kWh>(make_quantity_span(power), make_quantity_span(times));
+		CHECK( typeid(kwh) == typeid(kWh) );
+		CHECK( kwh.get() == doctest::Approx(6500. / 3.6e6) );
+
+		CHECK( integrate(make_quantity_span(power).first(1), make_quantity_span(times).first(1)).get() == 0. );
+	}
+
+	SUBCASE("uniformly sampled quantities are integrated using the trapezoidal rule") {
+		const W power[] = {W{100.}, W{200.}, W{200.}, W{0.}};
+		const auto energy = integrate(make_quantity_span(power), s{10.});
+		CHECK( typeid(energy) == typeid(mul_quantity_t<W,s>) );
+		CHECK( energy.get() == 1500. + 2000. + 1000. );
+
+		const auto kwh = integrate<kWh>(make_quantity_span(power), minute<double>{1.});
+		CHECK( kwh.get() == doctest::Approx(450. / 1000. / 60.) );
+	}
+
+	SUBCASE("integrals equal the sums of the trapezoids") {
+		std::vector<kilo<W>> power;
+		std::vector<s>       times;
+		double t = 0., expected = 0.;
+		for(int i=0; i<1001; ++i) {
+			power.push_back(kilo<W>{2. + std::sin(i * 0.1)});
+			times.push_back(s{t});
+			if(i > 0)
+				expected += (times[i].get() - times[i-1].get()) * (power[i].get() + power[i-1].get()) / 2;
+			t += 1. + (i % 7) * 0.25;
+		}
+		const kWh energy = integrate<kWh>(make_quantity_span(power), make_quantity_span(times));
+		CHECK( energy.get() == doctest::Approx(expected / 3600.) );
+		CHECK( integrate(make_quantity_span(power), s{1.}).get() == doctest::Approx(sum(make_quantity_span(power)).get() - (power.front().get() + power.back().get()) / 2) );
+	}
+
+	SUBCASE("integer samples are truncated once") {
+		const watt<long>   power[] = {watt<long>{1}, watt<long>{2}, watt<long>{2}};
+		const second<long> times[] = {second<long>{0}, second<long>{1}, second<long>{2}};
+		CHECK( integrate(make_quantity_span(power), make_quantity_span(times)).get() == 3 );
+		CHECK( integrate(make_quantity_span(power), second<long>{1}).get() == 3 );
+	}
+}
+
+TEST_CASE("differentiating quantities") {
+	using namespace unlib;
+
+	using  W  = watt<double>;
+	using Wh  = watt_hour<double>;
+	using  s  = second<double>;
+
+	SUBCASE("rates are the difference quotients of consecutive samples") {
+		const Wh energy[] = {Wh{0.}, Wh{1.}, Wh{3.}, Wh{3.}};
+		const s  times [] = {s{0.}, s{3600.}, s{5400.}, s{9000.}};
+		std::vector<W> power(3);
+		differentiate(make_quantity_span(energy), make_quantity_span(times), make_quantity_span(power));
+		CHECK( power[0].get() == doctest::Approx(1.) );
+		CHECK( power[1].get() == doctest::Approx(4.) );
+		CHECK( power[2].get() == 0. );
+
+		std::vector<div_quantity_t<Wh,s>> rates(3);
+		differentiate(make_quantity_span(energy), make_quantity_span(times), make_quantity_span(rates));
+		CHECK( rates[1].get() == doctest::Approx(2. / 1800.) );
+
+		std::vector<kilo<W>> none;
+		differentiate(make_quantity_span(energy).first(1), make_quantity_span(times).first(1), make_quantity_span(none));
+	}
+
+	SUBCASE("rates are the same as dividing each difference") {
+		std::vector<Wh> energy;
+		std::vector<s>  times;
+		for(int i=0; i<1001; ++i) {
+			energy.push_back(Wh{i * 2.5 + std::sin(i)});
+			times .push_back(s {i * 0.9 + (i%3) * 0.1});
+		}
+		std::vector<W> power(1000);
+		differentiate(make_quantity_span(energy), make_quantity_span(times), make_quantity_span(power));
+		for(std::size_t idx=0; idx<power.size(); ++idx) {
+			const W expected = (energy[idx+1] - energy[idx]) / (times[idx+1] - times[idx]);
+			CHECK( power[idx].get() == doctest::Approx(expected.get()) );
+		}
+	}
+
+	SUBCASE("integer counters wrap around") {
+		using kWh_counter = kilo<watt_hour<unsigned>>;
+		using s_counter   = second<unsigned>;
+		const kWh_counter readings[] = {kWh_counter{999998}, kWh_counter{999999}, kWh_counter{1}, kWh_counter{3}};
+		const s_counter   times   [] = {s_counter{0}, s_counter{3600}, s_counter{7200}, s_counter{10800}};
+
+		std::vector<kilo<watt<double>>> power(3);
+		differentiate(make_quantity_span(readings), make_quantity_span(times), make_quantity_span(power), kWh_counter{1000000});
+		CHECK( power[0].get() == doctest::Approx(1.) );
+		CHECK( power[1].get() == doctest::Approx(2.) );
+		CHECK( power[2].get() == doctest::Approx(2.) );
+
+		const kWh_counter wrapped[] = {kWh_counter{0xFFFFFFFEu}, kWh_counter{0u}};
+		differentiate(make_quantity_span(wrapped), make_quantity_span(times).first(2), make_quantity_span(power).first(1));
+		CHECK( power[0].get() == doctest::Approx(2.) );
+
+		std::vector<kilo<watt<unsigned>>> integer_power(3);
+		const s_counter hours[] = {s_counter{0}, s_counter{1}, s_counter{2}, s_counter{3}};
+		const kilo<watt_second<unsigned>> joules[] = { kilo<watt_second<unsigned>>{10}, kilo<watt_second<unsigned>>{20}
+		                                             , kilo<watt_second<unsigned>>{50}, kilo<watt_second<unsigned>>{51} };
+		differentiate(make_quantity_span(joules), make_quantity_span(hours), make_quantity_span(integer_power));
+		CHECK( integer_power[0].get() == 10 );
+		CHECK( integer_power[1].get() == 30 );
+		CHECK( integer_power[2].get() ==  1 );
+	}
+}
@@ -0,0 +1,80 @@
+#include <unlib/parallel.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <unlib/common.hpp>
+#include <unlib/test/unlib_test.hpp>
+
+TEST_CASE("parallel reductions") {
+	using namespace unlib;
+
+	using kW = kilo<watt<double>>;
+
+	std::vector<kW> v;
+	for(int i=0; i<100003; ++i)
+		v.push_back(kW{std::sin(i*0.37) * 1000. + std::cos(i*0.011) * 0.001});
+	const auto values = make_quantity_span(v);
+
+	SUBCASE("thread pools run all tasks") {
+		for(std::size_t concurrency : {1, 2, 4}) {
+			thread_pool pool{concurrency};
+			CHECK( pool.concurrency() == concurrency );
+			std::vector<std::atomic<int>> runs(1000);
+			for(auto& r : runs)
+				r = 0;
+			pool.run(runs.size(), [&](std::size_t idx){++runs[idx];});
+			pool.run(runs.size(), [&](std::size_t idx){++runs[idx];});
+			for(const auto& r : runs)
+				CHECK( r == 2 );
+		}
+	}
+
+	SUBCASE("thread pools rethrow exceptions thrown by tasks") {
+		thread_pool pool{3};
+		CHECK_THROWS_AS( pool.run(100, [](std::size_t idx){if(idx == 42) throw std::runtime_error{"42"};}), std::runtime_error );
+		int runs = 0;
+		pool.run(1, [&](std::size_t){++runs;});
+		CHECK( runs == 1 );
+	}
+
+	SUBCASE("parallel reductions yield the results of sequential ones") {
+		for(std::size_t concurrency : {1, 2, 3, 8}) {
+			for(std::size_t min_chunk_size : {std::size_t{100}, std::size_t{4096}, std::size_t{1000000}}) {
+				thread_pool pool{concurrency, min_chunk_size};
+				CHECK( min_chunk_size == pool.min_chunk_size() );
+
+				const kW parallel_sum = sum(pool, values);
+				CHECK( parallel_sum.get() == sum(values).get() );
+				CHECK( mean(pool, values).get() == mean(values).get() );
+				CHECK( compensated_sum(pool, values).get() == doctest::Approx(compensated_sum(values).get()).epsilon(1e-15) );
+
+				CHECK( min   (pool, values).get() == min   (values).get() );
+				CHECK( max   (pool, values).get() == max   (values).get() );
+				CHECK( argmin(pool, values)       == argmin(values)       );
+				CHECK( argmax(pool, values)       == argmax(values)       );
+				CHECK( values[argmin(pool, values)].get() == min(values).get() );
+				CHECK( values[argmax(pool, values)].get() == max(values).get() );
+			}
+		}
+	}
+
+	SUBCASE("argmin and argmax find the first extreme value") {
+		std::vector<meter<long>> m(10000, meter<long>{0});
+		m[7777] = m[9999] = meter<long>{-1};
+		m[  13] = m[5000] = meter<long>{+1};
+		thread_pool pool{4, 64};
+		CHECK( argmin(pool, make_quantity_span(m)) == 7777 );
+		CHECK( argmax(pool, make_quantity_span(m)) ==   13 );
+		CHECK( argmin(      make_quantity_span(m)) == 7777 );
+		CHECK( argmax(      make_quantity_span(m)) ==   13 );
+		CHECK( sum   (pool, make_quantity_span(m)).get() == 0 );
+		CHECK( min   (pool, make_quantity_span(m)).get() == -1 );
+		CHECK( typeid(mean(pool, make_quantity_span(m))) == typeid(meter<long>) );
+	}
+}
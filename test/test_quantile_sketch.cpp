@@ -0,0 +1,143 @@
+#include <unlib/quantile_sketch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <unlib/common.hpp>
+#include <unlib/test/unlib_test.hpp>
+
+namespace {
+
+/* the fraction of values less than v */
+template<typename V>
+double rank_of(const std::vector<V>& sorted, V v) {
+	return static_cast<double>(std::lower_bound(sorted.begin(), sorted.end(), v) - sorted.begin()) / static_cast<double>(sorted.size());
+}
+
+}
+
+TEST_CASE("quantile sketches") {
+	using namespace unlib;
+
+	using ms = milli<second<double>>;
+
+	std::mt19937_64 gen{42};
+	std::lognormal_distribution<double> dist{3., 1.};
+	std::vector<ms> latencies;
+	for(int i=0; i<200000; ++i)
+		latencies.push_back(ms{dist(gen)});
+	std::vector<double> sorted;
+	for(const auto& l : latencies)
+		sorted.push_back(l.get());
+	std::sort(sorted.begin(), sorted.end());
+
+	SUBCASE("small sketches are exact") {
+		quantile_sketch<ms> sketch;
+		CHECK( sketch.empty() );
+		for(int i=1; i<=100; ++i)
+			sketch.insert(ms{static_cast<double>(i)});
+		CHECK( sketch.count() == 100 );
+		CHECK( typeid(sketch.quantile(0.5)) == typeid(ms) );
+		CHECK( sketch.quantile(0.  ).get() ==   1. );
+		CHECK( sketch.quantile(0.5 ).get() ==  50.5 );
+		CHECK( sketch.quantile(0.99).get() ==  99.5 );
+		CHECK( sketch.quantile(1.  ).get() == 100. );
+		CHECK( sketch.min().get() ==   1. );
+		CHECK( sketch.max().get() == 100. );
+
+		quantile_sketch<ms> single;
+		single.insert(ms{42.});
+		CHECK( single.quantile(0. ).get() == 42. );
+		CHECK( single.quantile(0.5).get() == 42. );
+		CHECK( single.quantile(1. ).get() == 42. );
+
+		quantile_sketch<meter<float>> negative;
+		for(int i=1000; i-->0; )
+			negative.insert(meter<float>{static_cast<float>(i - 500) / 4});
+		negative.compress();
+		CHECK( negative.quantile(0.).get() == -125.f );
+		CHECK( negative.quantile(1.).get() ==  124.75f );
+		CHECK( negative.quantile(0.5).get() == doctest::Approx(-0.125f).epsilon(0.01) );
+	}
+
+	SUBCASE("quantiles are accurate, and more so at the tails") {
+		quantile_sketch<ms> sketch;
+		for(const auto& l : latencies)
+			sketch.insert(l);
+		CHECK( sketch.count() == latencies.size() );
+		CHECK( sketch.min().get() == sorted.front() );
+		CHECK( sketch.max().get() == sorted.back () );
+		for(double q : {0.001, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999})
+			CHECK( std::abs(rank_of(sorted, sketch.quantile(q).get()) - q) < 0.01 * std::sqrt(q * (1-q)) + 1e-4 );
+
+		quantile_sketch<ms> batch;
+		batch.insert(make_quantity_span(latencies));
+		for(double q : {0.01, 0.5, 0.99})
+			CHECK( batch.quantile(q).get() == sketch.quantile(q).get() );
+
+		quantile_sketch<ms> larger{500.};
+		larger.insert(make_quantity_span(latencies));
+		CHECK( std::abs(rank_of(sorted, larger.quantile(0.999).get()) - 0.999) < std::abs(rank_of(sorted, sketch.quantile(0.999).get()) - 0.999) + 1e-5 );
+	}
+
+	SUBCASE("merged sketches estimate the quantiles of all quantities") {
+		const auto all = make_quantity_span(latencies);
+		quantile_sketch<ms> part1, part2, part3, empty;
+		part1.insert(all.first(50000));
+		part2.insert(all.subspan(50000, 100001));
+		for(std::size_t idx=150001; idx<all.size(); ++idx)
+			part3.insert(all[idx]);
+		part1.merge(empty).merge(part2).merge(part3);
+		empty.merge(part1);
+
+		for(const auto* sketch : {&part1, &empty}) {
+			CHECK( sketch->count() == latencies.size() );
+			CHECK( sketch->min().get() == sorted.front() );
+			CHECK( sketch->max().get() == sorted.back () );
+			for(double q : {0.01, 0.5, 0.99, 0.999})
+				CHECK( std::abs(rank_of(sorted, sketch->quantile(q).get()) - q) < 0.02 * std::sqrt(q * (1-q)) + 1e-4 );
+		}
+
+		part1.merge(part1);
+		CHECK( part1.count() == 2 * latencies.size() );
+		CHECK( std::abs(rank_of(sorted, part1.quantile(0.5).get()) - 0.5) < 0.01 );
+	}
+
+	SUBCASE("serialized sketches read back with their units checked") {
+		quantile_sketch<ms> sketch;
+		sketch.insert(make_quantity_span(latencies).first(100123));
+
+		std::stringstream ss;
+		sketch.write(ss);
+		CHECK( ss.str().size() < 72 + 16 * 120 );
+
+		const auto read = quantile_sketch<ms>::read(ss);
+		CHECK( read.count() == sketch.count() );
+		CHECK( read.compression() == sketch.compression() );
+		for(double q : {0., 0.01, 0.5, 0.99, 1.})
+			CHECK( read.quantile(q).get() == sketch.quantile(q).get() );
+
+		ss.clear();
+		ss.seekg(0);
+		const auto seconds = quantile_sketch<second<double>>::read(ss);
+		CHECK( seconds.quantile(0.5).get() == doctest::Approx(sketch.quantile(0.5).get() / 1000.) );
+
+		ss.clear();
+		ss.seekg(0);
+		CHECK_THROWS_AS( quantile_sketch<meter<double>>::read(ss), sketch_format_error );
+		ss.clear();
+		ss.seekg(0);
+		CHECK_THROWS_AS( quantile_sketch<milli<second<float>>>::read(ss), sketch_format_error );
+
+		std::stringstream truncated{ss.str().substr(0, ss.str().size() - 1)};
+		CHECK_THROWS_AS( quantile_sketch<ms>::read(truncated), sketch_format_error );
+		std::stringstream garbage{std::string(200, 'x')};
+		CHECK_THROWS_AS( quantile_sketch<ms>::read(garbage), sketch_format_error );
+	}
+}
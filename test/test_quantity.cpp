@@ -1,4 +1,7 @@
 #include <unlib/quantity.hpp>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
 #include <string>
 #include <functional>
 
@@ -132,6 +135,55 @@ TEST_CASE("quantities") {
 			detail::rescale_value<  mega_scaling,  mega_scaling >(test_value); CHECK(not test_value.multiplication_called); test_value.multiplication_called=false;
 		}
 
+		SUBCASE("floating point values are rescaled according to the rescaling policy") {
+			using kWh_scaling = std::ratio_multiply<kilo_scaling,hour_scaling>;
+			using half_scaling = std::ratio<1,2>;
+
+			CHECK(     detail::value_rescaler<half_scaling, no_scaling  >::is_factor_exact );
+			CHECK( not detail::value_rescaler< kWh_scaling, no_scaling  >::is_factor_exact );
+			CHECK(     detail::value_rescaler<  no_scaling, kWh_scaling >::is_factor_exact );
+
+			const double v = 1234567.891;
+			const double exact = (v*1)/3600000;
+			CHECK( detail::rescale_value<kWh_scaling, no_scaling>(v, detail::exact_floatpt_rescaling{}) == exact );
+			CHECK( detail::rescale_value<kWh_scaling, no_scaling>(v, detail:: fast_floatpt_rescaling{}) == doctest::Approx(exact) );
+			CHECK( detail::rescale_value<no_scaling, kWh_scaling>(v, detail:: fast_floatpt_rescaling{}) == v*3600000 );
+			CHECK( detail::rescale_value<no_scaling,half_scaling>(v, detail:: fast_floatpt_rescaling{}) == v/2 );
+
+			constexpr double folded = detail::rescale_value<kilo_scaling, no_scaling>(1000.);
+			CHECK( folded == doctest::Approx(1.) );
+
+			CHECK( detail::rescale_value<kWh_scaling, no_scaling>(7200000, detail::fast_floatpt_rescaling{}) == 2 );
+		}
+
+		SUBCASE("integer values are rescaled without overflowing intermediate results") {
+			using mWh_scaling = std::ratio_multiply<milli_scaling,hour_scaling>;             // ms->s is 18/5
+			using i64 = std::int64_t;
+			const i64 max = std::numeric_limits<i64>::max();
+
+			CHECK( detail::rescale_value<no_scaling, mWh_scaling>(i64{ 1000}) ==  3600 );
+			CHECK( detail::rescale_value<no_scaling, mWh_scaling>(i64{   -7}) ==   -25 );
+			CHECK( detail::rescale_value<no_scaling, mWh_scaling>(i64{    7}) ==    25 );
+			CHECK( detail::rescale_value<mWh_scaling, no_scaling>(i64{   25}) ==     6 );
+
+			// (v*18) overflows, v*18/5 does not
+			const i64 big = max/4;
+			CHECK( detail::rescale_value<no_scaling, mWh_scaling>(big) == big/5*18 + big%5*18/5 );
+			CHECK( detail::rescale_value<no_scaling, mWh_scaling>(-big) == -(big/5*18 + big%5*18/5) );
+
+			CHECK( detail::rescale_value<no_scaling, mWh_scaling>(std::int32_t{1000}) == 3600 );
+			CHECK( detail::rescale_value<no_scaling, mWh_scaling>(std::uint64_t{max}) == std::uint64_t{max}/5*18 + std::uint64_t{max}%5*18/5 );
+
+			i64 result = 0;
+			CHECK(     detail::value_rescaler<no_scaling, mWh_scaling>::try_rescale_value(big  , result) );
+			CHECK( not detail::value_rescaler<no_scaling, mWh_scaling>::try_rescale_value(max/3, result) );
+			CHECK( not detail::value_rescaler<no_scaling, mWh_scaling>::try_rescale_value(-max , result) );
+			std::int16_t small_result = 0;
+			CHECK(     detail::value_rescaler<milli_scaling, no_scaling>::try_rescale_value(std::int16_t{32}, small_result) );
+			CHECK( small_result == 32000 );
+			CHECK( not detail::value_rescaler<milli_scaling, no_scaling>::try_rescale_value(std::int16_t{33}, small_result) );
+		}
+
 		SUBCASE("values can be re-scaled implicitly through constructors") {
 			const value_type v = 42;
 
@@ -528,6 +580,21 @@ TEST_CASE("quantities") {
 			CHECK(q.get() == doctest::Approx(qk3.get()*1000));
 		}
 
+		SUBCASE("testing checked_scale_cast and saturating_scale_cast") {
+			using test_q = test_quantity::revalue<std::int16_t>;
+
+			const test_q q{32};
+			const to_milli<test_q> mq = checked_scale_cast<milli_scaling>(q);
+			CHECK( mq.get() == 32000 );
+			CHECK( saturating_scale_cast<milli_scaling>(q).get() == 32000 );
+			CHECK( checked_scale_cast<kilo_scaling>(mq).get() == 0 );
+
+			CHECK_THROWS_AS( checked_scale_cast<milli_scaling>(test_q{ 33}), std::overflow_error );
+			CHECK_THROWS_AS( checked_scale_cast<milli_scaling>(test_q{-33}), std::overflow_error );
+			CHECK( saturating_scale_cast<milli_scaling>(test_q{ 33}).get() == std::numeric_limits<std::int16_t>::max   () );
+			CHECK( saturating_scale_cast<milli_scaling>(test_q{-33}).get() == std::numeric_limits<std::int16_t>::lowest() );
+		}
+
 		SUBCASE("testing tag_cast") {
 			using test_qa  = test_quantity::retag<tag_t<struct tag_a>>;
 			using test_qb  = test_quantity::retag<tag_t<struct tag_b>>;
@@ -0,0 +1,146 @@
+#include <unlib/quantity_columns.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <unlib/common.hpp>
+#include <unlib/test/unlib_test.hpp>
+
+TEST_CASE("quantity column files") {
+	using namespace unlib;
+
+	using  Wh =      watt_hour<double>;
+	using kWh = kilo<watt_hour<double>>;
+	using  kW = kilo<watt<double>>;
+	using var_int = var<std::int32_t>;
+
+	std::vector<kWh    > energy{kWh{1.5}, kWh{2.5}, kWh{-3.}};
+	std::vector<kW     > power {kW{42.}};
+	std::vector<var_int> reactive{var_int{1}, var_int{2}, var_int{3}, var_int{4}, var_int{5}};
+
+	std::stringstream ss(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+	write_quantity_columns(ss, make_quantity_span(energy), make_quantity_span(power), make_quantity_span(reactive));
+	REQUIRE( ss.good() );
+	const std::string file = ss.str();
+
+	SUBCASE("descriptors describe the columns") {
+		quantity_column_reader reader(ss);
+		REQUIRE( reader.get_column_count() == 3 );
+
+		const quantity_column_descriptor& d0 = reader.get_descriptor(0);
+		CHECK( d0.exponents == make_dynamic_unit<kWh>().get_exponents_word() );
+		CHECK( d0.scale_num == kWh::scale_type::num );
+		CHECK( d0.scale_den == kWh::scale_type::den );
+		CHECK( d0.value_kind == static_cast<std::uint8_t>(column_value_kind::floating_point) );
+		CHECK( d0.value_size == sizeof(double) );
+		CHECK( d0.tag_id == 0 );
+		CHECK( d0.count == 3 );
+		CHECK( std::string(d0.name) == "kWh" );
+
+		const quantity_column_descriptor& d2 = reader.get_descriptor(2);
+		CHECK( d2.value_kind == static_cast<std::uint8_t>(column_value_kind::signed_integer) );
+		CHECK( d2.value_size == sizeof(std::int32_t) );
+		CHECK( d2.tag_id == dynamic_tag_id<reactive_power_tag::id>::value );
+		CHECK( std::string(d2.name) == "VAr" );
+
+		for(std::size_t idx=0; idx<reader.get_column_count(); ++idx)
+			CHECK( reader.get_descriptor(idx).offset % quantity_columns_alignment == 0 );
+		CHECK_THROWS_AS( reader.get_descriptor(3), std::out_of_range );
+	}
+
+	SUBCASE("columns are read back") {
+		quantity_column_reader reader(ss);
+
+		const auto r0 = reader.read_column<kWh>(0);
+		REQUIRE( r0.size() == energy.size() );
+		for(std::size_t idx=0; idx<energy.size(); ++idx)
+			CHECK( r0[idx].get() == energy[idx].get() );
+
+		const auto r2 = reader.read_column<var_int>(2);
+		REQUIRE( r2.size() == reactive.size() );
+		for(std::size_t idx=0; idx<reactive.size(); ++idx)
+			CHECK( r2[idx].get() == reactive[idx].get() );
+
+		std::vector<kW> p(1);
+		reader.read_column(1, make_quantity_span(p));
+		CHECK( p[0].get() == 42. );
+	}
+
+	SUBCASE("floating point columns are rescaled") {
+		quantity_column_reader reader(ss);
+		const auto r0 = reader.read_column<Wh>(0);
+		REQUIRE( r0.size() == energy.size() );
+		CHECK( r0[0].get() == doctest::Approx(1500.) );
+		CHECK( r0[2].get() == doctest::Approx(-3000.) );
+	}
+
+	SUBCASE("columns are checked against the requested quantity") {
+		quantity_column_reader reader(ss);
+		CHECK_THROWS_AS( reader.check_column<kW                         >(0), column_format_error );
+		CHECK_THROWS_AS( reader.check_column<kilo<joule<double>>        >(0), column_format_error );
+		CHECK_THROWS_AS( reader.check_column<kilo<watt_hour<float>>     >(0), column_format_error );
+		CHECK_THROWS_AS( reader.check_column<kilo<var<std::int32_t>>    >(2), column_format_error );
+		CHECK_THROWS_AS( reader.check_column<var<std::int64_t>          >(2), column_format_error );
+		CHECK_THROWS_AS( reader.check_column<voltampere<std::int32_t>   >(2), column_format_error );
+		reader.check_column<var_int>(2);
+
+		std::vector<kWh> too_small(2);
+		CHECK_THROWS_AS( reader.read_column(0, make_quantity_span(too_small)), column_format_error );
+	}
+
+	SUBCASE("malformed files are rejected") {
+		std::string broken = file;
+		broken[0] = 'X';
+		std::istringstream iss1(broken, std::ios_base::binary);
+		CHECK_THROWS_AS( quantity_column_reader{iss1}, column_format_error );
+
+		std::istringstream iss2(file.substr(0, 100), std::ios_base::binary);
+		CHECK_THROWS_AS( quantity_column_reader{iss2}, column_format_error );
+
+		std::istringstream iss3(file.substr(0, file.size()-1), std::ios_base::binary);
+		CHECK_THROWS_AS( quantity_column_reader{iss3}, column_format_error );
+
+		std::string huge = file;
+		const std::uint64_t column_count = std::uint64_t{1} << 60;
+		std::memcpy(&huge[offsetof(quantity_columns_header, column_count)], &column_count, sizeof(column_count));
+		std::istringstream iss4(huge, std::ios_base::binary);
+		CHECK_THROWS_AS( quantity_column_reader{iss4}, column_format_error );
+
+		const auto patch_descriptor = [&file](std::size_t idx, std::size_t offset, std::int64_t value) {
+			std::string patched = file;
+			std::memcpy(&patched[sizeof(quantity_columns_header) + idx*sizeof(quantity_column_descriptor) + offset], &value, sizeof(value));
+			return patched;
+		};
+		for(const std::int64_t count : {std::int64_t{1} << 60, std::int64_t{1} << 30}) {
+			std::istringstream iss(patch_descriptor(0, offsetof(quantity_column_descriptor, count), count), std::ios_base::binary);
+			CHECK_THROWS_AS( quantity_column_reader{iss}, column_format_error );
+		}
+		for(const std::int64_t scale : {std::int64_t{0}, std::int64_t{-1}}) {
+			std::istringstream iss_num(patch_descriptor(0, offsetof(quantity_column_descriptor, scale_num), scale), std::ios_base::binary);
+			CHECK_THROWS_AS( quantity_column_reader{iss_num}, column_format_error );
+			std::istringstream iss_den(patch_descriptor(0, offsetof(quantity_column_descriptor, scale_den), scale), std::ios_base::binary);
+			CHECK_THROWS_AS( quantity_column_reader{iss_den}, column_format_error );
+		}
+
+		// streams which cannot tell their size are read until they end
+		struct unseekable_buffer : std::stringbuf {
+			using std::stringbuf::stringbuf;
+			pos_type seekoff(off_type, std::ios_base::seekdir, std::ios_base::openmode) override {return pos_type(off_type(-1));}
+			pos_type seekpos(pos_type, std::ios_base::openmode)                         override {return pos_type(off_type(-1));}
+		};
+		unseekable_buffer buffer5(huge, std::ios_base::in);
+		std::istream is5(&buffer5);
+		CHECK_THROWS_AS( quantity_column_reader{is5}, column_format_error );
+		unseekable_buffer buffer6(file, std::ios_base::in);
+		std::istream is6(&buffer6);
+		quantity_column_reader unseekable(is6);
+		CHECK( unseekable.get_column_count() == 3 );
+		CHECK_THROWS_AS( unseekable.read_column<kWh>(0), column_format_error );
+	}
+}
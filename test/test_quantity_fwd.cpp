@@ -0,0 +1,49 @@
+#include <unlib/quantity_fwd.hpp>
+#include <unlib/common_units.hpp>
+
+#include <type_traits>
+
+namespace {
+
+/* only declaring quantities must be enough for naming common quantity types */
+unlib::kilo<unlib::watt<double>> get_power(unlib::kilo<unlib::volt<double>>, unlib::ampere<double>);
+
+static_assert(std::is_same<unlib::mul_quantity_t<unlib::kilo<unlib::volt<double>>, unlib::ampere<double>>
+                          , unlib::kilo<unlib::watt<double>> >::value, "mul_quantity_t must not need quantities to be defined");
+static_assert(std::is_same<unlib::div_quantity_t<unlib::kilo<unlib::watt_hour<double>>, unlib::hour<double>>
+                          , unlib::kilo<unlib::watt<double>> >::value, "div_quantity_t must not need quantities to be defined");
+static_assert(std::is_same<unlib::sqrt_quantity_t<unlib::square_meter<double>>
+                          , unlib::meter<double> >::value, "pow_quantity_t must not need quantities to be defined");
+
+}
+
+#include <unlib/quantity.hpp>
+
+#include <doctest/doctest.h>
+
+#include <unlib/test/unlib_test.hpp>
+
+namespace {
+
+unlib::kilo<unlib::watt<double>> get_power(unlib::kilo<unlib::volt<double>> u, unlib::ampere<double> i) {return u * i;}
+
+}
+
+TEST_CASE("forward declared quantities") {
+	using namespace unlib;
+
+	SUBCASE("common quantities are declared without defining quantities") {
+		CHECK( get_power(kilo<volt<double>>{0.23}, ampere<double>{10.}).get() == doctest::Approx(2.3) );
+	}
+
+	SUBCASE("common quantities are the same as those created from quantities' members") {
+		CHECK( typeid(var              <int>) == typeid(typename watt       <int>::template retag<reactive_power_tag>) );
+		CHECK( typeid(voltampere       <int>) == typeid(typename watt       <int>::template retag<apparent_power_tag>) );
+		CHECK( typeid(watt_second      <int>) == typeid(typename joule      <int>::untag) );
+		CHECK( typeid(var_second       <int>) == typeid(typename joule      <int>::template retag<reactive_power_tag>) );
+		CHECK( typeid(voltampere_second<int>) == typeid(typename joule      <int>::template retag<apparent_power_tag>) );
+		CHECK( typeid(ampere_hour      <int>) == typeid(typename ampere_second<int>::template rescale_by<hour_scaling>) );
+		CHECK( typeid(kilo<meter       <int>>) == typeid(typename meter     <int>::template rescale_by<kilo_scaling>) );
+		CHECK( typeid(to_kilo<hour     <int>>) == typeid(typename hour      <int>::template rescale_to<kilo_scaling>) );
+	}
+}
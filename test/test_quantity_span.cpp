@@ -0,0 +1,175 @@
+#include <unlib/quantity_span.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <unlib/common.hpp>
+#include <unlib/quantity_vector.hpp>
+#include <unlib/test/unlib_test.hpp>
+
+TEST_CASE("quantity spans") {
+	using namespace unlib;
+
+	using mWh = milli<watt_hour<double>>;
+	using kWh =  kilo<watt_hour<double>>;
+
+	SUBCASE("spans refer to contiguous quantities") {
+		std::vector<kilo<watt<double>>> v{kilo<watt<double>>{1.}, kilo<watt<double>>{2.}, kilo<watt<double>>{3.}};
+		const auto s = make_quantity_span(v);
+		CHECK( typeid(decltype(s)::quantity_type) == typeid(kilo<watt<double>>) );
+		CHECK( typeid(decltype(s)::   scale_type) == typeid(kilo_scaling)       );
+		REQUIRE( s.size() == 3 );
+		CHECK( s.data() == v.data() );
+		CHECK( s[1].get() == 2. );
+		CHECK( s.values()[2] == 3. );
+
+		s[0] = kilo<watt<double>>{42.};
+		CHECK( v[0].get() == 42. );
+
+		const quantity_span<const kilo<watt<double>>> cs = s;
+		CHECK( cs.front().get() == 42. );
+		CHECK( cs.back ().get() ==  3. );
+		CHECK( cs.subspan(1,1)[0].get() == 2. );
+		CHECK( cs.first(2).size() == 2 );
+		CHECK( cs.last (1)[0].get() == 3. );
+
+		double sum = 0.;
+		for(const auto& q : cs)
+			sum += q.get();
+		CHECK( sum == 47. );
+
+		kWh arr[2] = {kWh{1.}, kWh{2.}};
+		const auto as = make_quantity_span(arr);
+		CHECK( as.size() == 2 );
+		CHECK( not as.empty() );
+		CHECK( quantity_span<kWh>{}.empty() );
+
+		const quantity_vector<energy, kWh::scale_type, double> qv{kWh{5.}};
+		const auto vs = make_quantity_span(qv);
+		CHECK( typeid(decltype(vs)::element_type) == typeid(const kWh) );
+		CHECK( vs[0].get() == 5. );
+
+		CHECK( is_quantity_span<std::remove_const_t<decltype(vs)>>::value );
+		CHECK( not is_quantity_span<kWh>::value );
+	}
+
+	SUBCASE("rescale_span yields the same results as converting each quantity") {
+		std::vector<mWh> in;
+		for(int i=0; i<1000; ++i)
+			in.push_back(mWh{1.234567 * i * i - 7.1 * i});
+		std::vector<kWh> out(in.size());
+
+		rescale_span(make_quantity_span(in), make_quantity_span(out));
+
+		for(std::size_t idx=0; idx<in.size(); ++idx) {
+			const kWh expected = in[idx];
+			CHECK( std::memcmp(&out[idx], &expected, sizeof(kWh)) == 0 );
+		}
+	}
+
+	SUBCASE("rescale_span rescales in place") {
+		quantity_vector<energy, hour_scaling, double> qv{watt_hour<double>{1500.}, watt_hour<double>{-250.}};
+		const quantity_span<watt_hour<double>> s = qv;
+		rescale_span(s, quantity_span<kWh>{reinterpret_cast<kWh*>(qv.data()), qv.size()});
+		CHECK( qv.values()[0] == doctest::Approx( 1.5 ) );
+		CHECK( qv.values()[1] == doctest::Approx(-0.25) );
+	}
+
+	SUBCASE("spans view raw value buffers as quantities") {
+		CHECK( has_value_layout<kWh>::value );
+		CHECK( has_value_layout<quantity<energy, kWh::scale_type, std::int32_t>>::value );
+
+		double buffer[] = {1., 2., 3.};
+		const auto s = make_quantity_span<kWh>(buffer, 3);
+		REQUIRE( s.size() == 3 );
+		CHECK( s.values() == buffer );
+		CHECK( s[2].get() == 3. );
+		s[0] = kWh{42.};
+		CHECK( buffer[0] == 42. );
+
+		const std::int32_t cbuffer[] = {7, 8};
+		const auto cs = make_quantity_span<const watt<std::int32_t>>(cbuffer, 2);
+		CHECK( typeid(decltype(cs)::element_type) == typeid(const watt<std::int32_t>) );
+		CHECK( cs[1].get() == 8 );
+	}
+
+	SUBCASE("strided spans view every n-th quantity") {
+		// alternating voltages and currents
+		float buffer[] = {230.f, 1.f, 231.f, 2.f, 229.f, 3.f, 232.f, 4.f};
+		const auto currents = make_strided_quantity_span<ampere<float>>(buffer+1, 4, 2);
+		REQUIRE( currents.size() == 4 );
+		CHECK( currents.stride() == 2 );
+		CHECK( currents.front().get() == 1.f );
+		CHECK( currents.back ().get() == 4.f );
+		CHECK( currents[2].get() == 3.f );
+		currents[3] = ampere<float>{5.f};
+		CHECK( buffer[7] == 5.f );
+
+		float sum = 0.f;
+		for(const auto& c : currents)
+			sum += c.get();
+		CHECK( sum == 11.f );
+		CHECK( currents.end() - currents.begin() == 4 );
+		CHECK( currents.begin()[1].get() == 2.f );
+
+		const strided_quantity_span<const ampere<float>> sub = currents.subspan(1, 2);
+		CHECK( sub.size() == 2 );
+		CHECK( sub[1].get() == 3.f );
+		CHECK( currents.last(1)[0].get() == 5.f );
+		CHECK( currents.last(0).empty() );
+		CHECK( currents.subspan(4, 0).empty() );
+		CHECK( (currents.end() - 1)->get() == 5.f );
+		CHECK( std::prev(currents.end(), 4) == currents.begin() );
+		CHECK( currents.begin() < currents.end() );
+
+		std::vector<kWh> v{kWh{1.}, kWh{2.}};
+		const strided_quantity_span<const kWh> contiguous = make_quantity_span(v);
+		CHECK( contiguous.stride() == 1 );
+		CHECK( contiguous[1].get() == 2. );
+	}
+
+	SUBCASE("casts on spans are lazy views") {
+		double buffer[] = {1500., 250., -1000.};
+		const auto wh = make_quantity_span<const watt_hour<double>>(buffer, 3);
+
+		const auto kwh = scale_cast<kWh::scale_type>(wh);
+		CHECK( typeid(decltype(kwh)::quantity_type) == typeid(kWh) );
+		REQUIRE( kwh.size() == 3 );
+		CHECK( kwh[0].get() == doctest::Approx( 1.5 ) );
+		CHECK( kwh.back().get() == doctest::Approx(-1. ) );
+
+		buffer[1] = 500.;
+		CHECK( kwh[1].get() == doctest::Approx(.5) );
+
+		const auto f = value_cast<float>(kwh);
+		CHECK( typeid(decltype(f)::quantity_type) == typeid(kilo<watt_hour<float>>) );
+		float sum = 0.f;
+		for(const auto e : f)
+			sum += e.get();
+		CHECK( sum == doctest::Approx(1.f) );
+
+		// iterators stay valid after the (temporary) views they came from
+		auto it = value_cast<float>(scale_cast<kWh::scale_type>(wh)).begin();
+		const auto end = value_cast<float>(kwh).end();
+		CHECK( (*it).get() == doctest::Approx(1.5f) );
+		++it;
+		CHECK( (*it++).get() == doctest::Approx(.5f) );
+		CHECK( (*it).get() == doctest::Approx(-1.f) );
+		CHECK( ++it == end );
+
+		const auto tagged = tag_cast<joule_tag>(wh);
+		CHECK( typeid(decltype(tagged)::tag_type) == typeid(joule_tag) );
+		CHECK( tagged.front().get() == 1500. );
+
+		float interleaved[] = {1.f, 10.f, 2.f, 20.f};
+		const auto strided = value_cast<double>(make_strided_quantity_span<const ampere<float>>(interleaved, 2, 2));
+		CHECK( strided[1].get() == 2. );
+		CHECK( is_quantity_view<std::remove_const_t<decltype(strided)>>::value );
+		CHECK( not is_quantity_view<kWh>::value );
+	}
+}
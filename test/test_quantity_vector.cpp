@@ -0,0 +1,137 @@
+#include <unlib/quantity_vector.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <unlib/common.hpp>
+#include <unlib/test/unlib_test.hpp>
+
+TEST_CASE("quantity vectors") {
+	using namespace unlib;
+
+	using kW_vector = quantity_vector<power, kilo_scaling, double>;
+	using  W_vector = quantity_vector<power,   no_scaling, double>;
+	using  h_vector = quantity_vector<unlib::time, hour_scaling, double>;
+
+	SUBCASE("template parameters properly propagate to quantity vector") {
+		CHECK( typeid(kW_vector::quantity_type) == typeid(kilo<watt<double>>) );
+		CHECK( typeid(kW_vector::    unit_type) == typeid(power)              );
+		CHECK( typeid(kW_vector::   scale_type) == typeid(kilo_scaling)       );
+		CHECK( typeid(kW_vector::   value_type) == typeid(double)             );
+		CHECK( typeid(kW_vector::     tag_type) == typeid(no_tag)             );
+
+		CHECK( typeid(kW_vector::retag<reactive_power_tag>::quantity_type) == typeid(kilo<var<double>>)   );
+		CHECK( typeid(kW_vector::revalue<float>           ::quantity_type) == typeid(kilo<watt<float>>)  );
+		CHECK( typeid(kW_vector::rescale_to<mega_scaling> ::quantity_type) == typeid(mega<watt<double>>) );
+
+		CHECK( is_quantity_vector<kW_vector>::value );
+		CHECK( not is_quantity_vector<kilo<watt<double>>>::value );
+	}
+
+	SUBCASE("quantities are stored contiguously and aligned") {
+		kW_vector qv(1000, kilo<watt<double>>{42.});
+		REQUIRE( qv.size() == 1000 );
+		CHECK( reinterpret_cast<std::uintptr_t>(qv.data()) % kW_vector::alignment == 0 );
+		CHECK( static_cast<const void*>(qv.values()) == static_cast<const void*>(qv.data()) );
+		CHECK( qv.values()[999] == 42. );
+
+		qv.values()[17] = 23.;
+		CHECK( qv[17] == kilo<watt<double>>{23.} );
+
+		qv.push_back(kilo<watt<double>>{47.});
+		CHECK( reinterpret_cast<std::uintptr_t>(qv.data()) % kW_vector::alignment == 0 );
+		CHECK( qv.back().get() == 47. );
+	}
+
+	SUBCASE("quantity vectors can be created and accessed") {
+		const kW_vector qv{kilo<watt<double>>{1.}, kilo<watt<double>>{2.}, kilo<watt<double>>{3.}};
+		REQUIRE( qv.size() == 3 );
+		CHECK( qv.front().get() == 1. );
+		CHECK( qv[1].get()      == 2. );
+		CHECK( qv.at(2).get()   == 3. );
+		CHECK_THROWS_AS( qv.at(3), std::out_of_range );
+
+		const std::vector<kilo<watt<double>>> v{qv.begin(), qv.end()};
+		const kW_vector qv2{v.begin(), v.end()};
+		CHECK( qv2.size() == qv.size() );
+		CHECK( qv2[2] == qv[2] );
+
+		const kW_vector qv3(5);
+		CHECK( qv3.size() == 5 );
+		CHECK( qv3[4].get() == 0. );
+	}
+
+	SUBCASE("quantity vectors can be re-scaled implicitly through constructors") {
+		const kW_vector kw{kilo<watt<double>>{1.}, kilo<watt<double>>{2.5}};
+		const W_vector  w = kw;
+		REQUIRE( w.size() == 2 );
+		CHECK( w[0].get() == doctest::Approx(1000.) );
+		CHECK( w[1].get() == doctest::Approx(2500.) );
+	}
+
+	SUBCASE("quantity vectors can be added and subtracted") {
+		kW_vector a{kilo<watt<double>>{1.}, kilo<watt<double>>{2.}};
+		const W_vector b{watt<double>{500.}, watt<double>{250.}};
+
+		const auto sum = a + b;
+		CHECK( typeid(sum) == typeid(kW_vector) );
+		CHECK( sum[0].get() == doctest::Approx(1.5 ) );
+		CHECK( sum[1].get() == doctest::Approx(2.25) );
+
+		const auto diff = b - a;
+		CHECK( typeid(diff) == typeid(W_vector) );
+		CHECK( diff[0].get() == doctest::Approx( -500.) );
+		CHECK( diff[1].get() == doctest::Approx(-1750.) );
+
+		a += b;
+		CHECK( a[0].get() == doctest::Approx(1.5) );
+		a -= b;
+		CHECK( a[0].get() == doctest::Approx(1. ) );
+
+		a += watt<double>{1000.};
+		CHECK( a[1].get() == doctest::Approx(3. ) );
+		a -= kilo<watt<double>>{1.};
+		CHECK( a[1].get() == doctest::Approx(2. ) );
+
+		const auto shifted = a + kilo<watt<double>>{10.};
+		CHECK( shifted[0].get() == doctest::Approx(11.) );
+	}
+
+	SUBCASE("quantity vectors can be multiplied and divided") {
+		const kW_vector p{kilo<watt<double>>{2.}, kilo<watt<double>>{4.}};
+		const h_vector  t{     hour<double>{3.},       hour<double>{0.5}};
+
+		const auto e = p * t;
+		CHECK( typeid(decltype(e)::quantity_type) == typeid(kilo<watt_hour<double>>) );
+		CHECK( e[0].get() == doctest::Approx(6.) );
+		CHECK( e[1].get() == doctest::Approx(2.) );
+
+		const auto p2 = e / t;
+		CHECK( typeid(p2) == typeid(kW_vector) );
+		CHECK( p2[0].get() == doctest::Approx(2.) );
+
+		const auto e2 = p * hour<double>{2.};
+		CHECK( typeid(decltype(e2)::quantity_type) == typeid(kilo<watt_hour<double>>) );
+		CHECK( e2[1].get() == doctest::Approx(8.) );
+
+		const auto doubled = 2. * p;
+		CHECK( typeid(doubled) == typeid(kW_vector) );
+		CHECK( doubled[1].get() == doctest::Approx(8.) );
+
+		const auto halved = p / 2.;
+		CHECK( halved[1].get() == doctest::Approx(2.) );
+
+		const auto f = 1. / t;
+		CHECK( typeid(decltype(f)::unit_type) == typeid(frequency) );
+		CHECK( f[1].get() == doctest::Approx(2.) );
+
+		kW_vector q = p;
+		q *= 3.;
+		CHECK( q[0].get() == doctest::Approx(6.) );
+		q /= 6.;
+		CHECK( q[0].get() == doctest::Approx(1.) );
+	}
+}
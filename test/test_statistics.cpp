@@ -0,0 +1,103 @@
+#include <unlib/statistics.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include <unlib/common.hpp>
+#include <unlib/test/unlib_test.hpp>
+
+TEST_CASE("running statistics") {
+	using namespace unlib;
+
+	using V = volt<double>;
+
+	std::vector<V> voltages;
+	for(int i=0; i<1003; ++i)
+		voltages.push_back(V{230. + 5. * std::sin(i * 0.3) + (i%11) * 0.01});
+	const auto all = make_quantity_span(voltages);
+
+	double expected_mean = 0.;
+	for(const auto& v : voltages)
+		expected_mean += v.get();
+	expected_mean /= static_cast<double>(voltages.size());
+	double expected_m2 = 0.;
+	for(const auto& v : voltages)
+		expected_m2 += (v.get() - expected_mean) * (v.get() - expected_mean);
+
+	SUBCASE("statistics are typed by the quantities' unit") {
+		running_stats<V> stats;
+		CHECK( stats.empty() );
+		stats.push(V{1.});
+		CHECK( typeid(stats.mean    ()) == typeid(V) );
+		CHECK( typeid(stats.min     ()) == typeid(V) );
+		CHECK( typeid(stats.max     ()) == typeid(V) );
+		CHECK( typeid(stats.variance()) == typeid(pow_quantity_t<V,std::ratio<2>>) );
+		CHECK( typeid(stats.variance()) == typeid(decltype(V{} * V{})) );
+		CHECK( typeid(stats.standard_deviation()) == typeid(V) );
+	}
+
+	SUBCASE("pushing single quantities") {
+		running_stats<V> stats;
+		for(const auto& v : voltages)
+			stats.push(v);
+		CHECK( stats.count() == voltages.size() );
+		CHECK( stats.mean().get() == doctest::Approx(expected_mean) );
+		CHECK( stats.variance().get() == doctest::Approx(expected_m2 / 1003.) );
+		CHECK( stats.sample_variance().get() == doctest::Approx(expected_m2 / 1002.) );
+		CHECK( stats.standard_deviation().get() == doctest::Approx(std::sqrt(expected_m2 / 1003.)) );
+		CHECK( stats.min().get() == min(all).get() );
+		CHECK( stats.max().get() == max(all).get() );
+	}
+
+	SUBCASE("pushing sequences of quantities") {
+		running_stats<V> stats;
+		stats.push(all.first(10));
+		stats.push(all.subspan(10, 0));
+		stats.push(all.subspan(10, 900));
+		stats.push(all.last(93));
+		CHECK( stats.count() == voltages.size() );
+		CHECK( stats.mean().get() == doctest::Approx(expected_mean) );
+		CHECK( stats.variance().get() == doctest::Approx(expected_m2 / 1003.) );
+		CHECK( stats.min().get() == min(all).get() );
+		CHECK( stats.max().get() == max(all).get() );
+
+		const V constant[] = {V{3.}, V{3.}, V{3.}};
+		running_stats<V> constant_stats;
+		constant_stats.push(make_quantity_span(constant));
+		CHECK( constant_stats.mean().get() == 3. );
+		CHECK( constant_stats.variance().get() == 0. );
+	}
+
+	SUBCASE("merged statistics equal those of all quantities") {
+		running_stats<V> part1, part2, part3, empty;
+		part1.push(all.first(300));
+		for(std::size_t idx=300; idx<700; ++idx)
+			part2.push(all[idx]);
+		part3.push(all.last(303));
+		part1.merge(empty).merge(part2).merge(part3);
+		empty.merge(part1);
+
+		for(const auto& stats : {part1, empty}) {
+			CHECK( stats.count() == voltages.size() );
+			CHECK( stats.mean().get() == doctest::Approx(expected_mean) );
+			CHECK( stats.variance().get() == doctest::Approx(expected_m2 / 1003.) );
+			CHECK( stats.min().get() == min(all).get() );
+			CHECK( stats.max().get() == max(all).get() );
+		}
+	}
+
+	SUBCASE("large offsets do not spoil the variance") {
+		running_stats<hertz<double>> single, batch;
+		std::vector<hertz<double>> frequencies;
+		for(int i=0; i<1000; ++i)
+			frequencies.push_back(hertz<double>{1e9 + (i%2 ? 1. : -1.)});
+		for(const auto& f : frequencies)
+			single.push(f);
+		batch.push(make_quantity_span(frequencies));
+		CHECK( single.variance().get() == doctest::Approx(1.) );
+		CHECK( batch .variance().get() == doctest::Approx(1.) );
+	}
+}
@@ -10,9 +10,14 @@ namespace {
 using e0 = unlib::exponent_t<0>;
 
 template<typename Unit>
-struct unsorted_unit_list_from_unit;
-template<typename E1, typename E2, typename E3, typename E4, typename E5, typename E6, typename E7>
-struct unsorted_unit_list_from_unit<unlib::unit<E1,E2,E3,E4,E5,E6,E7>> {
+struct unsorted_unit_list_from_unit {
+	using E1 = unlib::            time_exponent_t<Unit>;
+	using E2 = unlib::            mass_exponent_t<Unit>;
+	using E3 = unlib::          length_exponent_t<Unit>;
+	using E4 = unlib::         current_exponent_t<Unit>;
+	using E5 = unlib::      luminosity_exponent_t<Unit>;
+	using E6 = unlib::     temperature_exponent_t<Unit>;
+	using E7 = unlib::substance_amount_exponent_t<Unit>;
 	using type = unlib::detail::unsorted_unit_list< unlib::unit< E1, e0, e0, e0, e0, e0, e0 >
 	                                              , unlib::unit< e0, E2, e0, e0, e0, e0, e0 >
 	                                              , unlib::unit< e0, e0, E3, e0, e0, e0, e0 >
@@ -292,4 +297,31 @@ TEST_CASE("units") {
 		}
 	}
 
+	SUBCASE("packed exponents") {
+		using namespace unlib;
+		using unit_a = unit< exponent_t<-1>
+		                   , exponent_t< 1,2>
+		                   , exponent_t<-1,3>
+		                   , exponent_t< 1,6>
+		                   , exponent_t<42>
+		                   , exponent_t<-42>
+		                   , exponent_t<0> >;
+
+		CHECK( dimensionless::exponents == 0 );
+		CHECK( unit_a::exponents != 0 );
+
+		CHECK( typeid(exponent_t<-1  >) == typeid(            time_exponent_t<unit_a>) );
+		CHECK( typeid(exponent_t< 1,2>) == typeid(            mass_exponent_t<unit_a>) );
+		CHECK( typeid(exponent_t<-1,3>) == typeid(          length_exponent_t<unit_a>) );
+		CHECK( typeid(exponent_t< 1,6>) == typeid(         current_exponent_t<unit_a>) );
+		CHECK( typeid(exponent_t< 42 >) == typeid(      luminosity_exponent_t<unit_a>) );
+		CHECK( typeid(exponent_t<-42 >) == typeid(     temperature_exponent_t<unit_a>) );
+		CHECK( typeid(exponent_t<  0 >) == typeid(substance_amount_exponent_t<unit_a>) );
+
+		CHECK( typeid(mul_unit_t<unit_a,reciprocal_unit_t<unit_a>>) == typeid(dimensionless) );
+		CHECK( typeid(div_unit_t<unit_a,unit_a>) == typeid(dimensionless) );
+		CHECK( typeid(sqrt_unit_t<cbrt_unit_t<unlib::time>>) == typeid(unit_t<pow_unit_t<unlib::time,std::ratio<1,6>>>) );
+		CHECK( typeid(pow_unit_t<sqrt_unit_t<unlib::mass>,std::ratio<6>>) == typeid(cube_unit_t<unlib::mass>) );
+	}
+
 }
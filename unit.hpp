@@ -28,10 +28,112 @@ template< std::intmax_t Num
         , std::intmax_t Den = 1 >
 using exponent_t = ratio_t<Num,Den>;
 
+namespace detail {
+
+/*
+ * The exponents of the seven basic units are stored as multiples of
+ * 1/unit_exponent_denominator in signed 9 bit lanes of a single integer.
+ * This allows exponents from -42 to +42 with denominators of 1, 2, 3, and 6,
+ * and lets unit manipulations be done using integer arithmetic.
+ */
+constexpr int           unit_basics_count         = 7;
+constexpr int           unit_exponent_denominator = 6;
+constexpr int           unit_exponent_bits        = 9;
+constexpr std::intmax_t unit_exponent_limit       = std::intmax_t{1} << (unit_exponent_bits-1);
+constexpr std::uint64_t unit_exponent_mask        = (std::uint64_t{1} << unit_exponent_bits) - 1;
+
+/*
+ * These are deliberately not constexpr: calling them while packing exponents
+ * at compile-time results in a compiler error mentioning their names.
+ */
+inline std::uint64_t unit_exponent_out_of_range()                       {return 0;}
+inline std::intmax_t unit_exponent_denominator_must_divide_6()          {return 0;}
+
+constexpr std::intmax_t get_unit_exponent(std::uint64_t exponents, int idx) {
+	return static_cast<std::intmax_t>(exponents >> (idx*unit_exponent_bits) & unit_exponent_mask)
+	     - (exponents >> (idx*unit_exponent_bits) & unit_exponent_limit ? 2*unit_exponent_limit : 0);
+}
+
+constexpr std::uint64_t unit_exponent_lane(std::intmax_t exponent, int idx) {
+	return exponent < -unit_exponent_limit or exponent >= unit_exponent_limit
+	     ? unit_exponent_out_of_range()
+	     : (static_cast<std::uint64_t>(exponent) & unit_exponent_mask) << (idx*unit_exponent_bits);
+}
+
+constexpr std::intmax_t divide_unit_exponent(std::intmax_t num, std::intmax_t den) {
+	return num % den != 0
+	     ? unit_exponent_denominator_must_divide_6()
+	     : num / den;
+}
+
+template<typename... Exponents>
+constexpr std::uint64_t pack_unit_exponents() {
+	static_assert(sizeof...(Exponents) == unit_basics_count, "a unit needs exactly seven exponents");
+	const std::intmax_t nums[] = {Exponents::num...};
+	const std::intmax_t dens[] = {Exponents::den...};
+	std::uint64_t exponents = 0;
+	for(int idx=0; idx<unit_basics_count; ++idx)
+		exponents |= unit_exponent_lane(divide_unit_exponent(nums[idx]*unit_exponent_denominator, dens[idx]), idx);
+	return exponents;
+}
+
+constexpr std::uint64_t add_unit_exponents(std::uint64_t lhs, std::uint64_t rhs) {
+	std::uint64_t exponents = 0;
+	for(int idx=0; idx<unit_basics_count; ++idx)
+		exponents |= unit_exponent_lane(get_unit_exponent(lhs,idx) + get_unit_exponent(rhs,idx), idx);
+	return exponents;
+}
+
+constexpr std::uint64_t subtract_unit_exponents(std::uint64_t lhs, std::uint64_t rhs) {
+	std::uint64_t exponents = 0;
+	for(int idx=0; idx<unit_basics_count; ++idx)
+		exponents |= unit_exponent_lane(get_unit_exponent(lhs,idx) - get_unit_exponent(rhs,idx), idx);
+	return exponents;
+}
+
+constexpr std::uint64_t multiply_unit_exponents(std::uint64_t exponents, std::intmax_t num, std::intmax_t den) {
+	std::uint64_t result = 0;
+	for(int idx=0; idx<unit_basics_count; ++idx)
+		result |= unit_exponent_lane(divide_unit_exponent(get_unit_exponent(exponents,idx)*num, den), idx);
+	return result;
+}
+
+}
+
+/**
+ * @brief A physical unit
+ *
+ * A unit is a set of exponents representing the seven basic physical units
+ * of the SI unit system. They are packed into a single integer, so that unit
+ * types (and thus quantity types) have short names and unit manipulations
+ * boil down to integer arithmetic. The exponents are available as ratios
+ * through the nested types and the accessors (e.g., @sa time_exponent_t).
+ *
+ * @tparam Exponents  the packed exponents
+ *
+ * @note Use unit or unit_t to define units rather than using this template
+ *       directly.
+ */
+template<std::uint64_t Exponents>
+struct packed_unit {
+	static constexpr std::uint64_t exponents = Exponents;                   /**< the packed exponents */
+
+	using             time_exponent = exponent_t<detail::get_unit_exponent(Exponents,0), detail::unit_exponent_denominator>;
+	using             mass_exponent = exponent_t<detail::get_unit_exponent(Exponents,1), detail::unit_exponent_denominator>;
+	using           length_exponent = exponent_t<detail::get_unit_exponent(Exponents,2), detail::unit_exponent_denominator>;
+	using          current_exponent = exponent_t<detail::get_unit_exponent(Exponents,3), detail::unit_exponent_denominator>;
+	using       luminosity_exponent = exponent_t<detail::get_unit_exponent(Exponents,4), detail::unit_exponent_denominator>;
+	using      temperature_exponent = exponent_t<detail::get_unit_exponent(Exponents,5), detail::unit_exponent_denominator>;
+	using substance_amount_exponent = exponent_t<detail::get_unit_exponent(Exponents,6), detail::unit_exponent_denominator>;
+};
+
+template<std::uint64_t Exponents>
+constexpr std::uint64_t packed_unit<Exponents>::exponents;
+
 /**
  * @brief A physical unit
  *
- * A unit is a set of exponents (std::ratio<>) representing the seven basic
+ * This creates a unit from the exponents (std::ratio<>) of the seven basic
  * physical units of the SI unit system. If a basic unit is not present in a
  * unit, the exponent's numerator is zero.
  *
@@ -43,10 +145,12 @@ using exponent_t = ratio_t<Num,Den>;
  * @tparam     TemperatureExp  Exponent representing the     Temperature basic unit
  * @tparam SubstanceAmountExp  Exponent representing the SubstanceAmount basic unit
  *
+ * @note Exponents must be in the range of -42 to +42, and their denominators
+ *       must divide 6.
+ *
  * @note Use unit_t to define units rather than using this template drectly.
- *       The unit_t meta function creates instances of this template with all
- *       the basic units always in the same order, no matter in which order
- *       they are specified and how many are provided.
+ *       The unit_t meta function creates units from basic units, no matter
+ *       in which order they are specified and how many are provided.
  */
 template< typename            TimeExp
         , typename            MassExp
@@ -55,30 +159,8 @@ template< typename            TimeExp
         , typename      LuminosityExp
         , typename     TemperatureExp
         , typename SubstanceAmountExp >
-struct unit;
-
-template< std::intmax_t            TimeNum, std::intmax_t            TimeDen
-        , std::intmax_t            MassNum, std::intmax_t            MassDen
-        , std::intmax_t          LengthNum, std::intmax_t          LengthDen
-        , std::intmax_t         CurrentNum, std::intmax_t         CurrentDen
-        , std::intmax_t      LuminosityNum, std::intmax_t      LuminosityDen
-        , std::intmax_t     TemperatureNum, std::intmax_t     TemperatureDen
-        , std::intmax_t SubstanceAmountNum, std::intmax_t SubstanceAmountDen >
-struct unit< std::ratio<           TimeNum,           TimeDen>
-           , std::ratio<           MassNum,           MassDen>
-           , std::ratio<         LengthNum,         LengthDen>
-           , std::ratio<        CurrentNum,        CurrentDen>
-           , std::ratio<     LuminosityNum,     LuminosityDen>
-           , std::ratio<    TemperatureNum,    TemperatureDen>
-           , std::ratio<SubstanceAmountNum,SubstanceAmountDen> > {
-	using             time_exponent = exponent_t<            TimeNum,            TimeDen>;
-	using             mass_exponent = exponent_t<            MassNum,            MassDen>;
-	using           length_exponent = exponent_t<          LengthNum,          LengthDen>;
-	using          current_exponent = exponent_t<         CurrentNum,         CurrentDen>;
-	using       luminosity_exponent = exponent_t<      LuminosityNum,      LuminosityDen>;
-	using      temperature_exponent = exponent_t<     TemperatureNum,     TemperatureDen>;
-	using substance_amount_exponent = exponent_t< SubstanceAmountNum, SubstanceAmountDen>;
-};
+using unit = packed_unit<detail::pack_unit_exponents< TimeExp, MassExp, LengthExp, CurrentExp
+                                                    , LuminosityExp, TemperatureExp, SubstanceAmountExp >()>;
 
 /**
  * @{
@@ -183,64 +265,6 @@ using create_unit_t = unit< typename find_first_exponent<            time, Unsor
                           , typename find_first_exponent<     temperature, UnsortedUnitList>::type
                           , typename find_first_exponent<substance_amount, UnsortedUnitList>::type >;
 
-/**
- * @{
- *
- * meta functions for unit type manipulations
- */
-template<template<typename> class Operation, typename Unit>
-struct apply_unary;
-template< template<typename> class Operation
-        , typename Tim, typename Mas, typename Len, typename Cur, typename Lum, typename Tem, typename Sub >
-struct apply_unary<Operation, unit<Tim,Mas,Len,Cur,Lum,Tem,Sub>> {
-	using type = unit< Operation<Tim>
-	                 , Operation<Mas>
-	                 , Operation<Len>
-	                 , Operation<Cur>
-	                 , Operation<Lum>
-	                 , Operation<Tem>
-	                 , Operation<Sub> >;
-};
-template<template<typename> class Operation, typename Unit>
-using apply_unary_t = typename apply_unary<Operation, Unit>::type;
-
-template<template<typename,typename> class Operation, typename Unit, typename Operand>
-struct apply_binary;
-template< template< typename,typename> class Operation
-        , typename Tim, typename Mas, typename Len, typename Cur, typename Lum, typename Tem, typename Sub
-        , std::intmax_t Nom, std::intmax_t Den>
-struct apply_binary<Operation, unit<Tim,Mas,Len,Cur,Lum,Tem,Sub>, std::ratio<Nom,Den>> {
-	using type = unit< Operation<Tim, std::ratio<Nom,Den>>
-	                 , Operation<Mas, std::ratio<Nom,Den>>
-	                 , Operation<Len, std::ratio<Nom,Den>>
-	                 , Operation<Cur, std::ratio<Nom,Den>>
-	                 , Operation<Lum, std::ratio<Nom,Den>>
-	                 , Operation<Tem, std::ratio<Nom,Den>>
-	                 , Operation<Sub, std::ratio<Nom,Den>> >;
-};
-template<template<typename,typename> class Operation
-        , typename Tim1, typename Mas1, typename Len1, typename Cur1, typename Lum1, typename Tem1, typename Sub1
-        , typename Tim2, typename Mas2, typename Len2, typename Cur2, typename Lum2, typename Tem2, typename Sub2 >
-struct apply_binary<Operation, unit<Tim1,Mas1,Len1,Cur1,Lum1,Tem1,Sub1>, unit<Tim2,Mas2,Len2,Cur2,Lum2,Tem2,Sub2>>  {
-	using type = unit< Operation<Tim1, Tim2>
-	                 , Operation<Mas1, Mas2>
-	                 , Operation<Len1, Len2>
-	                 , Operation<Cur1, Cur2>
-	                 , Operation<Lum1, Lum2>
-	                 , Operation<Tem1, Tem2>
-	                 , Operation<Sub1, Sub2> >;
-};
-template<template<typename,typename> class Operation, typename Unit, typename Operand>
-using apply_binary_t = typename apply_binary<Operation, Unit, Operand>::type;
-
-template<typename Unit, typename Ratio>
-struct pow_unit;
-template<typename Unit, std::intmax_t Nom, std::intmax_t Den>
-struct pow_unit<Unit, std::ratio<Nom,Den>> {
-	using type = apply_binary_t<std::ratio_multiply, Unit, std::ratio<Nom,Den>>;
-};
-/** @} */
-
 }
 
 /** a dimension-less unit */
@@ -275,12 +299,12 @@ using unit_t = detail::create_unit_t<detail::unsorted_unit_list<Basic1,Basic2,Ba
  *
  * @brief common unit type manipulations
  */
-template<typename Unit1, typename Unit2> using        mul_unit_t = detail::apply_binary_t<std::ratio_add     ,Unit1,Unit2>;
-template<typename Unit1, typename Unit2> using        div_unit_t = detail::apply_binary_t<std::ratio_subtract,Unit1,Unit2>;
-template<typename Unit , typename Ratio> using        pow_unit_t = detail::apply_binary_t<std::ratio_multiply,Unit ,Ratio>;
+template<typename Unit1, typename Unit2> using        mul_unit_t = packed_unit<detail::     add_unit_exponents(Unit1::exponents, Unit2::exponents)>;
+template<typename Unit1, typename Unit2> using        div_unit_t = packed_unit<detail::subtract_unit_exponents(Unit1::exponents, Unit2::exponents)>;
+template<typename Unit , typename Ratio> using        pow_unit_t = packed_unit<detail::multiply_unit_exponents(Unit ::exponents, Ratio::num, Ratio::den)>;
 template<typename Unit>                  using     square_unit_t = pow_unit_t<Unit,std::ratio<2,1>>;
 template<typename Unit>                  using       cube_unit_t = pow_unit_t<Unit,std::ratio<3,1>>;
-template<typename Unit>                  using reciprocal_unit_t = detail::apply_unary_t<ratio_negate_t,Unit>;
+template<typename Unit>                  using reciprocal_unit_t = packed_unit<detail::subtract_unit_exponents(0, Unit::exponents)>;
 template<typename Unit>                  using       sqrt_unit_t = pow_unit_t<Unit, std::ratio<1,2>>;
 template<typename Unit>                  using       cbrt_unit_t = pow_unit_t<Unit, std::ratio<1,3>>;
 /** @} */